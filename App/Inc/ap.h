@@ -24,10 +24,12 @@ typedef enum {
   MODE_ENVIRONMENT,
   MODE_CLOCK,
   MODE_PW_CHANGE,
-  MODE_LOG              // ⭐ 7. 로그 기록
+  MODE_LOG,             // ⭐ 7. 로그 기록
+  MODE_DIAG             // ⭐ 8. 실행 시간 진단
 } SystemMode_t;
 
 void apInit(void);
 void apMain(void);
+void Modbus_TickISR(void); // TIM2 1ms 틱에서 호출
 
 #endif // AP_H_
\ No newline at end of file
@@ -0,0 +1,19 @@
+#ifndef COBS_H_
+#define COBS_H_
+
+#include <stdint.h>
+
+// COBS (Consistent Overhead Byte Stuffing)
+// 인코딩 결과에 0x00 이 없으므로 0x00 을 프레임 구분자로 사용
+// 오버헤드: 254바이트마다 1바이트 + 1
+
+#define COBS_MAX_ENCODED(n) ((n) + (n) / 254u + 1u)
+
+// dst 는 COBS_MAX_ENCODED(len) 이상. 인코딩된 길이 반환
+uint16_t COBS_Encode(const uint8_t *src, uint16_t len, uint8_t *dst);
+
+// 구분자(0x00)를 뺀 프레임을 복원. dst == src 가능 (제자리)
+// 잘못된 프레임이면 0
+uint16_t COBS_Decode(const uint8_t *src, uint16_t len, uint8_t *dst);
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef CONSOLE_H_
+#define CONSOLE_H_
+
+#include <stdint.h>
+
+// 줄 단위 명령 콘솔 (UART 수신 바이트 → 명령 실행, 응답은 printf)
+// - CR 또는 LF 로 줄 끝, Backspace/DEL 로 지우기
+// - 공백으로 나눈 첫 단어로 명령 표를 찾아 실행
+// - 대기 없음: 들어온 바이트만 처리하고 바로 반환
+
+#define CONSOLE_LINE_MAX 48
+#define CONSOLE_MAX_ARGS 4
+
+typedef void (*Console_Handler_t)(uint8_t argc, char **argv);
+
+typedef struct {
+  const char *name;
+  const char *usage; // help 출력용
+  Console_Handler_t fn;
+} Console_Cmd_t;
+
+typedef struct {
+  const Console_Cmd_t *cmds;
+  uint8_t n_cmds;
+  char line[CONSOLE_LINE_MAX];
+  uint8_t len;
+  uint8_t overflow; // 줄이 너무 길면 줄 끝까지 버림
+  uint32_t lines;   // 실행한 명령
+  uint32_t errors;  // 모르는 명령 / 너무 긴 줄
+} Console_t;
+
+void Console_Init(Console_t *c, const Console_Cmd_t *cmds, uint8_t n_cmds);
+void Console_Feed(Console_t *c, const uint8_t *data, uint16_t len);
+void Console_PrintHelp(const Console_t *c);
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef CRC16_H_
+#define CRC16_H_
+
+#include <stdint.h>
+
+// CRC-16/CCITT-FALSE (다항식 0x1021, 초기값 0xFFFF)
+#define CRC16_INIT 0xFFFFu
+
+uint16_t CRC16_Update(uint16_t crc, const void *data, uint32_t len);
+
+// CRC-16/MODBUS (반사 다항식 0xA001, 초기값 0xFFFF, 결과는 하위 바이트 먼저 전송)
+#define CRC16_MODBUS_INIT 0xFFFFu
+
+uint16_t CRC16_ModbusUpdate(uint16_t crc, const void *data, uint32_t len);
+
+#endif
@@ -7,16 +7,36 @@
 // DHT11 핀 정의 (PA1 → PB1로 변경)
 #define DHT11_PORT GPIOB  // ⭐ GPIOA → GPIOB
 #define DHT11_PIN GPIO_PIN_1
+// ⭐ PB1 = TIM3_CH4 (AF2) → 입력 캡처로 펄스 폭 측정
+
+#define DHT11_START_LOW_MS 20   // 시작 신호 LOW 유지 (최소 18ms)
+#define DHT11_TIMEOUT_MS 10     // 응답 + 40비트 (~4.5ms) 수신 제한 시간
+#define DHT11_POWERUP_MS 1000   // 전원 인가 후 센서 안정화
+#define DHT11_STALE_MS 10000    // 마지막 정상값 유효 시간
 
 // DHT11 데이터 구조체
 typedef struct {
-    uint8_t humidity;       // 습도 (%)
-    uint8_t temperature;    // 온도 (°C)
-    uint8_t checksum_ok;    // 체크섬 검증 결과
+    uint8_t humidity;        // 습도 정수부 (%)
+    uint8_t humidity_dec;    // 습도 소수부 (dht_data[1])
+    uint8_t temperature;     // 온도 정수부 (°C)
+    uint8_t temperature_dec; // 온도 소수부 0.1°C (dht_data[3] 하위 7비트)
+    uint8_t checksum_ok;     // 체크섬 검증 결과
 } DHT11_Data_t;
 
+// 측정 상태
+typedef enum {
+    DHT11_IDLE = 0,    // 측정 안 함
+    DHT11_BUSY,        // 시작 신호 / 수신 중
+    DHT11_DONE_OK,     // 완료 (수거 대기)
+    DHT11_DONE_ERROR   // 실패 (응답 없음, 타임아웃, 체크섬)
+} DHT11_Status_t;
+
 // 함수 프로토타입
 void DHT11_Init(void);
-uint8_t DHT11_Read(DHT11_Data_t *data);
+uint8_t DHT11_Start(void);                      // 측정 시작 (바쁘면 0)
+void DHT11_Process(void);                       // 메인 루프에서 호출 (대기 없음)
+DHT11_Status_t DHT11_Collect(DHT11_Data_t *data); // 완료 결과 수거
+uint8_t DHT11_GetLastGood(DHT11_Data_t *data, uint32_t *age_ms);
+void DHT11_CaptureISR(uint16_t capture);        // TIM3 CH4 캡처 콜백에서 호출
 
-#endif // DHT11_H
\ No newline at end of file
+#endif // DHT11_H
@@ -0,0 +1,26 @@
+#ifndef FLASH_IF_H_
+#define FLASH_IF_H_
+
+#include <stdint.h>
+
+// 로그 저장용 플래시 드라이버 인터페이스
+// 섹터 번호는 논리 번호 (0, 1). 실제 위치는 구현이 결정
+// program 은 4바이트 정렬 단위, 비트는 1 → 0 으로만 바뀜 (NOR 플래시)
+
+typedef struct {
+  uint32_t sector_size;
+  int (*read)(uint8_t sector, uint32_t offset, void *buf, uint32_t len);
+  int (*program)(uint8_t sector, uint32_t offset, const void *data,
+                 uint32_t len);
+  int (*erase)(uint8_t sector);
+} FlashIf_Ops_t; // 모든 함수: 0 = 성공
+
+// STM32F411 내부 플래시 섹터 6, 7 (각 128KB, 0x08040000 ~ 0x0807FFFF)
+// ⭐ 링커 스크립트에서 코드 영역을 256KB 이하로 제한해야 함
+#define FLASH_IF_SECTOR0_ADDR 0x08040000u
+#define FLASH_IF_SECTOR1_ADDR 0x08060000u
+#define FLASH_IF_SECTOR_SIZE (128u * 1024u)
+
+extern const FlashIf_Ops_t flash_if_stm32;
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef GATE_ACTUATOR_H_
+#define GATE_ACTUATOR_H_
+
+#include <stdint.h>
+
+// 수문 서보 (TIM3 CH1/CH2) 구동 계층
+// 명령 각도를 게이트별로 기억하고, 바뀔 때만 CCR 기록 + 로그 출력
+
+typedef enum { GATE_1 = 0, GATE_2, GATE_COUNT } Gate_t;
+
+#define GATE_ANGLE_CLOSED 0
+#define GATE_ANGLE_OPEN 90
+#define GATE_ANGLE_UNKNOWN 0xFF // 초기화 전 (첫 명령은 무조건 기록)
+
+typedef struct {
+  uint8_t angle;       // 현재 명령 각도
+  uint32_t moves;      // 이동 횟수 (마모 추적)
+  uint32_t open_ms;    // 누적 열림 시간 (현재 열림 구간 포함)
+  uint32_t open_since; // 열린 시각 (닫혀 있으면 의미 없음)
+} Gate_Stats_t;
+
+// 모든 게이트 닫힘으로 강제 기록, 통계 초기화
+void Gate_Init(void);
+
+// 각도 명령. 실제로 움직였으면 1, 이미 그 각도면 0 (하드웨어 접근 없음)
+uint8_t Gate_Set(Gate_t gate, uint8_t angle);
+
+uint8_t Gate_GetAngle(Gate_t gate);
+uint8_t Gate_IsOpen(Gate_t gate);
+void Gate_GetStats(Gate_t gate, Gate_Stats_t *out);
+
+#endif
@@ -9,6 +9,25 @@
 // LCD I2C 주소 (스캔 결과: 0x27)
 #define LCD_I2C_ADDR (0x27 << 1)
 
+// LCD 크기 (16x2)
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// 비동기 전송 큐 크기 (2의 거듭제곱, 전체 화면 1회 = 136바이트)
+#ifndef LCD_TXQ_SIZE
+#define LCD_TXQ_SIZE 256
+#endif
+
+// 전송 큐 통계 (큐 크기 조정용)
+typedef struct {
+  uint16_t depth;      // 현재 대기 중인 바이트
+  uint16_t high_water; // 최대 대기 바이트
+  uint32_t overflow;   // 큐가 가득 차서 버리거나 미룬 횟수
+  uint32_t bursts;     // 완료된 I2C 전송 횟수
+  uint32_t bytes;      // 전송 완료된 바이트
+  uint32_t errors;     // I2C 오류 횟수
+} LCD_TxStats_t;
+
 // LCD 명령어
 #define LCD_CLEAR 0x01
 #define LCD_HOME 0x02
@@ -47,10 +66,13 @@ void LCD_SendCmd(char cmd);        // 명령어 전송
 void LCD_SendData(char data);      // 데이터(글자) 전송
 void LCD_SendString(char *str);    // 문자열 전송
 void LCD_PutCur(int row, int col); // 커서 위치 이동 (0~1행, 0~15열)
-void LCD_Clear(void);              // 화면 지우기
-void LCD_SetCursor(uint8_t row, uint8_t col);
-void LCD_Print(const char *str);
+void LCD_Clear(void);              // 화면 지우기 (프레임버퍼)
+void LCD_SetCursor(uint8_t row, uint8_t col); // 프레임버퍼 커서
+void LCD_Print(const char *str);              // 프레임버퍼에 쓰기
 void LCD_PrintNum(int num);
+void LCD_PrintLine(uint8_t row, const char *str); // 한 줄 (나머지 공백)
+void LCD_Flush(void); // 바뀐 칸만 LCD로 전송
 void LCD_Backlight(uint8_t state);
+void LCD_GetTxStats(LCD_TxStats_t *stats);
 
 #endif /* INC_I2C_LCD_H_ */
\ No newline at end of file
@@ -3,10 +3,30 @@
 
 #include "main.h"
 
+// 디바운스 시간 (행 4개를 1ms씩 돌아가며 스캔 → 키당 4ms마다 샘플)
+#define KEYPAD_SCAN_ROWS 4
+#define KEYPAD_DEBOUNCE_MS 20
+#define KEYPAD_EVQ_SIZE 16 // 2의 거듭제곱
+
+// 키 이벤트 (눌림/떼어짐)
+typedef struct {
+    char key;
+    uint8_t pressed; // 1: 눌림, 0: 떼어짐
+} Keypad_Event_t;
+
 // 키패드 초기화 함수 선언 추가 ⭐
 void Keypad_Init(void);
 
-// 키패드에서 눌린 문자를 반환하는 함수 (없으면 0 반환)
+// 타이머 인터럽트(1ms)에서 호출: 한 행씩 스캔 + 디바운스
+void Keypad_ScanTick(void);
+
+// 이벤트 큐에서 하나 꺼냄 (없으면 0 반환)
+uint8_t Keypad_GetEvent(Keypad_Event_t *ev);
+
+// 새로 눌린 키 문자를 반환하는 함수 (없으면 0 반환, 대기 없음)
 char Keypad_Read(void);
 
-#endif /* INC_KEYPAD_H_ */
\ No newline at end of file
+// 이벤트 큐가 가득 차서 버린 이벤트 수
+uint32_t Keypad_GetOverflowCount(void);
+
+#endif /* INC_KEYPAD_H_ */
@@ -0,0 +1,66 @@
+#ifndef LATENCY_H_
+#define LATENCY_H_
+
+#include "prof.h"
+#include <stdint.h>
+
+// ========== 감지 → 구동 지연 / 제어 주기 지터 ==========
+// 시각은 모두 Prof_Now() 틱 (타깃 CYCCNT, 시뮬레이터 가상 시간)
+//   ADC 프레임 출력(adc.c) → 상태 바뀜(Task_Level) → Dam_Auto_Control 결정
+//   → TIM3 CCR 기록(gate_actuator.c)
+// 계열마다 최근 LAT_WINDOW 개 링 → 조회할 때만 정렬해서 p50/p99
+
+#ifndef LAT_WINDOW
+#define LAT_WINDOW 128
+#endif
+
+typedef enum {
+  LAT_S_AGE,        // 제어 주기마다: 최신 ADC 프레임 나이
+  LAT_S_JITTER,     // 제어 주기 |간격 - 명목 주기|
+  LAT_S_DECIDE,     // 상태 바뀐 프레임 → 결정
+  LAT_S_ACTUATE,    // 결정 → CCR 기록
+  LAT_S_END_TO_END, // 상태 바뀐 프레임 → CCR 기록
+  LAT_S_COUNT
+} Lat_Series_t;
+
+typedef struct {
+  uint32_t count;         // 누적 (창 밖 포함)
+  uint32_t p50, p99, max; // 창 안, 틱
+  uint32_t max_all;       // 누적 최대
+} Lat_Summary_t;
+
+#if PROF_ENABLE
+
+void Lat_Reset(void);
+
+// 상태 바뀜: 그 원인이 된 ADC 프레임의 시각으로 측정 시작
+void Lat_Cross(uint32_t sample_stamp);
+// 결정 시작 / 끝 (끝까지 CCR 기록이 없으면 이번 측정은 결정까지만)
+void Lat_Decide(void);
+void Lat_DecideEnd(void);
+// CCR 기록 (결정 뒤 첫 기록만 계산)
+void Lat_Actuate(void);
+
+// 제어 태스크 시작마다: 최신 프레임 시각, 명목 주기(ms)
+void Lat_ControlTick(uint32_t sample_stamp, uint32_t period_ms);
+
+void Lat_Summary(Lat_Series_t s, Lat_Summary_t *out);
+void Lat_Print(void); // µs 표
+
+#define LAT_CROSS(stamp) Lat_Cross(stamp)
+#define LAT_DECIDE() Lat_Decide()
+#define LAT_DECIDE_END() Lat_DecideEnd()
+#define LAT_ACTUATE() Lat_Actuate()
+#define LAT_CONTROL_TICK(stamp, period) Lat_ControlTick((stamp), (period))
+
+#else
+
+#define LAT_CROSS(stamp) ((void)0)
+#define LAT_DECIDE() ((void)0)
+#define LAT_DECIDE_END() ((void)0)
+#define LAT_ACTUATE() ((void)0)
+#define LAT_CONTROL_TICK(stamp, period) ((void)0)
+
+#endif // PROF_ENABLE
+
+#endif // LATENCY_H_
@@ -0,0 +1,52 @@
+#ifndef MENU_H_
+#define MENU_H_
+
+#include "i2c-lcd.h"
+#include <stdint.h>
+
+// ========== 표 기반 메뉴 엔진 ==========
+// - 메뉴 구성(Menu_t / Menu_Item_t)은 const 표 → 플래시에 위치
+// - 커서 이동/스크롤은 Menu_Update 하나에서만 처리 (대기 없음)
+// - 값 칸은 bind 변수가 바뀔 때만 format 을 다시 호출
+// - 매 패스 비용은 보이는 줄 수(LCD_ROWS)에만 비례, 메뉴 개수와 무관
+
+#define MENU_VALUE_MAX 12 // 값 칸 최대 글자
+
+typedef enum {
+  MENU_IN_NONE = 0,
+  MENU_IN_PREV,
+  MENU_IN_NEXT,
+  MENU_IN_SELECT
+} Menu_Input_t;
+
+typedef struct {
+  const char *label; // 고정 글자 (NULL 가능)
+  // 값 칸 (없으면 format = NULL)
+  const volatile uint8_t *bind;            // 바뀌었는지 볼 변수 (NULL = 고정)
+  void (*format)(char *out, uint8_t size); // 값 글자 만들기
+  void (*on_select)(void);                 // 클릭 시 (NULL = 무시)
+} Menu_Item_t;
+
+typedef struct {
+  const Menu_Item_t *items;
+  uint8_t count;
+} Menu_t;
+
+// 메뉴 실행 상태 (RAM)
+typedef struct {
+  const Menu_t *menu; // NULL = 닫힘
+  uint8_t cursor;
+  uint8_t scroll;
+  uint8_t dirty;                      // 줄별 다시 그리기 (bit = 줄)
+  uint8_t shown[LCD_ROWS];            // 그 줄이 그려질 때의 bind 값
+  char value[LCD_ROWS][MENU_VALUE_MAX + 1]; // 값 칸 캐시
+} Menu_State_t;
+
+void Menu_Open(Menu_State_t *st, const Menu_t *menu, uint8_t cursor);
+void Menu_Close(Menu_State_t *st);
+void Menu_Invalidate(Menu_State_t *st); // 화면을 다른 곳이 덮었을 때
+
+// 입력 하나 처리 후 바뀐 줄만 프레임버퍼에 그림
+void Menu_Update(Menu_State_t *st, Menu_Input_t in);
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef MODBUS_MAP_H_
+#define MODBUS_MAP_H_
+
+#include "modbus_slave.h"
+#include <stdint.h>
+
+// ========== Modbus 레지스터 배치 ==========
+// ap.c 의 전역 변수를 가리키는 표 (펌웨어, 시뮬레이터 pty, 단위 테스트 공용)
+
+// ⭐ USART2 사용 방식: 콘솔+텔레메트리 ↔ Modbus RTU (둘은 같은 선에 못 섞음)
+#define UART_PROTO_CONSOLE 0
+#define UART_PROTO_MODBUS 1
+extern volatile uint8_t uart_proto;
+
+// input (04, 읽기 전용)
+enum {
+  MB_IN_LEVEL = 0,    // 수위 %
+  MB_IN_LEVEL_HIRES,  // 필터 출력
+  MB_IN_STATE,        // WaterState_t
+  MB_IN_TEMP,         // DHT11 온도 정수부
+  MB_IN_TEMP_DEC,     // DHT11 온도 소수부
+  MB_IN_HUMIDITY,     // DHT11 습도
+  MB_IN_DHT11_VALID,  // DHT11 값 유효
+  MB_IN_SYS_TEMP_X10, // MCU 내부 온도 (0.1°C, 부호 있음)
+  MB_IN_LOG_COUNT,    // RAM 로그 개수
+  MB_IN_LOG_APPENDS_LO, // 플래시 누적 기록 수
+  MB_IN_LOG_APPENDS_HI,
+  MB_IN_GATE1_MOVES_LO, // 게이트 마모: 이동 횟수, 누적 열림 ms (MB_MapRefresh)
+  MB_IN_GATE1_MOVES_HI,
+  MB_IN_GATE1_OPEN_MS_LO,
+  MB_IN_GATE1_OPEN_MS_HI,
+  MB_IN_GATE2_MOVES_LO,
+  MB_IN_GATE2_MOVES_HI,
+  MB_IN_GATE2_OPEN_MS_LO,
+  MB_IN_GATE2_OPEN_MS_HI,
+  MB_IN_COUNT
+};
+
+// holding (03/06/16)
+enum {
+  MB_HR_TH_LOW = 0, // 0 ~ 50, low < high
+  MB_HR_TH_HIGH,
+  MB_HR_AUTO,  // 0/1
+  MB_HR_GATE1, // 0 ~ 90 (자동 제어 중에는 거부)
+  MB_HR_GATE2,
+  MB_HR_PROTO, // 0 을 쓰면 응답 뒤 콘솔로 복귀
+  MB_HR_COUNT
+};
+
+// 주소 + 표 + 교차 조건 연결 (통계 초기화)
+void MB_MapInit(MB_Slave_t *mb);
+
+// 계산해야 하는 값 (게이트 통계) 스냅샷. 요청마다 MB_Process 전에 호출
+// → 한 요청 안의 LO/HI 가 같은 시점 값
+void MB_MapRefresh(void);
+
+// MB_HR_PROTO 에 0 이 써졌으면 1 (한 번 읽으면 지워짐)
+uint8_t MB_MapTakeExit(void);
+
+#endif
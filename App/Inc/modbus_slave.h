@@ -0,0 +1,83 @@
+#ifndef MODBUS_SLAVE_H_
+#define MODBUS_SLAVE_H_
+
+#include <stdint.h>
+
+// ========== Modbus RTU 슬레이브 ==========
+// 지원 기능: 03 Read Holding, 04 Read Input, 06 Write Single, 16 Write Multiple
+// 레지스터 표는 살아 있는 변수를 직접 가리킴 (복사본 없음)
+//  - 표의 인덱스 = 레지스터 주소
+//  - 읽을 때마다 변수에서 바로 변환, 쓸 때는 범위 확인 후 변수에 바로 기록
+// MCU 의존성 없음 (UART/타이머는 호출하는 쪽이 연결)
+
+#ifndef MODBUS_SLAVE_ADDR
+#define MODBUS_SLAVE_ADDR 1
+#endif
+
+#define MB_ADU_MAX 256 // RTU 최대 프레임 (주소 + PDU 253 + CRC 2)
+
+// 예외 코드
+#define MB_EX_NONE 0
+#define MB_EX_ILLEGAL_FUNCTION 1
+#define MB_EX_ILLEGAL_ADDRESS 2
+#define MB_EX_ILLEGAL_VALUE 3
+#define MB_EX_DEVICE_FAILURE 4
+
+// 3.5문자 프레임 간격: 19200bps 초과는 규격상 1.75ms 고정
+// 1ms 틱 기준 2틱 연속 수신이 없으면 프레임 끝 (1 ~ 2ms 무음)
+#define MB_T35_TICKS 2
+
+typedef enum {
+  MB_REG_U8,     // uint8_t 변수
+  MB_REG_U16,    // uint16_t 변수
+  MB_REG_I16,    // int16_t 변수
+  MB_REG_U32_LO, // uint32_t 변수 하위 16비트
+  MB_REG_U32_HI, // uint32_t 변수 상위 16비트
+  MB_REG_FN      // 변수가 없는 값 (get/set 함수)
+} MB_RegType_t;
+
+typedef struct {
+  uint8_t type;         // MB_RegType_t
+  volatile void *ptr;   // MB_REG_FN 이면 NULL
+  uint16_t (*get)(void);
+  // 쓰기 (holding 만): min..max 범위, set 은 MB_REG_FN 용
+  uint16_t min;
+  uint16_t max;
+  uint8_t (*set)(uint16_t value); // 예외 코드 반환 (0 = 성공)
+  // set 을 부르기 전 확인 (부작용 없음, NULL = 항상 가능). 같은 요청의 변수형
+  // 값이 이미 반영된 상태에서 불림 → 하나라도 안 되면 요청 전체를 되돌림
+  uint8_t (*can_set)(uint16_t value);
+} MB_Reg_t;
+
+typedef struct {
+  uint8_t addr;
+  const MB_Reg_t *input;
+  uint16_t n_input;
+  const MB_Reg_t *holding;
+  uint16_t n_holding;
+  // 쓰기 요청 하나를 모두 반영한 뒤 호출 (교차 조건 확인). 실패면 되돌림
+  uint8_t (*validate)(void);
+
+  uint32_t frames;     // 주소가 맞고 CRC가 맞은 요청
+  uint32_t crc_errors;
+  uint32_t exceptions;
+} MB_Slave_t;
+
+// 1ms 타이머 ISR에서 수신 DMA 위치를 넘겨 프레임 끝을 감지
+typedef struct {
+  uint16_t last_pos;
+  uint8_t quiet; // 위치가 안 바뀐 연속 틱
+  uint8_t active;
+  volatile uint8_t frame_ready;
+} MB_FrameTimer_t;
+
+void MB_Init(MB_Slave_t *mb, uint8_t addr);
+
+// 프레임 하나(CRC 포함) 처리 → 응답 길이 (0 = 응답 없음: 다른 주소, 브로드캐스트, CRC 오류)
+uint16_t MB_Process(MB_Slave_t *mb, const uint8_t *req, uint16_t len,
+                    uint8_t *resp);
+
+void MB_TimerReset(MB_FrameTimer_t *t, uint16_t pos);
+void MB_TimerTick(MB_FrameTimer_t *t, uint16_t pos);
+
+#endif
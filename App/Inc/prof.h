@@ -0,0 +1,86 @@
+#ifndef PROF_H_
+#define PROF_H_
+
+#include "scheduler.h"
+#include <stdint.h>
+
+// ========== 구간 실행 시간 측정 ==========
+// - 타깃: Cortex-M4 DWT CYCCNT (1틱 = 1 클럭), 호스트: clock_gettime (1틱 = 1ns)
+// - 구간마다 횟수 / 최소 / 최대 / 평균 + log2 히스토그램
+// - PROF_ENABLE 0 이면 매크로가 모두 빈 문장 → 코드/RAM 0
+
+#ifndef PROF_ENABLE
+#define PROF_ENABLE 1
+#endif
+
+#define PROF_HIST_BINS 24 // [i] = 2^i ~ 2^(i+1)-1 틱 (84MHz 기준 ~200ms 까지)
+
+typedef enum {
+  PROF_Z_KEYPAD,    // TIM2 1ms ISR 키패드 스캔
+  PROF_Z_LCD_FLUSH, // 바뀐 칸 I2C 전송
+  PROF_Z_PUTCHAR,   // printf 한 글자 (링 버퍼 쓰기)
+  PROF_Z_WLF_MEDIAN, // 수위 필터 단계별 샘플 1개 (WLF_PROF_STAGES 일 때만)
+  PROF_Z_WLF_IIR,
+  PROF_Z_WLF_MOVAVG,
+  PROF_Z_TASK0,     // + 스케줄러 태스크 번호 (이름은 Sched_Add 에서)
+  PROF_ZONE_COUNT = PROF_Z_TASK0 + SCHED_MAX_TASKS
+} Prof_Zone_t;
+
+typedef struct {
+  const char *name;
+  uint32_t count;
+  uint32_t min, max; // 틱
+  uint64_t sum;
+  uint32_t hist[PROF_HIST_BINS];
+} Prof_Stats_t;
+
+#if PROF_ENABLE
+
+// PROF_DWT: 호스트 시뮬레이터가 CYCCNT 를 가상 시간으로 흉내 낼 때
+#if defined(__arm__) || defined(PROF_DWT)
+#include "main.h"
+static inline uint32_t Prof_Now(void) { return DWT->CYCCNT; }
+#else
+#include <time.h>
+static inline uint32_t Prof_Now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+}
+#endif
+
+// DWT 카운터 켜기 + 통계 초기화 (타깃은 디버거 없이도 동작)
+void Prof_Init(void);
+void Prof_Reset(void);
+void Prof_SetName(uint8_t zone, const char *name);
+void Prof_Record(uint8_t zone, uint32_t ticks);
+
+// count == 0 이면 아직 측정 없음, 범위 밖이면 NULL
+const Prof_Stats_t *Prof_Get(uint8_t zone);
+uint32_t Prof_TicksPerUs(void);
+
+// 측정된 구간 표 (µs), 한 구간 히스토그램
+void Prof_PrintTable(void);
+void Prof_PrintHist(uint8_t zone);
+
+// 이름으로 구간 찾기 (없으면 PROF_ZONE_COUNT)
+uint8_t Prof_Find(const char *name);
+
+// 사용: PROF_START(t0); ...; PROF_STOP(t0, PROF_Z_LCD_FLUSH);
+#define PROF_INIT() Prof_Init()
+#define PROF_NOW() Prof_Now()
+#define PROF_START(v) const uint32_t v = Prof_Now()
+#define PROF_STOP(v, zone) Prof_Record((zone), Prof_Now() - (v))
+#define PROF_NAME(zone, name) Prof_SetName((zone), (name))
+
+#else
+
+#define PROF_INIT() ((void)0)
+#define PROF_NOW() 0u
+#define PROF_START(v)
+#define PROF_STOP(v, zone) ((void)0)
+#define PROF_NAME(zone, name) ((void)0)
+
+#endif // PROF_ENABLE
+
+#endif // PROF_H_
@@ -0,0 +1,69 @@
+#ifndef SAMPLE_STORE_H_
+#define SAMPLE_STORE_H_
+
+#include "water_history.h"
+#include <stdint.h>
+
+// 1초 샘플 압축 저장 (수위 / 습도 / 온도)
+//   블록 = 첫 샘플 원본 + 이후 샘플의 차분 스트림
+//   토큰 (varint):
+//     bit0 = 1 : 변화 없는 연속 샘플 count 개  (값 >> 1 = count)
+//     bit0 = 0 : 샘플 1개, bit1~3 = 바뀐 채널 마스크, bit4~ = 시간 간격 - 1
+//                뒤에 바뀐 채널의 지그재그 varint 차분
+// 블록 목록의 첫 샘플 시각으로 이진 탐색 → 블록 하나만 풀면 원하는 시각 도달
+
+#ifndef SSTORE_BLOCK_BYTES
+#define SSTORE_BLOCK_BYTES 256
+#endif
+#ifndef SSTORE_NUM_BLOCKS
+#define SSTORE_NUM_BLOCKS 32 // 가장 오래된 블록부터 버림
+#endif
+
+typedef struct {
+  uint32_t t0;        // 첫 샘플 시각 (epoch)
+  HistSample_t first; // 첫 샘플 원본
+  uint16_t n;         // 샘플 수 (첫 샘플 포함, 대기 중인 연속 구간 제외)
+  uint16_t len;       // data 사용 바이트
+  uint8_t data[SSTORE_BLOCK_BYTES];
+} SStore_Block_t;
+
+typedef struct {
+  SStore_Block_t blk[SSTORE_NUM_BLOCKS];
+  uint16_t head;  // 기록 중인 블록
+  uint16_t count; // 유효 블록 수
+  // 인코더 상태
+  HistSample_t prev;
+  uint32_t prev_t;
+  uint16_t run; // 아직 기록 안 한 '변화 없음' 샘플 수
+  // 통계
+  uint32_t samples;
+  uint32_t evicted; // 버린 블록 수
+} SStore_t;
+
+typedef struct {
+  const SStore_t *st;
+  uint16_t blk;   // 논리 블록 번호 (0 = 가장 오래된)
+  uint16_t pos;   // 블록 내 바이트 위치
+  uint16_t run;   // 남은 연속 샘플
+  uint8_t started;
+  uint8_t hold; // 현재 샘플을 아직 반환 안 함 (IterBegin 직후)
+  uint32_t t;
+  HistSample_t s;
+} SStore_Iter_t;
+
+void SStore_Init(SStore_t *st);
+void SStore_Append(SStore_t *st, uint32_t epoch, const HistSample_t *s);
+
+// from 이하 중 가장 가까운 샘플부터 순서대로 읽기
+void SStore_IterBegin(const SStore_t *st, uint32_t from, SStore_Iter_t *it);
+uint8_t SStore_IterNext(SStore_Iter_t *it, uint32_t *t, HistSample_t *s);
+
+// 해당 시각 (또는 그 직전) 샘플
+uint8_t SStore_Find(const SStore_t *st, uint32_t epoch, uint32_t *t,
+                    HistSample_t *out);
+
+uint32_t SStore_BytesUsed(const SStore_t *st);
+// 압축 전 크기 (시각 4B + 샘플 4B) 대비 비율 x100
+uint32_t SStore_RatioX100(const SStore_t *st);
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include <stdint.h>
+
+// 협조형 주기 태스크 스케줄러 (HAL_GetTick 1ms 기준)
+// - 마감 비교는 (int32_t)(now - due) 로 해서 49일 랩어라운드에도 안전
+// - 실행할 태스크가 없으면 __WFI()로 다음 인터럽트까지 대기
+
+#define SCHED_MAX_TASKS 16
+
+// 우선순위: 숫자가 작을수록 먼저 실행
+#define SCHED_PRIO_CONTROL 0
+#define SCHED_PRIO_NORMAL 1
+#define SCHED_PRIO_UI 2
+
+// 마감 지났는지 (0이 아닌 절대 시각 deadline 대상, 랩어라운드 안전)
+#define SCHED_EXPIRED(now, deadline) ((int32_t)((now) - (deadline)) >= 0)
+
+typedef void (*Sched_TaskFn_t)(void);
+
+typedef struct {
+  const char *name;
+  Sched_TaskFn_t fn;
+  uint32_t period_ms;
+  uint32_t next_due;
+  uint8_t priority;
+  uint8_t enabled; // 0 이면 마감이 지나도 실행 안 함 (깨우지도 않음)
+  uint32_t runs;
+  uint32_t overruns;    // 한 주기 이상 늦어 건너뛴 슬롯 수
+  uint32_t max_late_ms; // 마감 대비 최대 지연
+} Sched_Task_t;
+
+void Sched_Init(void);
+
+// phase_ms 뒤 첫 실행, 이후 period_ms 마다. 태스크 번호 반환 (가득 차면 -1)
+int8_t Sched_Add(const char *name, Sched_TaskFn_t fn, uint32_t period_ms,
+                 uint32_t phase_ms, uint8_t priority);
+
+// 다음 실행을 지금부터 delay_ms 뒤로 다시 잡음 (재시도 등)
+void Sched_Delay(int8_t id, uint32_t delay_ms);
+
+// 끄기/켜기 (등록 시 켜짐). 켜면 지금부터 다시 주기 시작
+void Sched_Enable(int8_t id, uint8_t on);
+
+// 마감된 태스크를 우선순위 순으로 모두 실행, 없으면 __WFI()
+void Sched_Dispatch(void);
+
+uint8_t Sched_Count(void);
+const Sched_Task_t *Sched_Get(uint8_t id);
+
+#endif
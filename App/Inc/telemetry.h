@@ -0,0 +1,102 @@
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include "cobs.h"
+#include <stdint.h>
+
+// ========== 바이너리 텔레메트리 (USART2) ==========
+// 프레임: 0x00 | COBS( ver | type | seq(LE16) | payload | crc16(LE) ) | 0x00
+//  - crc16 은 ver ~ payload 범위 (CRC-16/CCITT-FALSE, crc16.h)
+//  - 앞뒤 0x00 으로 printf 디버그 텍스트와 섞여도 다음 프레임에서 재동기
+//  - 모든 정수는 리틀 엔디언, 필드는 뒤에만 추가 (디코더는 긴 payload 허용)
+// MCU 의존성 없음 → 호스트 디코더(Tools/tlm_decode.c)와 같은 코드 사용
+
+#define TLM_VERSION 1
+
+#define TLM_TYPE_SAMPLE 0x01 // 1초 샘플
+#define TLM_TYPE_EVENT 0x02  // LOW/HIGH 이벤트 시작·종료
+#define TLM_TYPE_STATUS 0x03 // 주기 상태
+
+#define TLM_HDR_LEN 4
+#define TLM_CRC_LEN 2
+#define TLM_MAX_PAYLOAD 32
+#define TLM_MAX_RAW (TLM_HDR_LEN + TLM_MAX_PAYLOAD + TLM_CRC_LEN)
+#define TLM_MAX_FRAME (COBS_MAX_ENCODED(TLM_MAX_RAW) + 2)
+
+#define TLM_SAMPLE_LEN 11
+#define TLM_EVENT_LEN 18
+#define TLM_STATUS_LEN 19
+
+typedef struct {
+  uint32_t epoch;
+  uint16_t level_hires; // 필터 출력 (0 ~ ADC_HIRES_MAX)
+  uint8_t level;        // %
+  uint8_t state;        // WaterState_t
+  int16_t temp_x10;
+  uint8_t humidity; // 0xFF = 무효
+} Tlm_Sample_t;
+
+typedef struct {
+  uint32_t start;      // 시작 epoch
+  uint32_t duration_s; // 진행 중이면 지금까지
+  uint32_t integral;   // %·s
+  uint8_t state;
+  uint8_t level; // 시작 수위
+  uint8_t peak;
+  uint8_t trough;
+  uint8_t mean;
+  uint8_t ended;
+} Tlm_Event_t;
+
+typedef struct {
+  uint32_t uptime_ms;
+  uint32_t uart_dropped; // UART 링에서 버린 바이트 (텍스트 포함)
+  uint32_t tlm_dropped;  // 자리가 없어 보내지 않은 프레임
+  uint16_t log_count;
+  uint8_t th_low;
+  uint8_t th_high;
+  uint8_t auto_mode;
+  uint8_t gate_mask; // bit0 = GATE_1, bit1 = GATE_2 열림
+  uint8_t state;
+} Tlm_Status_t;
+
+// 출력 포트 (UART 링 등). room 이 프레임보다 작으면 그 프레임은 버림
+typedef struct {
+  uint16_t (*room)(void);
+  uint16_t (*write)(const uint8_t *data, uint16_t len);
+} Tlm_Port_t;
+
+typedef struct {
+  const Tlm_Port_t *port;
+  uint16_t seq;
+  uint32_t sent;    // 보낸 프레임
+  uint32_t dropped; // 버린 프레임
+  uint32_t bytes;   // 보낸 바이트 (구분자 포함)
+} Tlm_t;
+
+// 수신 측에서 풀어낸 프레임
+typedef struct {
+  uint8_t ver;
+  uint8_t type;
+  uint16_t seq;
+  uint8_t len;
+  uint8_t payload[TLM_MAX_PAYLOAD];
+} Tlm_Frame_t;
+
+// 송신
+void Tlm_Init(Tlm_t *t, const Tlm_Port_t *port);
+uint8_t Tlm_SendSample(Tlm_t *t, const Tlm_Sample_t *s);
+uint8_t Tlm_SendEvent(Tlm_t *t, const Tlm_Event_t *e);
+uint8_t Tlm_SendStatus(Tlm_t *t, const Tlm_Status_t *st);
+
+// 프레임 조립 (송신 경로 / 벤치마크용). frame 은 TLM_MAX_FRAME 이상
+uint16_t Tlm_BuildFrame(uint8_t type, uint16_t seq, const uint8_t *payload,
+                        uint8_t len, uint8_t *frame);
+
+// 수신: 구분자 사이 바이트 → 프레임. CRC/버전/길이가 맞으면 1
+uint8_t Tlm_ParseFrame(const uint8_t *enc, uint16_t len, Tlm_Frame_t *out);
+uint8_t Tlm_DecodeSample(const Tlm_Frame_t *f, Tlm_Sample_t *s);
+uint8_t Tlm_DecodeEvent(const Tlm_Frame_t *f, Tlm_Event_t *e);
+uint8_t Tlm_DecodeStatus(const Tlm_Frame_t *f, Tlm_Status_t *st);
+
+#endif
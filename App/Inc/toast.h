@@ -0,0 +1,41 @@
+#ifndef TOAST_H_
+#define TOAST_H_
+
+#include <stdint.h>
+
+// ========== LCD 메시지(토스트) + 부저 패턴 ==========
+// - 화면 그리기가 끝난 프레임버퍼 위에 덮어쓰고, 시간이 지나면 아래 화면이 다시 보임
+// - 우선순위가 같거나 높은 메시지만 보이는 메시지를 밀어냄
+// - 부저도 같은 타이머(Toast_Tick)로 패턴 재생 → 대기 없음
+
+typedef enum {
+  TOAST_PRIO_INFO = 0,
+  TOAST_PRIO_WARN,
+  TOAST_PRIO_ALARM
+} Toast_Prio_t;
+
+typedef enum {
+  TOAST_BEEP_NONE = 0,
+  TOAST_BEEP_SHORT,  // 300ms
+  TOAST_BEEP_LONG,   // 500ms
+  TOAST_BEEP_DOUBLE, // 100ms x 2
+  TOAST_BEEP_ALARM   // 150ms x 3
+} Toast_Beep_t;
+
+#define TOAST_BEEP_SLOT_MS 50 // 부저 패턴 한 칸
+
+// line0 / line1 이 NULL 이면 그 줄은 아래 화면 그대로
+// 반환: 1 = 표시, 0 = 더 높은 우선순위 메시지가 있어 무시
+uint8_t Toast_Show(const char *line0, const char *line1, uint16_t duration_ms,
+                   Toast_Prio_t prio, Toast_Beep_t beep);
+void Toast_Cancel(void);
+uint8_t Toast_IsActive(void);
+
+// 주기 태스크에서 호출 (10ms 이하 권장): 부저 패턴 + 만료 처리
+void Toast_Tick(uint32_t now);
+
+// 화면 그리기 후, LCD_Flush 전에 호출
+// 반환: 1 = 방금 사라짐 (게으른 화면은 다시 그려야 함)
+uint8_t Toast_Render(void);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef WATER_CLASSIFIER_H_
+#define WATER_CLASSIFIER_H_
+
+#include <stdint.h>
+
+typedef enum { WATER_ST_OK = 0, WATER_ST_LOW, WATER_ST_HIGH } WaterState_t;
+
+// 수위 → LOW / OK / HIGH 판정 (로그, 자동 제어, RGB LED 공용)
+//   히스테리시스: LOW 는 th_low + h 이상, HIGH 는 th_high - h 이하가 되어야 빠져나옴
+//   최소 유지 시간: 새 상태가 dwell_ms 동안 계속돼야 확정
+#define WATER_CLS_DEFAULT_HYST 3        // %
+#define WATER_CLS_DEFAULT_DWELL_MS 2000 // ms
+
+typedef struct {
+  uint8_t hysteresis;
+  uint32_t dwell_ms;
+  WaterState_t state;   // 확정 상태
+  WaterState_t pending; // 확정 대기 중인 후보
+  uint32_t pending_since;
+  uint32_t changes;     // 확정된 전환 수
+  uint32_t rejected;    // dwell 전에 사라진 후보 수 (걸러진 떨림)
+} WaterClassifier_t;
+
+void WaterCls_Init(WaterClassifier_t *c, uint8_t hysteresis,
+                   uint32_t dwell_ms);
+
+// 샘플 하나 반영 후 확정 상태 반환
+WaterState_t WaterCls_Update(WaterClassifier_t *c, uint8_t level,
+                             uint8_t th_low, uint8_t th_high,
+                             uint32_t now_ms);
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef WATER_HISTORY_H_
+#define WATER_HISTORY_H_
+
+#include <stdint.h>
+
+// 추세 기록 (RAM 고정 크기 링 3단)
+//   raw  : 1초 샘플 (수위, 온도, 습도)
+//   min  : 1분 최소/최대/평균
+//   hour : 1시간 최소/최대/평균
+// 샘플 하나당 누적기만 갱신 → O(1). 시각은 마지막 샘플 기준으로 역산
+
+#ifndef HIST_RAW_LEN
+#define HIST_RAW_LEN 300 // 5분
+#endif
+#ifndef HIST_MIN_LEN
+#define HIST_MIN_LEN 1440 // 24시간
+#endif
+#ifndef HIST_HOUR_LEN
+#define HIST_HOUR_LEN 168 // 7일
+#endif
+
+// 메모리 상한 (넘으면 컴파일 오류)
+#ifndef HIST_RAM_BUDGET
+#define HIST_RAM_BUDGET (32u * 1024u)
+#endif
+
+#define HIST_ENV_INVALID 0xFF // humidity 에 넣으면 온습도 없음
+
+typedef struct {
+  uint8_t level;    // %
+  uint8_t humidity; // %, HIST_ENV_INVALID = 측정 실패
+  int16_t temp_x10; // 0.1°C
+} HistSample_t;
+
+typedef struct {
+  uint8_t level_min, level_max, level_mean;
+  uint8_t hum_min, hum_max, hum_mean;
+  int16_t temp_min, temp_max, temp_mean;
+  uint16_t n;     // 수위 샘플 수 (0 = 빈 구간)
+  uint16_t n_env; // 온습도 샘플 수
+} HistRollup_t;
+
+// 진행 중인 구간 누적기
+typedef struct {
+  uint8_t level_min, level_max;
+  uint8_t hum_min, hum_max;
+  int16_t temp_min, temp_max;
+  uint32_t level_sum, hum_sum;
+  int32_t temp_sum;
+  uint16_t n, n_env;
+} HistAcc_t;
+
+typedef struct {
+  HistRollup_t buf[HIST_MIN_LEN];
+  uint16_t head, count;
+} HistMinRing_t;
+
+typedef struct {
+  HistRollup_t buf[HIST_HOUR_LEN];
+  uint16_t head, count;
+} HistHourRing_t;
+
+typedef struct {
+  HistSample_t raw[HIST_RAW_LEN];
+  uint16_t raw_head, raw_count;
+  HistMinRing_t min;
+  HistHourRing_t hour;
+  HistAcc_t min_acc, hour_acc;
+  uint32_t last_epoch; // 마지막 샘플 시각
+  uint32_t gaps;       // 시간이 건너뛰어 빈 구간으로 채운 수
+} History_t;
+
+void History_Init(History_t *h);
+void History_AddSample(History_t *h, uint32_t epoch, const HistSample_t *s);
+
+// age 0 = 가장 최근 (완료된 구간). 없으면 0
+uint8_t History_GetRaw(const History_t *h, uint16_t age, HistSample_t *out);
+uint8_t History_GetMinute(const History_t *h, uint16_t age, HistRollup_t *out);
+uint8_t History_GetHour(const History_t *h, uint16_t age, HistRollup_t *out);
+
+uint16_t History_RawCount(const History_t *h);
+uint16_t History_MinuteCount(const History_t *h);
+uint16_t History_HourCount(const History_t *h);
+
+uint32_t History_MemoryBytes(void);
+
+#endif
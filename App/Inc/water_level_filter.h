@@ -0,0 +1,52 @@
+#ifndef WATER_LEVEL_FILTER_H_
+#define WATER_LEVEL_FILTER_H_
+
+#include <stdint.h>
+
+// 수위 신호 정형 필터 (고정소수점, 단계 조합 가능)
+//   MEDIAN : 최근 N개 중앙값 → 스파이크 제거 (N 홀수, 최대 7)
+//   IIR    : 1차 IIR, y += (x - y) / 2^k
+//   MOVAVG : 이동 평균 (창 최대 16)
+
+typedef enum {
+  WLF_STAGE_MEDIAN = 0,
+  WLF_STAGE_IIR,
+  WLF_STAGE_MOVAVG
+} WLF_StageType_t;
+
+#define WLF_MAX_STAGES 4
+#define WLF_MEDIAN_MAX 7
+#define WLF_MOVAVG_MAX 16
+#define WLF_IIR_FRAC_BITS 8 // IIR 내부 소수부 비트 (반올림 오차 방지)
+
+// 1 이면 단계마다 PROF 구간 (median / iir / movavg) 기록 → 샘플당 사이클
+// 측정 자체가 단계 하나와 비슷한 비용이라 평소에는 끔 (Sim 벤치에서 켬)
+#ifndef WLF_PROF_STAGES
+#define WLF_PROF_STAGES 0
+#endif
+
+typedef struct {
+  WLF_StageType_t type;
+  uint8_t param; // MEDIAN: N / IIR: k / MOVAVG: 창 크기
+  uint8_t idx;
+  uint8_t count;
+  uint16_t hist[WLF_MOVAVG_MAX]; // MEDIAN, MOVAVG 공용 링
+  uint32_t acc;                  // MOVAVG: 합계 / IIR: y (Q.WLF_IIR_FRAC_BITS)
+} WLF_Stage_t;
+
+typedef struct {
+  WLF_Stage_t stage[WLF_MAX_STAGES];
+  uint8_t num_stages;
+  uint16_t out; // 마지막 출력 (입력과 같은 스케일)
+} WaterLevelFilter_t;
+
+void WLF_Init(WaterLevelFilter_t *f);
+
+// 단계 추가 (순서대로 연결). 파라미터가 잘못됐거나 가득 차면 0
+uint8_t WLF_AddStage(WaterLevelFilter_t *f, WLF_StageType_t type,
+                     uint8_t param);
+
+// 샘플 1개 처리 → 필터 출력
+uint16_t WLF_Process(WaterLevelFilter_t *f, uint16_t sample);
+
+#endif
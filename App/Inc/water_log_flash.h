@@ -0,0 +1,80 @@
+#ifndef WATER_LOG_FLASH_H_
+#define WATER_LOG_FLASH_H_
+
+#include "flash_if.h"
+#include "water_state_logger.h"
+#include <stdint.h>
+
+// 수위 이벤트 영구 저장 (플래시 섹터 2개 핑퐁, 추가 전용)
+//
+// 섹터 = [헤더 16B][슬롯 0][슬롯 1]...
+//   헤더 : magic, seq, ~seq  (seq 큰 쪽이 현재 섹터)
+//   슬롯 : 레코드 + 통계 + CRC16 2개. 지워진 상태(0xFF..)에서 앞에서부터 채움
+//          (통계는 RAM 에 최근 것만 두므로 전체 이력은 여기에만 있음)
+// 현재 섹터가 차면 다른 섹터를 지우고 seq+1 로 이어서 기록
+// → 두 섹터가 번갈아 지워지므로 마모가 고르게 분산
+// 지우기(1~2초)는 WLFlash_Service 가 미리 해 두고, 추가는 헤더만 씀
+
+#define WLFLASH_MAGIC 0x57414C31u // "WAL1"
+#define WLFLASH_HDR_SIZE 16u
+
+typedef struct {
+  WaterRecord_t rec; // 추가 시 start, packed 기록
+  WaterStats_t st;   // 종료 시 packed 지속 시간 비트 (1 → 0) 와 함께 기록
+  uint16_t crc;      // start + 상태/수위 (packed 하위 9비트)
+  uint16_t dur_crc;  // 지속 시간 + 통계 (0xFFFF = 종료 기록 없음)
+} WLFlash_Slot_t;
+
+#define WLFLASH_SLOT_SIZE sizeof(WLFlash_Slot_t) // 8 + 8 + 4 = 20B
+
+// 현재 섹터가 이만큼 차면 다른 섹터를 미리 지움 (3/4)
+#define WLFLASH_SPARE_MARK(fs) ((fs)->slots_per_sector / 4u * 3u)
+
+typedef struct WLFlash {
+  const FlashIf_Ops_t *ops;
+  uint32_t slots_per_sector;
+  uint8_t active;      // 현재 기록 중인 섹터 (0/1)
+  uint8_t prev_valid;  // 다른 섹터에 이전 기록이 남아 있는지
+  uint32_t seq;        // 현재 섹터 seq
+  uint32_t tail;       // 현재 섹터 다음 빈 슬롯
+  uint32_t prev_tail;  // 이전 섹터 기록 수
+  uint8_t last_open;   // 마지막 슬롯이 진행 중 이벤트인지 (종료 기록 대상)
+  uint8_t spare_ready; // 다른 섹터가 미리 지워져 있음 (넘어갈 때 헤더만)
+  // 통계
+  uint32_t mount_reads; // 부팅 시 tail 찾기에 읽은 슬롯 수
+  uint32_t appends;
+  uint32_t closes;
+  uint32_t erases;
+  uint32_t crc_errors;  // 복원 중 버린 (전원 차단으로 깨진) 슬롯
+  uint32_t repairs;     // 복원 중 마저 쓴 (종료 기록이 끊긴) 슬롯
+  uint32_t io_errors;
+} WLFlash_t;
+
+// 헤더 확인 + 이진 탐색으로 tail 찾기 (빈 플래시면 포맷). 실패 시 0
+uint8_t WLFlash_Mount(WLFlash_t *fs, const FlashIf_Ops_t *ops);
+
+// 저장된 레코드 중 최근 WATERLOG_MAX 개를 RAM 로그로 복원 (통계는 최근 것만)
+void WLFlash_Replay(WLFlash_t *fs, WaterLog_t *log);
+
+// 새 이벤트 추가 (진행 중 상태로)
+uint8_t WLFlash_Append(WLFlash_t *fs, const WaterRecord_t *rec);
+
+// 백그라운드 단계: 현재 섹터가 WLFLASH_SPARE_MARK 이상 찼고 진행 중 이벤트가
+// 없으면 다른 섹터를 미리 지움 (이전 섹터 기록은 버려짐). 지웠으면 1
+// ⭐ 단일 뱅크라 지우는 동안 CPU 가 멈추므로 수위가 정상일 때만 부를 것
+uint8_t WLFlash_Service(WLFlash_t *fs);
+
+// 마지막 이벤트 종료 (지속 시간 + 통계 기록)
+uint8_t WLFlash_CloseLast(WLFlash_t *fs, const WaterRecord_t *rec,
+                          const WaterStats_t *st);
+
+// 저장된 전체 레코드 수 (두 섹터 합)
+uint32_t WLFlash_Count(const WLFlash_t *fs);
+
+// 슬롯 vidx (0 = 가장 오래된, WLFlash_Count 기준) 의 종료 통계
+// 슬롯이 rec 와 같은 이벤트이고 종료 기록이 온전할 때만 1
+// (RAM 통계 표 밖의 오래된 이벤트용, 슬롯 하나 읽음)
+uint8_t WLFlash_ReadStats(WLFlash_t *fs, uint32_t vidx,
+                          const WaterRecord_t *rec, WaterStats_t *out);
+
+#endif
@@ -2,10 +2,54 @@
 #define WATER_STATE_LOGGER_H_
 
 #include "rtc.h"
+#include "water_classifier.h"
 #include <stdint.h>
 
-typedef enum { WATER_ST_OK = 0, WATER_ST_LOW, WATER_ST_HIGH } WaterState_t;
+// ⭐ 저장용 레코드 (8바이트)
+//   start  : 시작 시각 (유닉스 epoch 초)
+//   packed : [31:9] 지속 시간(초, 23비트) [8:7] 상태 [6:0] 시작 수위 %
+typedef struct {
+  uint32_t start;
+  uint32_t packed;
+} WaterRecord_t;
+
+// ⭐ 종료된 이벤트 통계 (8바이트). RAM 에는 최근 WATERLOG_STATS_MAX 개만,
+//    플래시 슬롯에는 전부 (water_log_flash.h)
+//   integral : 수위 × 시간 (%·s, 포화)
+//   stats    : [31] 유효 [20:14] 평균 [13:7] 최저 [6:0] 최고
+typedef struct {
+  uint32_t integral;
+  uint32_t stats;
+} WaterStats_t;
+
+#define WATERLOG_DUR_BITS 23
+#define WATERLOG_DUR_ONGOING 0x7FFFFFu // 진행 중 (종료 전)
+#define WATERLOG_DUR_MAX (WATERLOG_DUR_ONGOING - 1) // 약 97일에서 포화
+
+// packed 필드 배치
+#define WATERLOG_LEVEL_MASK 0x7Fu
+#define WATERLOG_STATE_SHIFT 7
+#define WATERLOG_STATE_MASK 0x3u
+#define WATERLOG_DUR_SHIFT 9
+
+#define WATERLOG_PACK(dur, st, lvl)                                            \
+  (((uint32_t)(dur) << WATERLOG_DUR_SHIFT) |                                   \
+   (((uint32_t)(st) & WATERLOG_STATE_MASK) << WATERLOG_STATE_SHIFT) |          \
+   ((uint32_t)(lvl) & WATERLOG_LEVEL_MASK))
+#define WATERLOG_DUR(p) ((p) >> WATERLOG_DUR_SHIFT)
+#define WATERLOG_STATE(p)                                                      \
+  ((WaterState_t)(((p) >> WATERLOG_STATE_SHIFT) & WATERLOG_STATE_MASK))
+#define WATERLOG_LEVEL(p) ((uint8_t)((p) & WATERLOG_LEVEL_MASK))
+
+#define WATERLOG_STATS(peak, trough, mean)                                     \
+  (((uint32_t)(peak) & 0x7Fu) | (((uint32_t)(trough) & 0x7Fu) << 7) |          \
+   (((uint32_t)(mean) & 0x7Fu) << 14))
+#define WATERLOG_STATS_VALID (1u << 31)
+#define WATERLOG_PEAK(s) ((uint8_t)((s) & 0x7Fu))
+#define WATERLOG_TROUGH(s) ((uint8_t)(((s) >> 7) & 0x7Fu))
+#define WATERLOG_MEAN(s) ((uint8_t)(((s) >> 14) & 0x7Fu))
 
+// 화면 표시용 (WaterLog_GetByViewIndex 가 필요할 때만 풀어서 채움)
 typedef struct {
   WaterState_t state;      // LOW / HIGH
   uint8_t level_percent;   // 이벤트 순간 수위
@@ -14,27 +58,122 @@ typedef struct {
   RTC_TimeTypeDef t_end;   // 종료 시간 (OK 복귀)
   RTC_DateTypeDef d_end;   // 종료 날짜
   uint8_t ended;           // 종료 여부 (0: 진행중, 1: 종료됨)
+  uint32_t start_epoch;
+  uint32_t duration_s;     // 진행 중이면 지금까지
+  uint8_t has_stats;       // 0 이면 아래 통계 없음 (저장소 없이 RAM 표 밖 등)
+  uint8_t peak_percent;    // 최고 수위
+  uint8_t trough_percent;  // 최저 수위
+  uint8_t mean_percent;    // 평균 수위 (1초 샘플)
+  uint32_t integral;       // 수위 × 시간 (%·s)
 } WaterEvent_t;
 
-#define WATERLOG_MAX 10
+// 레코드 수 (컴파일 시 변경 가능, 최대 65535)
+#ifndef WATERLOG_MAX
+#define WATERLOG_MAX 256
+#endif
+
+// 통계를 RAM 에 들고 있는 최근 이벤트 수 (WATERLOG_MAX 의 약수)
+//   256 레코드 × 8B + 32 통계 × 8B = 2304B (레코드마다 통계면 4096B)
+#ifndef WATERLOG_STATS_MAX
+#define WATERLOG_STATS_MAX ((WATERLOG_MAX < 32) ? WATERLOG_MAX : 32)
+#endif
+#if (WATERLOG_MAX % WATERLOG_STATS_MAX) != 0
+#error "WATERLOG_STATS_MAX must divide WATERLOG_MAX"
+#endif
+
+struct WLFlash; // water_log_flash.h
+
+// 진행 중 이벤트 누적 (WaterLog_Update 마다 O(1))
+typedef struct {
+  uint8_t peak;
+  uint8_t trough;
+  uint32_t n;        // 샘플 수
+  uint32_t sum;      // 샘플 합 (평균용)
+  uint32_t integral; // %·s
+  uint32_t last_t;   // 마지막 샘플 시각
+} WaterLog_Live_t;
 
 typedef struct {
-  WaterEvent_t ev[WATERLOG_MAX];
-  uint8_t head;
-  uint8_t count;
-  uint8_t view;
+  WaterRecord_t rec[WATERLOG_MAX];
+  WaterStats_t stats[WATERLOG_STATS_MAX]; // rec[i] 통계 = stats[i % STATS_MAX]
+  uint16_t head;
+  uint16_t count;
+  uint16_t breaks; // 시작 시각이 바로 앞 레코드보다 이른 곳 수 (0 = 시간 순)
   WaterState_t live_state;
+  WaterLog_Live_t live;
+  uint32_t live_now;     // 마지막 Update 시각 (진행 중 이벤트 표시용)
+  struct WLFlash *store; // 영구 저장 (NULL 이면 RAM 만)
 } WaterLog_t;
 
 void WaterLog_Init(WaterLog_t *log);
 
-void WaterLog_Update(WaterLog_t *log, uint8_t level_percent, uint8_t th_low,
-                     uint8_t th_high, const RTC_TimeTypeDef *now_t,
+// 플래시 저장소 연결 + 저장된 최근 이벤트 복원 (WaterLog_Init 이후)
+void WaterLog_AttachStore(WaterLog_t *log, struct WLFlash *store);
+
+// state 는 WaterCls_Update 로 확정된 상태 (판정은 여기서 하지 않음)
+void WaterLog_Update(WaterLog_t *log, WaterState_t state,
+                     uint8_t level_percent, const RTC_TimeTypeDef *now_t,
                      const RTC_DateTypeDef *now_d);
 
-uint8_t WaterLog_Count(const WaterLog_t *log);
+uint16_t WaterLog_Count(const WaterLog_t *log);
+
+// view_index 0 = 가장 오래된 이벤트. 없으면 0
+// 통계(최고/최저/평균/적분)는 최근 WATERLOG_STATS_MAX 개는 RAM 표에서, 그보다
+// 오래된 것은 저장소가 있으면 플래시 슬롯에서 (has_stats)
+uint8_t WaterLog_GetByViewIndex(const WaterLog_t *log, uint16_t view_index,
+                                WaterEvent_t *out);
+
+// ========== 조회 ==========
+// 레코드는 보통 시작 시각 순. RTC 가 과거로 돌아가면 (백업 전지 방전, 수동
+// 설정) 그 자리에서 순서가 끊김 → breaks 가 0 이 아니면 아래 조회는 이진 탐색
+// 대신 전체를 훑음 (256개, 각 레코드를 따로 판단)
+
+// 상태 필터 (비트마스크)
+#define WATERLOG_F_LOW (1u << WATER_ST_LOW)
+#define WATERLOG_F_HIGH (1u << WATER_ST_HIGH)
+#define WATERLOG_F_ALL (WATERLOG_F_LOW | WATERLOG_F_HIGH)
+
+#define WATERLOG_NONE 0xFFFFu
+
+// 시작 시각이 epoch 이상인 첫 이벤트 (이진 탐색, 순서가 끊겼으면 로그 순서로
+// 처음 나오는 것). 없으면 Count
+uint16_t WaterLog_FindFirstAtOrAfter(const WaterLog_t *log, uint32_t epoch);
+
+// from 부터 앞/뒤로 필터에 맞는 첫 이벤트. 없으면 WATERLOG_NONE
+uint16_t WaterLog_FindNext(const WaterLog_t *log, uint16_t from,
+                           uint8_t filter);
+uint16_t WaterLog_FindPrev(const WaterLog_t *log, uint16_t from,
+                           uint8_t filter);
+
+// [from, to) 구간과 겹치는 이벤트 수 / 겹친 시간 (상태별, 진행 중은 now 까지)
+typedef struct {
+  uint16_t count[3];   // WaterState_t 로 인덱스 (OK 는 항상 0)
+  uint32_t seconds[3];
+} WaterLog_Agg_t;
+
+void WaterLog_Aggregate(const WaterLog_t *log, uint32_t from, uint32_t to,
+                        uint32_t now, WaterLog_Agg_t *out);
+
+// 내보낼 이벤트: 시작 시각 [from, to) + 상태 필터
+typedef struct {
+  uint32_t from;
+  uint32_t to;
+  uint8_t filter; // WATERLOG_F_*
+} WaterLog_Range_t;
+
+#define WATERLOG_RANGE_ALL {0, UINT32_MAX, WATERLOG_F_ALL}
+
+// CSV 내보내기 (printf). view [from, count) 중 range 에 맞는 것 max_lines 줄,
+// 다음 view 반환 (끝이면 Count). 시간 순이면 to 를 만나면 끝, 순서가 끊겼으면
+// 레코드마다 판단. 시작 view 는 WaterLog_FindFirstAtOrAfter(range->from)
+// (UART 링이 넘치지 않게 호출하는 쪽에서 나눠서 부름)
+void WaterLog_ExportHeader(void);
+uint16_t WaterLog_ExportCSV(const WaterLog_t *log, uint16_t from,
+                            uint16_t max_lines, const WaterLog_Range_t *range);
 
-const WaterEvent_t *WaterLog_GetByViewIndex(const WaterLog_t *log,
-                                            uint8_t view_index);
+// RTC (2000~2099년) <-> 유닉스 epoch 초
+uint32_t WaterLog_ToEpoch(const RTC_TimeTypeDef *t, const RTC_DateTypeDef *d);
+void WaterLog_FromEpoch(uint32_t epoch, RTC_TimeTypeDef *t,
+                        RTC_DateTypeDef *d);
 
-#endif
\ No newline at end of file
+#endif
@@ -1,12 +1,28 @@
 #include "ap.h"
 #include "adc.h"
+#include "console.h"
 #include "dht11.h"
+#include "flash_if.h"
+#include "gate_actuator.h"
 #include "i2c-lcd.h"
 #include "keypad.h"
+#include "latency.h"
+#include "menu.h"
+#include "modbus_map.h"
+#include "modbus_slave.h"
+#include "prof.h"
 #include "rtc.h"
+#include "sample_store.h"
+#include "scheduler.h"
+#include "telemetry.h"
+#include "toast.h"
 #include "stm32f4xx_hal_rtc.h"
 #include "tim.h"
 #include "usart.h"
+#include "water_classifier.h"
+#include "water_history.h"
+#include "water_level_filter.h"
+#include "water_log_flash.h"
 #include "water_state_logger.h"
 #include <stdint.h>
 #include <stdio.h>
@@ -14,7 +30,18 @@
 #include <string.h>
 
 // ========== 전역 변수 ==========
-volatile uint16_t adc_values[4];
+ADC_Frame_t adc_frame = {0}; // ⭐ 패스마다 한 번 복사한 ADC 스냅샷
+
+// ⭐ 수위 (필터 통과값, 새 ADC 프레임마다 한 번만 계산)
+WaterLevelFilter_t level_filter;
+uint32_t level_seq = 0;         // 마지막으로 처리한 adc_frame.seq
+uint16_t water_level_hires = 0; // 필터 출력 (0 ~ ADC_HIRES_MAX)
+uint8_t water_level = 0;        // 0 ~ 100 %
+int16_t sys_temp_x10 = 0;       // MCU 내부 온도 (0.1°C)
+
+// ⭐ 수위 상태 (히스테리시스 + 최소 유지 시간, 로그/자동 제어/LED 공용)
+WaterClassifier_t level_cls;
+WaterState_t water_state = WATER_ST_OK;
 volatile SystemMode_t current_mode = MODE_PASSWORD_INPUT;
 uint8_t is_logged_in = 0; // 0: 로그인 전, 1: 로그인 완료
 
@@ -32,8 +59,6 @@ uint8_t pw_locked = 0;
 uint32_t pw_lock_start_time = 0;
 
 // 백그라운드
-uint32_t last_dht11_time = 0;
-uint32_t last_rtc_time = 0;
 DHT11_Data_t global_dht11_data = {0};
 RTC_TimeTypeDef global_time = {0};
 RTC_DateTypeDef global_date = {0};
@@ -61,12 +86,25 @@ uint8_t threshold_low = 10;
 
 // ⭐ 로그 시스템
 WaterLog_t water_log;
+WLFlash_t water_log_store; // 플래시 섹터 6/7 (재부팅 후에도 유지)
 
-// ⭐ HAL_Delay 대체용 타이머
-uint32_t buzzer_off_time = 0;
+// ⭐ 바이너리 텔레메트리 (printf 텍스트와 같은 UART 링, 프레임 단위로만 기록)
+static uint16_t Uart_TxRoom(void) {
+  UART_TxStats_t tx;
+  UART_GetTxStats(&tx);
+  return UART_TX_RING_SIZE - tx.depth;
+}
+
+static const Tlm_Port_t tlm_uart = {Uart_TxRoom, UART_TxWrite};
+Tlm_t telemetry;
+
+// ⭐ USART2 사용 방식 (UART_PROTO_*, modbus_map.h)
+volatile uint8_t uart_proto = UART_PROTO_CONSOLE;
+History_t history;         // ⭐ 추세 (1초 / 1분 / 1시간)
+SStore_t sample_store;     // ⭐ 1초 샘플 압축 저장 (시각으로 조회)
+
+// ⭐ HAL_Delay 대체용 타이머 (메시지/부저는 toast.c)
 uint32_t led_off_time = 0;
-uint32_t message_clear_time = 0;
-uint8_t auto_return_mode = 0; // 자동 복귀할 모드 (0=없음)
 
 typedef enum {
   JOY_NONE = 0,
@@ -90,8 +128,8 @@ uint8_t Is_Joy_Button_Clicked(void) {
 }
 
 JoyDirection_t Get_Joy_Direction(void) {
-  uint16_t vrx = adc_values[0];
-  uint16_t vry = adc_values[2];
+  uint16_t vrx = adc_frame.raw[ADC_CH_JOY_X];
+  uint16_t vry = adc_frame.raw[ADC_CH_JOY_Y];
 
 #define THRESHOLD_UP 2000
 #define THRESHOLD_DOWN 3150
@@ -110,49 +148,69 @@ JoyDirection_t Get_Joy_Direction(void) {
   return JOY_NONE;
 }
 
-// ========== 서보모터 제어 ==========
-void Servo_Set_Angle(uint8_t servo_num, uint8_t angle) {
-  uint16_t pulse = 1000 + (angle * 1000 / 90);
-
-  if (servo_num == 1) {
-    __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, pulse);
-    printf("[SERVO1] Angle: %d deg (Pulse: %u)\r\n", angle, pulse);
-  } else if (servo_num == 2) {
-    __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_2, pulse);
-    printf("[SERVO2] Angle: %d deg (Pulse: %u)\r\n", angle, pulse);
-  }
-}
-
 // ========== 자동 제어 로직 ==========
-void Dam_Auto_Control(uint8_t water_level) {
+// ⭐ 게이트는 바뀔 때만 움직이고, 로그도 상태가 바뀔 때만 출력
+void Dam_Auto_Control(WaterState_t state) {
+  static WaterState_t last_state = (WaterState_t)0xFF;
+
   if (!dam_auto_mode)
     return;
 
-  if (water_level < threshold_low) {
-    Servo_Set_Angle(1, 90);
-    Servo_Set_Angle(2, 0);
-    printf("[AUTO] LOW: Servo1=90, Servo2=0\r\n");
-  } else if (water_level > threshold_high) {
-    Servo_Set_Angle(1, 0);
-    Servo_Set_Angle(2, 90);
-    printf("[AUTO] HIGH: Servo1=0, Servo2=90\r\n");
+  // ⭐ 새 상태에 대한 첫 결정 → 이어지는 CCR 기록까지 지연 측정
+  if (state != last_state)
+    LAT_DECIDE();
+
+  if (state == WATER_ST_LOW) {
+    Gate_Set(GATE_1, GATE_ANGLE_OPEN);
+    Gate_Set(GATE_2, GATE_ANGLE_CLOSED);
+  } else if (state == WATER_ST_HIGH) {
+    Gate_Set(GATE_1, GATE_ANGLE_CLOSED);
+    Gate_Set(GATE_2, GATE_ANGLE_OPEN);
   } else {
-    Servo_Set_Angle(1, 0);
-    Servo_Set_Angle(2, 0);
-    printf("[AUTO] NORMAL: Both closed\r\n");
+    Gate_Set(GATE_1, GATE_ANGLE_CLOSED);
+    Gate_Set(GATE_2, GATE_ANGLE_CLOSED);
+  }
+  LAT_DECIDE_END();
+
+  if (state != last_state) {
+    last_state = state;
+    if (state == WATER_ST_LOW) {
+      printf("[AUTO] LOW: Servo1=90, Servo2=0\r\n");
+    } else if (state == WATER_ST_HIGH) {
+      printf("[AUTO] HIGH: Servo1=0, Servo2=90\r\n");
+    } else {
+      printf("[AUTO] NORMAL: Both closed\r\n");
+    }
   }
 }
 
-// ========== LCD 커서 표시 ==========
-void LCD_Print_With_Cursor(uint8_t line, uint8_t is_selected,
-                           const char *text) {
-  LCD_SetCursor(line, 0);
-  if (is_selected) {
-    LCD_Print("[V] ");
-  } else {
-    LCD_Print("[ ] ");
+// ========== RTC ==========
+// 백업 도메인(VBAT)에 표식이 있으면 달력이 계속 돌고 있던 것 → 그대로 사용
+// 표식이 없을 때(첫 전원, 백업 전지 방전)만 기본 시각으로 설정
+#define RTC_BKP_MARK_REG RTC_BKP_DR1
+#define RTC_BKP_MARK 0x32F2u
+
+static void RTC_Restore(void) {
+  if (HAL_RTCEx_BKUPRead(&hrtc, RTC_BKP_MARK_REG) == RTC_BKP_MARK) {
+    // GetTime 다음 GetDate (섀도 레지스터 잠금 해제 순서)
+    HAL_RTC_GetTime(&hrtc, &global_time, RTC_FORMAT_BIN);
+    HAL_RTC_GetDate(&hrtc, &global_date, RTC_FORMAT_BIN);
+    printf("[RTC] kept 20%02u-%02u-%02u %02u:%02u:%02u\r\n",
+           global_date.Year, global_date.Month, global_date.Date,
+           global_time.Hours, global_time.Minutes, global_time.Seconds);
+    return;
   }
-  LCD_Print((char *)text);
+
+  global_date.Year = 26;
+  global_date.Month = 1;
+  global_date.Date = 28;
+  global_time.Hours = 10;
+  global_time.Minutes = 0;
+  global_time.Seconds = 0;
+  HAL_RTC_SetTime(&hrtc, &global_time, RTC_FORMAT_BIN);
+  HAL_RTC_SetDate(&hrtc, &global_date, RTC_FORMAT_BIN);
+  HAL_RTCEx_BKUPWrite(&hrtc, RTC_BKP_MARK_REG, RTC_BKP_MARK);
+  printf("[RTC] not set, default time\r\n");
 }
 
 // ========== 초기화 ==========
@@ -162,12 +220,45 @@ void apInit(void) {
   printf("  - Log System + Non-blocking\r\n");
   printf("===========================================\r\n");
 
-  if (HAL_ADC_Start_DMA(&hadc1, (uint32_t *)adc_values, 4) != HAL_OK) {
+  PROF_INIT(); // ⭐ DWT 사이클 카운터 (PROF_ENABLE 0 이면 없음)
+
+  // ⭐ 오버샘플링 + 데시메이션 ADC 파이프라인 (adc.c)
+  if (ADC_Pipeline_Start() != HAL_OK) {
     Error_Handler();
   }
 
+  // ⭐ 수위 필터: 중앙값(스파이크) → IIR → 이동평균
+  //    프레임 약 83Hz 기준 각 단계 지연 약 0.1초
+  WLF_Init(&level_filter);
+  WLF_AddStage(&level_filter, WLF_STAGE_MEDIAN, 5);
+  WLF_AddStage(&level_filter, WLF_STAGE_IIR, 3); // alpha = 1/8
+  WLF_AddStage(&level_filter, WLF_STAGE_MOVAVG, 8);
+  WaterCls_Init(&level_cls, WATER_CLS_DEFAULT_HYST, WATER_CLS_DEFAULT_DWELL_MS);
+
+  // ⭐ 시계를 먼저 (플래시 로그를 되살린 뒤 바로 현재 시각과 비교하므로)
+  RTC_Restore();
+
   // ⭐ 로그 초기화
   WaterLog_Init(&water_log);
+  if (WLFlash_Mount(&water_log_store, &flash_if_stm32)) {
+    WaterLog_AttachStore(&water_log, &water_log_store);
+    printf("[LOG] Flash: %lu records (seq %lu, %lu slot reads)\r\n",
+           (unsigned long)WLFlash_Count(&water_log_store),
+           (unsigned long)water_log_store.seq,
+           (unsigned long)water_log_store.mount_reads);
+  } else {
+    printf("[LOG] Flash mount failed, RAM only\r\n");
+  }
+
+  // ⭐ 추세 기록
+  History_Init(&history);
+  SStore_Init(&sample_store);
+  printf("[HIST] %u s raw, %u min, %u h rollups: %lu bytes\r\n",
+         (unsigned)HIST_RAW_LEN, (unsigned)HIST_MIN_LEN,
+         (unsigned)HIST_HOUR_LEN, (unsigned long)History_MemoryBytes());
+
+  // ⭐ 텔레메트리
+  Tlm_Init(&telemetry, &tlm_uart);
 
   // ⭐ 로그인 상태 초기화
   is_logged_in = 0;
@@ -200,22 +291,12 @@ void apInit(void) {
   HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);
   HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_2);
 
-  Servo_Set_Angle(1, 0);
-  Servo_Set_Angle(2, 0);
+  Gate_Init(); // ⭐ 두 수문 닫힘
 
   LCD_Init();
   DHT11_Init();
   Keypad_Init();
 
-  global_date.Year = 26;
-  global_date.Month = 1;
-  global_date.Date = 28;
-  global_time.Hours = 10;
-  global_time.Minutes = 0;
-  global_time.Seconds = 0;
-  HAL_RTC_SetTime(&hrtc, &global_time, RTC_FORMAT_BIN);
-  HAL_RTC_SetDate(&hrtc, &global_date, RTC_FORMAT_BIN);
-
   // ⭐ 비밀번호 잠금 초기화
   pw_fail_count = 0;
   pw_locked = 0;
@@ -223,43 +304,47 @@ void apInit(void) {
 
   printf("System Ready!\r\n");
 
-  LCD_Clear();
-  LCD_SetCursor(0, 0);
-  LCD_Print("Dam System Ready");
-  LCD_SetCursor(1, 0);
-  LCD_Print("Enter Password");
-
-  message_clear_time = HAL_GetTick() + 2000;
-  auto_return_mode = 1;
+  Toast_Show("Dam System Ready", "Enter Password", 2000, TOAST_PRIO_INFO,
+             TOAST_BEEP_NONE);
 }
 
-// ========== 백그라운드 ==========
-void Update_Background_Tasks(void) {
-  uint32_t now = HAL_GetTick();
-
-  // DHT11 읽기
-  if (now - last_dht11_time >= 2000) {
-    last_dht11_time = now;
-    dht11_valid = DHT11_Read(&global_dht11_data);
+// ========== 태스크 ==========
+static int8_t task_dht_start = -1;
+
+// ⭐ 수위: 새 ADC 프레임일 때만 필터 갱신 → 이후 모든 곳은 water_level 사용
+static void Task_Level(void) {
+  ADC_GetFrame(&adc_frame);
+
+  if (adc_frame.seq != level_seq) {
+    level_seq = adc_frame.seq;
+    water_level_hires =
+        WLF_Process(&level_filter, adc_frame.hires[ADC_CH_LEVEL]);
+    water_level = ((uint32_t)water_level_hires * 100) / ADC_HIRES_MAX;
+    WaterState_t prev_state = water_state;
+    water_state = WaterCls_Update(&level_cls, water_level, threshold_low,
+                                  threshold_high, HAL_GetTick());
+    if (water_state != prev_state)
+      LAT_CROSS(adc_frame.stamp); // ⭐ 이 프레임이 상태를 바꿈
+
+    // 내부 온도: V25 = 0.76V, 2.5mV/°C → (mV - 760) * 4 + 250 (0.1°C)
+    int32_t mv = ((int32_t)adc_frame.raw[ADC_CH_TEMP] * 3300) / 4095;
+    sys_temp_x10 = (int16_t)((mv - 760) * 4 + 250);
   }
+}
 
-  // RTC 업데이트
-  if (now - last_rtc_time >= 1000) {
-    last_rtc_time = now;
-    HAL_RTC_GetTime(&hrtc, &global_time, RTC_FORMAT_BIN);
-    HAL_RTC_GetDate(&hrtc, &global_date, RTC_FORMAT_BIN);
-  }
+// ⭐ RGB LED 상태 표시 + 자동 수문 제어
+#define CONTROL_PERIOD_MS 50
 
-  // ⭐ RGB LED 상시 동작 (로그인 후에만!)
-  if (is_logged_in) {
-    uint8_t water_level = (adc_values[1] * 100) / 4095;
+static void Task_Control(void) {
+  LAT_CONTROL_TICK(adc_frame.stamp, CONTROL_PERIOD_MS);
 
-    if (water_level < threshold_low) {
+  if (is_logged_in) {
+    if (water_state == WATER_ST_LOW) {
       // LOW: 빨강
       HAL_GPIO_WritePin(RGB_R_GPIO_Port, RGB_R_Pin, GPIO_PIN_SET);
       HAL_GPIO_WritePin(RGB_G_GPIO_Port, RGB_G_Pin, GPIO_PIN_RESET);
       HAL_GPIO_WritePin(RGB_B_GPIO_Port, RGB_B_Pin, GPIO_PIN_RESET);
-    } else if (water_level > threshold_high) {
+    } else if (water_state == WATER_ST_HIGH) {
       // HIGH: 파랑
       HAL_GPIO_WritePin(RGB_R_GPIO_Port, RGB_R_Pin, GPIO_PIN_RESET);
       HAL_GPIO_WritePin(RGB_G_GPIO_Port, RGB_G_Pin, GPIO_PIN_RESET);
@@ -277,885 +362,1377 @@ void Update_Background_Tasks(void) {
     HAL_GPIO_WritePin(RGB_B_GPIO_Port, RGB_B_Pin, GPIO_PIN_RESET);
   }
 
-  // ⭐ 로그 업데이트 (로그인 후에만!)
+  // 자동 모드 실행
+  if (dam_auto_mode) {
+    Dam_Auto_Control(water_state);
+  }
+}
+
+// ⭐ 1초 기록: 추세는 항상, 이벤트 로그는 로그인 후에만!
+static void Task_Log(void) {
+  HistSample_t sample;
+  sample.level = water_level;
+  sample.humidity =
+      dht11_valid ? global_dht11_data.humidity : HIST_ENV_INVALID;
+  sample.temp_x10 = global_dht11_data.temperature * 10 +
+                    global_dht11_data.temperature_dec;
+  uint32_t epoch = WaterLog_ToEpoch(&global_time, &global_date);
+  History_AddSample(&history, epoch, &sample);
+  SStore_Append(&sample_store, epoch, &sample);
+
   if (is_logged_in) {
-    static uint32_t last_log_time = 0;
-    if (now - last_log_time >= 1000) {
-      last_log_time = now;
-      uint8_t water_level = (adc_values[1] * 100) / 4095;
-      WaterLog_Update(&water_log, water_level, threshold_low, threshold_high,
-                      &global_time, &global_date);
+    WaterLog_Update(&water_log, water_state, water_level, &global_time,
+                    &global_date);
+  }
+}
+
+// ⭐ 로그 섹터 미리 지우기: 수위 정상일 때만 (1~2초 멈춤을 이벤트 중에 안 겪게)
+static void Task_FlashService(void) {
+  if (water_log.store != NULL && water_state == WATER_ST_OK &&
+      WLFlash_Service(&water_log_store)) {
+    printf("[LOG] spare sector erased (%lu records kept)\r\n",
+           (unsigned long)WLFlash_Count(&water_log_store));
+  }
+}
+
+// ⭐ 텔레메트리 (FR-04): 1초 샘플, 이벤트 시작/종료, 10초마다 상태
+#define TLM_STATUS_EVERY 10
+
+static void Task_Telemetry(void) {
+  static uint32_t ev_start = 0;
+  static uint8_t ev_ended = 0;
+  static uint8_t status_div = 0;
+
+  if (uart_proto != UART_PROTO_CONSOLE)
+    return; // Modbus RTU 중에는 UART를 비워둠
+
+  Tlm_Sample_t s;
+  s.epoch = WaterLog_ToEpoch(&global_time, &global_date);
+  s.level_hires = water_level_hires;
+  s.level = water_level;
+  s.state = water_state;
+  s.temp_x10 = global_dht11_data.temperature * 10 +
+               global_dht11_data.temperature_dec;
+  s.humidity = dht11_valid ? global_dht11_data.humidity : 0xFF;
+  Tlm_SendSample(&telemetry, &s);
+
+  // 가장 최근 이벤트가 새로 생기거나 끝났을 때만
+  uint16_t n = WaterLog_Count(&water_log);
+  WaterEvent_t ev;
+  if (n > 0 && WaterLog_GetByViewIndex(&water_log, n - 1, &ev) &&
+      (ev.start_epoch != ev_start || ev.ended != ev_ended)) {
+    Tlm_Event_t e;
+    e.start = ev.start_epoch;
+    e.duration_s = ev.duration_s;
+    e.integral = ev.integral;
+    e.state = ev.state;
+    e.level = ev.level_percent;
+    e.peak = ev.peak_percent;
+    e.trough = ev.trough_percent;
+    e.mean = ev.mean_percent;
+    e.ended = ev.ended;
+    if (Tlm_SendEvent(&telemetry, &e)) {
+      ev_start = ev.start_epoch;
+      ev_ended = ev.ended;
     }
   }
 
-  // 자동 모드 실행
-  if (dam_auto_mode) {
-    uint8_t water_level = (adc_values[1] * 100) / 4095;
-    Dam_Auto_Control(water_level);
+  if (++status_div >= TLM_STATUS_EVERY) {
+    status_div = 0;
+    UART_TxStats_t tx;
+    UART_GetTxStats(&tx);
+
+    Tlm_Status_t st;
+    st.uptime_ms = HAL_GetTick();
+    st.uart_dropped = tx.dropped;
+    st.tlm_dropped = telemetry.dropped;
+    st.log_count = n;
+    st.th_low = threshold_low;
+    st.th_high = threshold_high;
+    st.auto_mode = dam_auto_mode;
+    st.gate_mask = (Gate_IsOpen(GATE_1) ? 0x01 : 0) |
+                   (Gate_IsOpen(GATE_2) ? 0x02 : 0);
+    st.state = water_state;
+    Tlm_SendStatus(&telemetry, &st);
   }
+}
 
-  // ⭐ 부저 자동 OFF
-  if (buzzer_off_time > 0 && now >= buzzer_off_time) {
-    HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_RESET);
-    buzzer_off_time = 0;
+// DHT11 (⭐ 시작만 하고 결과는 완료되면 수거, 대기 없음)
+static void Task_DHT11(void) {
+  DHT11_Process();
+  DHT11_Status_t dht_st = DHT11_Collect(&global_dht11_data);
+  if (dht_st == DHT11_DONE_OK) {
+    dht11_valid = 1;
+  } else if (dht_st == DHT11_DONE_ERROR) {
+    // ⭐ NFR-02: 실패 시 직전 정상값 유지, 오래되면 오류 표시
+    uint32_t age = 0;
+    dht11_valid = DHT11_GetLastGood(&global_dht11_data, &age) &&
+                  age < DHT11_STALE_MS;
+    Sched_Delay(task_dht_start, 1000); // 1초 뒤 재시도 (DHT11 최소 간격 1초)
   }
+}
+
+static void Task_DHT11_Start(void) { DHT11_Start(); }
+
+// ⭐ 로그 CSV 내보내기: UART 링에 여유가 있을 때 몇 줄씩만 (제어 태스크 지연 방지)
+#define EXPORT_LINES_PER_RUN 4
+#define EXPORT_MIN_FREE 256
+
+static uint16_t export_pos = WATERLOG_NONE; // NONE = 내보내기 중 아님
+static WaterLog_Range_t export_range = WATERLOG_RANGE_ALL;
+
+static void Task_Export(void) {
+  if (export_pos == WATERLOG_NONE)
+    return;
+
+  if (Uart_TxRoom() < EXPORT_MIN_FREE)
+    return;
+
+  if (export_pos < WaterLog_Count(&water_log))
+    export_pos = WaterLog_ExportCSV(&water_log, export_pos,
+                                    EXPORT_LINES_PER_RUN, &export_range);
+  if (export_pos >= WaterLog_Count(&water_log)) // to 를 지났거나 끝
+    export_pos = WATERLOG_NONE;
+}
+
+// RTC 업데이트
+static void Task_RTC(void) {
+  HAL_RTC_GetTime(&hrtc, &global_time, RTC_FORMAT_BIN);
+  HAL_RTC_GetDate(&hrtc, &global_date, RTC_FORMAT_BIN);
+}
+
+// ⭐ 부저 패턴 / LED / 메시지 자동 OFF
+static void Task_Timers(void) {
+  uint32_t now = HAL_GetTick();
+
+  Toast_Tick(now);
 
-  // ⭐ LED 자동 OFF
-  if (led_off_time > 0 && now >= led_off_time) {
+  if (led_off_time > 0 && SCHED_EXPIRED(now, led_off_time)) {
     HAL_GPIO_WritePin(LED_RED_GPIO_Port, LED_RED_Pin, GPIO_PIN_RESET);
     HAL_GPIO_WritePin(LED_GREEN_GPIO_Port, LED_GREEN_Pin, GPIO_PIN_RESET);
     led_off_time = 0;
   }
+}
 
-  // ⭐ 메시지 자동 Clear
-  if (message_clear_time > 0 && now >= message_clear_time) {
-    message_clear_time = 0;
-    if (auto_return_mode) {
-      LCD_Clear();
-      auto_return_mode = 0;
-    }
+// ========== Modbus RTU 슬레이브 ==========
+// 콘솔 'modbus' 명령으로 전환, holding 5 에 0 을 쓰면 콘솔로 복귀
+// 프레임 끝은 TIM2 1ms 틱에서 수신 DMA 위치로 감지 (3.5문자 간격)
+// Task_Modbus 는 이 모드에서만 켬 (콘솔 중 1ms 마다 깨우지 않게)
+static MB_Slave_t modbus;
+static MB_FrameTimer_t mb_timer;
+static int8_t task_modbus = -1;
+
+static void Modbus_Enter(void) {
+  uint8_t drain[32];
+
+  MB_MapInit(&modbus); // 표는 modbus_map.c
+
+  export_pos = WATERLOG_NONE;
+  while (UART_RxRead(drain, sizeof(drain)) > 0) {
   }
+  MB_TimerReset(&mb_timer, UART_RxDmaPos());
+  UART_SetTextMute(1); // printf 는 여기서부터 버림
+  uart_proto = UART_PROTO_MODBUS;
+  Sched_Enable(task_modbus, 1);
 }
 
-// ========== 메인 루프 ==========
-void apMain(void) {
-  char buffer[32];
-  LCD_Clear();
+static void Modbus_Exit(void) {
+  Sched_Enable(task_modbus, 0);
+  uart_proto = UART_PROTO_CONSOLE;
+  UART_SetTextMute(0);
+  printf("[MODBUS] back to console (%lu frames, %lu crc err)\r\n",
+         (unsigned long)modbus.frames, (unsigned long)modbus.crc_errors);
+}
 
-  while (1) {
-    Update_Background_Tasks();
+void Modbus_TickISR(void) {
+  if (uart_proto == UART_PROTO_MODBUS)
+    MB_TimerTick(&mb_timer, UART_RxDmaPos());
+}
 
-    char key = Keypad_Read();
-    if (key != 0) {
-      printf("[KEY] %c\r\n", key);
-    }
+static void Task_Modbus(void) {
+  static uint8_t req[MB_ADU_MAX];
+  static uint8_t resp[MB_ADU_MAX];
 
-    switch (current_mode) {
+  if (uart_proto != UART_PROTO_MODBUS || !mb_timer.frame_ready)
+    return;
+  mb_timer.frame_ready = 0;
 
-    case MODE_PASSWORD_INPUT: {
-      // ⭐ 잠금 상태 체크
-      if (pw_locked) {
-        uint32_t now = HAL_GetTick();
-        if (now - pw_lock_start_time >= PW_LOCK_TIME) {
-          // 잠금 해제
-          pw_locked = 0;
-          pw_fail_count = 0;
+  // idle 이벤트가 이미 head 를 옮겨 놓았으므로 프레임 전체가 읽힘
+  uint16_t len = UART_RxRead(req, sizeof(req));
+  MB_MapRefresh();
+  uint16_t n = MB_Process(&modbus, req, len, resp);
+  if (n > 0)
+    UART_TxWrite(resp, n);
 
-          LCD_SetCursor(0, 0);
-          LCD_Print("Lock Released   ");
-          LCD_SetCursor(1, 0);
-          LCD_Print("Enter Password  ");
+  if (MB_MapTakeExit())
+    Modbus_Exit();
+}
 
-          message_clear_time = HAL_GetTick() + 1500;
-          auto_return_mode = 1;
+// ========== UART 콘솔 ==========
+// 키패드/LCD 메뉴와 나란히 동작 (같은 전역 값을 바꾸므로 메인 루프에서만 실행)
+// 설정을 바꾸는 명령은 키패드에서 로그인한 뒤에만 허용
+#define CONSOLE_RX_CHUNK 32
+#define CONSOLE_RX_MAX_PER_RUN 128 // 한 번에 처리할 최대 바이트 (제어 지연 방지)
+
+static Console_t console;
+
+static uint8_t Console_ParseU8(const char *s, uint8_t max, uint8_t *out) {
+  char *end;
+  unsigned long v = strtoul(s, &end, 10);
+  if (*s == '\0' || *end != '\0' || v > max)
+    return 0;
+  *out = (uint8_t)v;
+  return 1;
+}
 
-        } else {
-          // 잠금 중
-          uint32_t remain = (PW_LOCK_TIME - (now - pw_lock_start_time)) / 1000;
-
-          LCD_SetCursor(0, 0);
-          LCD_Print("LOCKED!         ");
-          LCD_SetCursor(1, 0);
-          sprintf(buffer, "Wait %2lus      ", remain);
-          LCD_Print(buffer);
-        }
-        break;
-      }
+static uint8_t Console_ParseU32(const char *s, uint32_t *out) {
+  char *end;
+  unsigned long long v = strtoull(s, &end, 10);
+  if (*s == '\0' || *end != '\0' || v > UINT32_MAX)
+    return 0;
+  *out = (uint32_t)v;
+  return 1;
+}
 
-      // ⭐ 정상 비밀번호 입력 화면
-      LCD_SetCursor(0, 0);
-      LCD_Print("Enter Password: ");
+static uint8_t Console_CheckLogin(void) {
+  if (!is_logged_in) {
+    printf("ERR login required\r\n");
+    return 0;
+  }
+  return 1;
+}
 
-      LCD_SetCursor(1, 0);
-      for (int i = 0; i < 4; i++) {
-        LCD_Print((i < pw_idx) ? "*" : "_");
-      }
-      LCD_Print("            ");
+static const char *State_Str(WaterState_t st) {
+  return (st == WATER_ST_LOW) ? "LOW" : (st == WATER_ST_HIGH) ? "HIGH" : "OK";
+}
 
-      if (key >= '0' && key <= '9' && pw_idx < 4) {
-        input_pw[pw_idx++] = key;
+static void Cmd_Help(uint8_t argc, char **argv) {
+  (void)argc;
+  (void)argv;
+  Console_PrintHelp(&console);
+}
 
-      } else if (key == '*') {
-        pw_idx = 0;
-        memset(input_pw, 0, sizeof(input_pw));
+static void Cmd_Status(uint8_t argc, char **argv) {
+  (void)argc;
+  (void)argv;
+  printf("level %u%% (%u) %s\r\n", water_level, water_level_hires,
+         State_Str(water_state));
+  printf("th low %u high %u, auto %s\r\n", threshold_low, threshold_high,
+         dam_auto_mode ? "on" : "off");
+  printf("gate1 %u deg, gate2 %u deg\r\n", Gate_GetAngle(GATE_1),
+         Gate_GetAngle(GATE_2));
+  for (uint8_t g = 0; g < GATE_COUNT; g++) {
+    Gate_Stats_t gs; // 마모 추적
+    Gate_GetStats((Gate_t)g, &gs);
+    printf("gate%u moves %lu, open %lu s\r\n", g + 1,
+           (unsigned long)gs.moves, (unsigned long)(gs.open_ms / 1000));
+  }
+  if (dht11_valid) {
+    printf("temp %d.%d C, humi %u%%\r\n", global_dht11_data.temperature,
+           global_dht11_data.temperature_dec, global_dht11_data.humidity);
+  } else {
+    printf("temp/humi n/a\r\n");
+  }
+  printf("log %u events, login %u, mode %u\r\n", WaterLog_Count(&water_log),
+         is_logged_in, (unsigned)current_mode);
+}
 
-      } else if ((key == '#' || Is_Joy_Button_Clicked()) && pw_idx == 4) {
-        input_pw[4] = '\0';
+static void Cmd_Threshold(uint8_t argc, char **argv) {
+  uint8_t low, high;
 
-        if (strcmp(input_pw, target_pw) == 0) {
-          // ⭐ 성공
-          pw_fail_count = 0;
-          is_logged_in = 1; // ⭐ 로그인 상태 ON
+  if (argc == 1) {
+    printf("th low %u high %u\r\n", threshold_low, threshold_high);
+    return;
+  }
+  // 키패드 입력과 같은 범위 (0-50, low < high)
+  if (argc != 3 || !Console_ParseU8(argv[1], 50, &low) ||
+      !Console_ParseU8(argv[2], 50, &high) || low >= high) {
+    printf("ERR th <low> <high>  (0-50, low < high)\r\n");
+    return;
+  }
+  if (!Console_CheckLogin())
+    return;
 
-          HAL_GPIO_WritePin(LED_GREEN_GPIO_Port, LED_GREEN_Pin, GPIO_PIN_SET);
-          led_off_time = HAL_GetTick() + 1000;
+  threshold_low = low;
+  threshold_high = high;
+  printf("[THRESHOLD] Low %u, High %u (console)\r\n", low, high);
+}
 
-          LCD_SetCursor(1, 0);
-          LCD_Print("CORRECT!        ");
+static void Cmd_Auto(uint8_t argc, char **argv) {
+  if (argc == 1) {
+    printf("auto %s\r\n", dam_auto_mode ? "on" : "off");
+    return;
+  }
+  if (argc != 2 || (strcmp(argv[1], "on") && strcmp(argv[1], "off"))) {
+    printf("ERR auto on|off\r\n");
+    return;
+  }
+  if (!Console_CheckLogin())
+    return;
 
-          printf("[LOGIN] Success! RGB LED Enabled.\r\n"); // ⭐ 디버그
+  dam_auto_mode = (strcmp(argv[1], "on") == 0);
+  printf("[AUTO] Mode: %s (console)\r\n", dam_auto_mode ? "ON" : "OFF");
+}
 
-          current_mode = MODE_MENU_SELECT;
-          menu_selected = 0;
-          pw_idx = 0;
-          memset(input_pw, 0, sizeof(input_pw));
+static void Cmd_Gate(uint8_t argc, char **argv) {
+  uint8_t n;
 
-          message_clear_time = HAL_GetTick() + 1000;
-          auto_return_mode = 1;
+  if (argc != 3 || !Console_ParseU8(argv[1], 2, &n) || n == 0 ||
+      (strcmp(argv[2], "open") && strcmp(argv[2], "close"))) {
+    printf("ERR gate <1|2> open|close\r\n");
+    return;
+  }
+  if (!Console_CheckLogin())
+    return;
+  if (dam_auto_mode) {
+    // 자동 제어가 다음 주기에 되돌리므로 거부
+    printf("ERR auto mode on\r\n");
+    return;
+  }
 
-        } else {
-          // ⭐ 실패
-          pw_fail_count++;
-          printf("[PW] FAIL! Count=%d\r\n", pw_fail_count);
+  Gate_Set((Gate_t)(n - 1), (strcmp(argv[2], "open") == 0)
+                                ? GATE_ANGLE_OPEN
+                                : GATE_ANGLE_CLOSED);
+  printf("gate%u %u deg\r\n", n, Gate_GetAngle((Gate_t)(n - 1)));
+}
 
-          HAL_GPIO_WritePin(LED_RED_GPIO_Port, LED_RED_Pin, GPIO_PIN_SET);
-          HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_SET);
+static void Cmd_Log(uint8_t argc, char **argv) {
+  if (argc == 2 && strcmp(argv[1], "stop") == 0) {
+    export_pos = WATERLOG_NONE;
+    printf("log export stopped\r\n");
+    return;
+  }
 
-          buzzer_off_time = HAL_GetTick() + 500;
-          led_off_time = HAL_GetTick() + 1000;
+  // log [low|high] [<from_epoch> [<to_epoch>]]  (시작 시각 from 이상 to 미만)
+  WaterLog_Range_t range = WATERLOG_RANGE_ALL;
+  uint8_t a = 1;
+  if (a < argc && strcmp(argv[a], "low") == 0) {
+    range.filter = WATERLOG_F_LOW;
+    a++;
+  } else if (a < argc && strcmp(argv[a], "high") == 0) {
+    range.filter = WATERLOG_F_HIGH;
+    a++;
+  }
+  uint8_t ok = 1;
+  if (a < argc)
+    ok = Console_ParseU32(argv[a++], &range.from);
+  if (ok && a < argc)
+    ok = Console_ParseU32(argv[a++], &range.to);
+  if (!ok || a < argc || range.from >= range.to) {
+    printf("ERR log [low|high] [<from_epoch> [<to_epoch>]] | log stop\r\n");
+    return;
+  }
+  if (export_pos != WATERLOG_NONE) {
+    printf("ERR export busy\r\n");
+    return;
+  }
+  // MODE_LOG 의 '#' 과 같은 경로 (Task_Export 가 나눠서 출력)
+  // 시작 view 는 이진 탐색, 끝은 ExportCSV 가 to 를 만나면
+  WaterLog_ExportHeader();
+  export_range = range;
+  export_pos = WaterLog_FindFirstAtOrAfter(&water_log, range.from);
+}
 
-          LCD_SetCursor(1, 0);
+static void Cmd_Perf(uint8_t argc, char **argv) {
+#if PROF_ENABLE
+  // ⭐ 구간 표/히스토그램은 따로 (TX 링 1KB 를 한 번에 넘지 않게)
+  if (argc >= 2 && strcmp(argv[1], "zones") == 0) {
+    Prof_PrintTable();
+    return;
+  }
+  if (argc >= 3 && strcmp(argv[1], "hist") == 0) {
+    uint8_t z = Prof_Find(argv[2]);
+    if (z == PROF_ZONE_COUNT)
+      printf("ERR no zone %s\r\n", argv[2]);
+    else
+      Prof_PrintHist(z);
+    return;
+  }
+  if (argc >= 2 && strcmp(argv[1], "lat") == 0) {
+    Lat_Print();
+    return;
+  }
+  if (argc >= 2 && strcmp(argv[1], "reset") == 0) {
+    Prof_Reset();
+    Lat_Reset();
+    printf("OK\r\n");
+    return;
+  }
+#endif
+  if (argc >= 2) {
+    printf("ERR usage: perf [zones|hist <zone>|lat|reset]\r\n");
+    return;
+  }
+  printf("task     period runs       overruns max_late\r\n");
+  for (uint8_t i = 0; i < Sched_Count(); i++) {
+    const Sched_Task_t *t = Sched_Get(i);
+    printf("%-8s %6lu %-10lu %8lu %8lu%s\r\n", t->name,
+           (unsigned long)t->period_ms, (unsigned long)t->runs,
+           (unsigned long)t->overruns, (unsigned long)t->max_late_ms,
+           t->enabled ? "" : " off");
+  }
 
-          if (pw_fail_count >= PW_MAX_FAIL) {
-            pw_locked = 1;
-            pw_lock_start_time = HAL_GetTick();
+  UART_TxStats_t tx;
+  UART_RxStats_t rx;
+  UART_GetTxStats(&tx);
+  UART_GetRxStats(&rx);
+  printf("uart tx %lu drop %lu err %lu hw %u, rx %lu ovf %lu err %lu\r\n",
+         (unsigned long)tx.written, (unsigned long)tx.dropped,
+         (unsigned long)tx.errors, tx.high_water, (unsigned long)rx.received,
+         (unsigned long)rx.overflows, (unsigned long)rx.errors);
+  printf("tlm sent %lu drop %lu, console %lu cmds %lu err\r\n",
+         (unsigned long)telemetry.sent, (unsigned long)telemetry.dropped,
+         (unsigned long)console.lines, (unsigned long)console.errors);
+
+  LCD_TxStats_t lcd;
+  LCD_GetTxStats(&lcd);
+  printf("lcd txq depth %u hw %u ovf %lu err %lu, key evq ovf %lu\r\n",
+         lcd.depth, lcd.high_water, (unsigned long)lcd.overflow,
+         (unsigned long)lcd.errors,
+         (unsigned long)Keypad_GetOverflowCount());
+}
 
-            LCD_Print("Too Many Fails! ");
-            printf("[PW] SYSTEM LOCKED\r\n");
+// ========== 추세 조회 (History 링 / 압축 저장) ==========
+#define HIST_PRINT_MAX 20 // 한 번에 출력할 줄 (TX 링 1KB)
 
-            message_clear_time = HAL_GetTick() + 1500;
-            auto_return_mode = 1;
+static void Hist_PrintEnv(uint8_t hum, int16_t temp_x10) {
+  if (hum == HIST_ENV_INVALID)
+    printf(" T:-- H:--\r\n");
+  else
+    printf(" T:%d.%dC H:%u%%\r\n", temp_x10 / 10, temp_x10 % 10, hum);
+}
 
-          } else {
-            sprintf(buffer, "WRONG! (%d/%d)  ", pw_fail_count, PW_MAX_FAIL);
-            LCD_Print(buffer);
+static void Hist_PrintRollup(uint16_t age, const HistRollup_t *r) {
+  if (r->n == 0) {
+    printf("-%-4u (no data)\r\n", age + 1);
+    return;
+  }
+  printf("-%-4u L %u/%u/%u%%", age + 1, r->level_min, r->level_mean,
+         r->level_max);
+  Hist_PrintEnv(r->n_env ? r->hum_mean : HIST_ENV_INVALID, r->temp_mean);
+}
 
-            message_clear_time = HAL_GetTick() + 1000;
-            auto_return_mode = 0;
-          }
+static void Cmd_Hist(uint8_t argc, char **argv) {
+  uint8_t n = 10;
+
+  if (argc == 1) {
+    printf("raw %u s, min %u, hour %u, gaps %lu\r\n",
+           History_RawCount(&history), History_MinuteCount(&history),
+           History_HourCount(&history), (unsigned long)history.gaps);
+    uint32_t ratio = SStore_RatioX100(&sample_store);
+    printf("store %lu bytes, ratio %lu.%02lux\r\n",
+           (unsigned long)SStore_BytesUsed(&sample_store),
+           (unsigned long)(ratio / 100), (unsigned long)(ratio % 100));
+    return;
+  }
 
-          pw_idx = 0;
-          memset(input_pw, 0, sizeof(input_pw));
-        }
-      }
+  // hist at <hh:mm:ss>: 오늘 그 시각 이하 마지막 1초 샘플
+  if (strcmp(argv[1], "at") == 0) {
+    unsigned hh, mm, ss;
+    char tail;
+    if (argc != 3 ||
+        sscanf(argv[2], "%u:%u:%u%c", &hh, &mm, &ss, &tail) != 3 ||
+        hh > 23 || mm > 59 || ss > 59) {
+      printf("ERR hist at <hh:mm:ss>\r\n");
+      return;
+    }
+    RTC_TimeTypeDef t = global_time;
+    t.Hours = (uint8_t)hh;
+    t.Minutes = (uint8_t)mm;
+    t.Seconds = (uint8_t)ss;
+    uint32_t when;
+    HistSample_t smp;
+    if (!SStore_Find(&sample_store, WaterLog_ToEpoch(&t, &global_date), &when,
+                     &smp)) {
+      printf("ERR not stored\r\n");
+      return;
+    }
+    RTC_DateTypeDef d;
+    WaterLog_FromEpoch(when, &t, &d);
+    printf("%02u:%02u:%02u L %u%%", t.Hours, t.Minutes, t.Seconds,
+           smp.level);
+    Hist_PrintEnv(smp.humidity, smp.temp_x10);
+    return;
+  }
 
-      // ⭐ 메시지 자동 복귀
-      if (auto_return_mode && message_clear_time > 0 &&
-          HAL_GetTick() >= message_clear_time) {
-        LCD_SetCursor(1, 0);
-        LCD_Print("____            ");
-        message_clear_time = 0;
-        auto_return_mode = 0;
-      }
-      break;
+  if (argc > 3 || (argc == 3 && (!Console_ParseU8(argv[2], HIST_PRINT_MAX,
+                                                  &n) ||
+                                 n == 0))) {
+    printf("ERR hist [raw|min|hour [1-%u]|at <hh:mm:ss>]\r\n",
+           HIST_PRINT_MAX);
+    return;
+  }
+
+  // age 0 = 가장 최근, "-N" = N 초/분/시간 전
+  if (strcmp(argv[1], "raw") == 0) {
+    HistSample_t smp;
+    for (uint16_t age = 0; age < n && History_GetRaw(&history, age, &smp);
+         age++) {
+      printf("-%-4u L %u%%", age + 1, smp.level);
+      Hist_PrintEnv(smp.humidity, smp.temp_x10);
     }
+  } else if (strcmp(argv[1], "min") == 0) {
+    HistRollup_t r;
+    for (uint16_t age = 0; age < n && History_GetMinute(&history, age, &r);
+         age++)
+      Hist_PrintRollup(age, &r);
+  } else if (strcmp(argv[1], "hour") == 0) {
+    HistRollup_t r;
+    for (uint16_t age = 0; age < n && History_GetHour(&history, age, &r);
+         age++)
+      Hist_PrintRollup(age, &r);
+  } else {
+    printf("ERR hist [raw|min|hour [1-%u]|at <hh:mm:ss>]\r\n",
+           HIST_PRINT_MAX);
+  }
+}
 
-    case MODE_MENU_SELECT: {
-      const char *menu_items[] = {
-          "1.Water Status ",  "2.Dam Control   ", "3.Threshold Set ",
-          "4.Environment   ", "5.Clock         ", "6.Change PW     ",
-          "7.Event Log     " // ⭐ 추가
-      };
+static void Cmd_Modbus(uint8_t argc, char **argv) {
+  (void)argc;
+  (void)argv;
+  if (!Console_CheckLogin())
+    return;
+  printf("[MODBUS] RTU slave %u, 115200 8N1 (holding 5 = 0 to exit)\r\n",
+         MODBUS_SLAVE_ADDR);
+  Modbus_Enter();
+}
 
-      static JoyDirection_t last_dir = JOY_NONE;
-      static uint8_t menu_locked = 0;
+static const Console_Cmd_t console_cmds[] = {
+    {"help", "help", Cmd_Help},
+    {"status", "status", Cmd_Status},
+    {"th", "th [<low> <high>]", Cmd_Threshold},
+    {"auto", "auto [on|off]", Cmd_Auto},
+    {"gate", "gate <1|2> open|close", Cmd_Gate},
+    {"log", "log [low|high] [<from> [<to>]] | log stop  (CSV, epoch s)",
+     Cmd_Log},
+    {"perf", "perf [zones|hist <zone>|lat|reset]", Cmd_Perf},
+    {"hist", "hist [raw|min|hour [n]|at <hh:mm:ss>]", Cmd_Hist},
+    {"modbus", "modbus  (switch to RTU)", Cmd_Modbus},
+};
+
+static void Task_Console(void) {
+  uint8_t chunk[CONSOLE_RX_CHUNK];
+  uint16_t total = 0;
+  uint16_t n;
+
+  if (uart_proto != UART_PROTO_CONSOLE)
+    return;
 
-      JoyDirection_t dir = Get_Joy_Direction();
+  while (total < CONSOLE_RX_MAX_PER_RUN &&
+         (n = UART_RxRead(chunk, sizeof(chunk))) > 0) {
+    Console_Feed(&console, chunk, n);
+    total += n;
+  }
+}
 
-      if (dir == JOY_NONE) {
-        last_dir = JOY_NONE;
-        menu_locked = 0;
-      }
+// ========== 메뉴 표 ==========
+// 커서 이동/스크롤/그리기는 menu.c 한 곳에서, 여기는 항목과 동작만
+static Menu_State_t ui_menu;
 
-      if (dir != JOY_NONE && !menu_locked) {
-        if (dir == JOY_UP && last_dir != JOY_UP) {
-          menu_selected = (menu_selected + 1) % 7; // ⭐ 6 → 7
-          LCD_Clear();
-          menu_locked = 1;
-          // ⭐ HAL_Delay 제거
-        } else if (dir == JOY_DOWN && last_dir != JOY_DOWN) {
-          menu_selected =
-              (menu_selected == 0) ? 6 : menu_selected - 1; // ⭐ 5 → 6
-          LCD_Clear();
-          menu_locked = 1;
-        }
-        last_dir = dir;
-      }
+static void Ui_Goto(SystemMode_t mode, uint8_t cursor) {
+  current_mode = mode;
+  cursor_pos = cursor;
+  scroll_offset = 0;
+  Menu_Close(&ui_menu);
+  LCD_Clear();
+}
 
-      LCD_SetCursor(0, 0);
-      LCD_Print((char *)menu_items[menu_selected]);
-      LCD_SetCursor(1, 0);
-      LCD_Print("Click to Enter  ");
+// 조이스틱 X축은 바뀌는 순간에만, 버튼은 클릭으로
+static Menu_Input_t Ui_MenuInput(void) {
+  static JoyDirection_t last_dir = JOY_NONE;
+  JoyDirection_t dir = Get_Joy_Direction();
+  Menu_Input_t in = MENU_IN_NONE;
+
+  if (dir != last_dir) {
+    if (dir == JOY_RIGHT)
+      in = MENU_IN_NEXT;
+    else if (dir == JOY_LEFT)
+      in = MENU_IN_PREV;
+    last_dir = dir;
+  }
+  if (Is_Joy_Button_Clicked())
+    in = MENU_IN_SELECT;
+  return in;
+}
 
-      if (Is_Joy_Button_Clicked()) {
-        cursor_pos = 0;
-        scroll_offset = 0;
-        LCD_Clear();
+// --- 2. 댐 제어 모드 선택 ---
+static void Act_GotoManual(void) { Ui_Goto(MODE_DAM_MANUAL, 0); }
+static void Act_GotoAuto(void) { Ui_Goto(MODE_DAM_AUTO, 0); }
+static void Act_GotoMainMenu(void) { Ui_Goto(MODE_MENU_SELECT, 0); }
+
+static const Menu_Item_t dam_control_items[] = {
+    {"Passive Mode", NULL, NULL, Act_GotoManual},
+    {"Active Mode", NULL, NULL, Act_GotoAuto},
+    {"Back", NULL, NULL, Act_GotoMainMenu},
+};
+static const Menu_t menu_dam_control = {dam_control_items, 3};
+
+// --- 2-1. 수동 제어 ---
+static void Act_ToggleGate1(void) {
+  Gate_Set(GATE_1, Gate_IsOpen(GATE_1) ? GATE_ANGLE_CLOSED : GATE_ANGLE_OPEN);
+}
+static void Act_ToggleGate2(void) {
+  Gate_Set(GATE_2, Gate_IsOpen(GATE_2) ? GATE_ANGLE_CLOSED : GATE_ANGLE_OPEN);
+}
+static void Act_BackToDamControl(void) { Ui_Goto(MODE_DAM_CONTROL, 0); }
+
+static const Menu_Item_t dam_manual_items[] = {
+    {"Servo1 Ctrl", NULL, NULL, Act_ToggleGate1},
+    {"Servo2 Ctrl", NULL, NULL, Act_ToggleGate2},
+    {"Back", NULL, NULL, Act_BackToDamControl},
+};
+static const Menu_t menu_dam_manual = {dam_manual_items, 3};
+
+// --- 2-2. 자동 제어 ---
+static void Fmt_AutoAction(char *out, uint8_t size) {
+  snprintf(out, size, "%s", dam_auto_mode ? "Turn OFF" : "Turn ON");
+}
+static void Fmt_AutoState(char *out, uint8_t size) {
+  snprintf(out, size, "%s", dam_auto_mode ? "ON" : "OFF");
+}
+static void Act_ToggleAuto(void) {
+  dam_auto_mode = !dam_auto_mode;
+  printf("[AUTO] Mode: %s\r\n", dam_auto_mode ? "ON" : "OFF");
+}
 
-        switch (menu_selected) {
-        case 0:
-          current_mode = MODE_WATER_STATUS;
-          break;
-        case 1:
-          current_mode = MODE_DAM_CONTROL;
-          break;
-        case 2:
-          current_mode = MODE_THRESHOLD_SET;
-          break;
-        case 3:
-          current_mode = MODE_ENVIRONMENT;
-          break;
-        case 4:
-          current_mode = MODE_CLOCK;
-          break;
-        case 5:
-          current_mode = MODE_PW_CHANGE;
-          pw_idx = 0;
-          memset(input_pw, 0, sizeof(input_pw));
-          break;
-        case 6: // ⭐ 로그 화면
-          current_mode = MODE_LOG;
-          cursor_pos = 0;
-          break;
-        }
-      }
-      break;
-    }
+static const Menu_Item_t dam_auto_items[] = {
+    {NULL, &dam_auto_mode, Fmt_AutoAction, Act_ToggleAuto},
+    {"Now: ", &dam_auto_mode, Fmt_AutoState, NULL},
+    {"Back", NULL, NULL, Act_BackToDamControl},
+};
+static const Menu_t menu_dam_auto = {dam_auto_items, 3};
 
-      // ============ 1. 수위 상태 ============
-      // ============ 1. 수위 상태 ============
-    case MODE_WATER_STATUS: {
-      uint8_t water_level = (adc_values[1] * 100) / 4095;
+// --- 3. 기준치 변경 ---
+static void Fmt_ThresholdHigh(char *out, uint8_t size) {
+  snprintf(out, size, "%2d%%", threshold_high);
+}
+static void Fmt_ThresholdLow(char *out, uint8_t size) {
+  snprintf(out, size, "%2d%%", threshold_low);
+}
+static void Ui_ThresholdInput(uint8_t mode) {
+  threshold_input_mode = mode; // 0 = High, 1 = Low
+  threshold_input_idx = 0;
+  memset(threshold_input, 0, sizeof(threshold_input));
+  Ui_Goto(MODE_THRESHOLD_INPUT, mode);
+  printf("[THRESHOLD] Entering %s input mode\r\n", mode ? "Low" : "High");
+}
+static void Act_InputHigh(void) { Ui_ThresholdInput(0); }
+static void Act_InputLow(void) { Ui_ThresholdInput(1); }
+
+static const Menu_Item_t threshold_items[] = {
+    {"High:", &threshold_high, Fmt_ThresholdHigh, Act_InputHigh},
+    {"Low: ", &threshold_low, Fmt_ThresholdLow, Act_InputLow},
+    {"Back", NULL, NULL, Act_GotoMainMenu},
+};
+static const Menu_t menu_threshold = {threshold_items, 3};
+
+static const Menu_t *Ui_ModeMenu(SystemMode_t mode) {
+  switch (mode) {
+  case MODE_DAM_CONTROL:
+    return &menu_dam_control;
+  case MODE_DAM_MANUAL:
+    return &menu_dam_manual;
+  case MODE_DAM_AUTO:
+    return &menu_dam_auto;
+  case MODE_THRESHOLD_SET:
+    return &menu_threshold;
+  default:
+    return NULL;
+  }
+}
 
-      LCD_SetCursor(0, 0);
-      sprintf(buffer, "Water:%3d%% %02d:%02d", water_level, global_time.Hours,
-              global_time.Minutes);
-      LCD_Print(buffer);
+// ========== UI (키패드 / 조이스틱 / LCD) ==========
+// 로그 상세 화면 (16칸) 값: 퍼센트는 100 상한
+static unsigned Log_Pct(uint8_t v) { return (v > 100u) ? 100u : v; }
+
+// 지속 시간 7칸 이하: 100시간 미만 "99h59m", 그 이상 "999d23h"
+static void Log_FormatDuration(char out[8], uint32_t sec) {
+  uint32_t m = sec / 60u;
+  if (m < 100u * 60u) {
+    snprintf(out, 8, "%luh%02lum", (unsigned long)(m / 60u),
+             (unsigned long)(m % 60u));
+  } else {
+    uint32_t d = m / 1440u;
+    snprintf(out, 8, "%lud%02luh", (unsigned long)(d > 999u ? 999u : d),
+             (unsigned long)(m / 60u % 24u));
+  }
+}
+
+static void Task_UI(void) {
+  char buffer[32];
+
+  // ⭐ 이번 패스에 화면이 바뀌었는지 (메뉴는 들어올 때 새로 엶)
+  static SystemMode_t last_mode = MODE_PASSWORD_INPUT;
+  uint8_t entered = (current_mode != last_mode);
+  last_mode = current_mode;
+
+  char key = Keypad_Read();
+  if (key != 0) {
+    printf("[KEY] %c\r\n", key);
+  }
+
+  switch (current_mode) {
+
+  case MODE_PASSWORD_INPUT: {
+    // ⭐ 잠금 상태 체크
+    if (pw_locked) {
+      uint32_t now = HAL_GetTick();
+      if (now - pw_lock_start_time >= PW_LOCK_TIME) {
+        // 잠금 해제
+        pw_locked = 0;
+        pw_fail_count = 0;
+
+        Toast_Show("Lock Released", "Enter Password", 1500, TOAST_PRIO_INFO,
+                   TOAST_BEEP_NONE);
 
-      LCD_SetCursor(1, 0);
-      if (water_level < threshold_low) {
-        LCD_Print("LOW   (Back)    ");
-      } else if (water_level > threshold_high) {
-        LCD_Print("HIGH  (Back)    ");
       } else {
-        LCD_Print("OK    (Back)    ");
-      }
+        // 잠금 중
+        uint32_t remain = (PW_LOCK_TIME - (now - pw_lock_start_time)) / 1000;
 
-      if (Is_Joy_Button_Clicked()) {
-        current_mode = MODE_MENU_SELECT;
-        LCD_Clear();
+        LCD_SetCursor(0, 0);
+        LCD_Print("LOCKED!         ");
+        LCD_SetCursor(1, 0);
+        sprintf(buffer, "Wait %2lus      ", (unsigned long)remain);
+        LCD_Print(buffer);
       }
       break;
     }
 
-    // ============ 2. 댐 제어 모드 선택 ============
-    case MODE_DAM_CONTROL: {
-      const char *items[] = {
-          "Passive Mode ", // ⭐ 수정: 13칸 (커서 [V] 제외)
-          "Active Mode  ", // ⭐ 수정: 12칸
-          "Back         "  // ⭐ 수정: 4칸 + 8공백
-      };
-      const uint8_t ITEM_COUNT = 3;
+    // ⭐ 정상 비밀번호 입력 화면
+    LCD_SetCursor(0, 0);
+    LCD_Print("Enter Password: ");
+
+    LCD_SetCursor(1, 0);
+    for (int i = 0; i < 4; i++) {
+      LCD_Print((i < pw_idx) ? "*" : "_");
+    }
+    LCD_Print("            ");
+
+    if (key >= '0' && key <= '9' && pw_idx < 4) {
+      input_pw[pw_idx++] = key;
 
-      static JoyDirection_t last_dir_dam = JOY_NONE;
-      JoyDirection_t dir = Get_Joy_Direction();
+    } else if (key == '*') {
+      pw_idx = 0;
+      memset(input_pw, 0, sizeof(input_pw));
 
-      if (dir == JOY_NONE) {
-        last_dir_dam = JOY_NONE;
-      }
+    } else if ((key == '#' || Is_Joy_Button_Clicked()) && pw_idx == 4) {
+      input_pw[4] = '\0';
 
-      // ⭐ X축으로 커서 이동 (LEFT/RIGHT)
-      if (dir == JOY_RIGHT && last_dir_dam != JOY_RIGHT &&
-          cursor_pos < ITEM_COUNT - 1) {
-        cursor_pos++;
-        if (cursor_pos >= scroll_offset + 2) {
-          scroll_offset = cursor_pos - 1;
-        }
-        LCD_Clear();
-        last_dir_dam = JOY_RIGHT;
-        HAL_Delay(200);
-      } else if (dir == JOY_LEFT && last_dir_dam != JOY_LEFT &&
-                 cursor_pos > 0) {
-        cursor_pos--;
-        if (cursor_pos < scroll_offset) {
-          scroll_offset = cursor_pos;
-        }
-        LCD_Clear();
-        last_dir_dam = JOY_LEFT;
-        HAL_Delay(200);
-      }
+      if (strcmp(input_pw, target_pw) == 0) {
+        // ⭐ 성공
+        pw_fail_count = 0;
+        is_logged_in = 1; // ⭐ 로그인 상태 ON
 
-      // 2줄 표시
-      for (uint8_t i = 0; i < 2 && (scroll_offset + i) < ITEM_COUNT; i++) {
-        uint8_t item_idx = scroll_offset + i;
-        LCD_Print_With_Cursor(i, (item_idx == cursor_pos), items[item_idx]);
-      }
+        HAL_GPIO_WritePin(LED_GREEN_GPIO_Port, LED_GREEN_Pin, GPIO_PIN_SET);
+        led_off_time = HAL_GetTick() + 1000;
+
+        Toast_Show(NULL, "CORRECT!", 1000, TOAST_PRIO_INFO, TOAST_BEEP_NONE);
+
+        printf("[LOGIN] Success! RGB LED Enabled.\r\n"); // ⭐ 디버그
+
+        current_mode = MODE_MENU_SELECT;
+        menu_selected = 0;
+        pw_idx = 0;
+        memset(input_pw, 0, sizeof(input_pw));
+
+      } else {
+        // ⭐ 실패
+        pw_fail_count++;
+        printf("[PW] FAIL! Count=%d\r\n", pw_fail_count);
+
+        HAL_GPIO_WritePin(LED_RED_GPIO_Port, LED_RED_Pin, GPIO_PIN_SET);
+        led_off_time = HAL_GetTick() + 1000;
+
+        if (pw_fail_count >= PW_MAX_FAIL) {
+          pw_locked = 1;
+          pw_lock_start_time = HAL_GetTick();
+
+          Toast_Show(NULL, "Too Many Fails!", 1500, TOAST_PRIO_WARN,
+                     TOAST_BEEP_LONG);
+          printf("[PW] SYSTEM LOCKED\r\n");
 
-      if (Is_Joy_Button_Clicked()) {
-        if (cursor_pos == 0) {
-          current_mode = MODE_DAM_MANUAL;
-          cursor_pos = 0;
-          scroll_offset = 0;
-        } else if (cursor_pos == 1) {
-          current_mode = MODE_DAM_AUTO;
-          cursor_pos = 0;
-          scroll_offset = 0;
         } else {
-          current_mode = MODE_MENU_SELECT;
+          sprintf(buffer, "WRONG! (%d/%d)", pw_fail_count, PW_MAX_FAIL);
+          Toast_Show(NULL, buffer, 1000, TOAST_PRIO_WARN, TOAST_BEEP_LONG);
         }
-        LCD_Clear();
+
+        pw_idx = 0;
+        memset(input_pw, 0, sizeof(input_pw));
       }
-      break;
     }
+    break;
+  }
 
-    // ============ 2-1. 수동 제어 ============
-    case MODE_DAM_MANUAL: {
-      const char *items[] = {
-          "Servo1 Ctrl ", // ⭐ 수정: 12칸
-          "Servo2 Ctrl ", // ⭐ 수정: 12칸
-          "Back        "  // ⭐ 수정: 4칸 + 8공백
-      };
-      const uint8_t ITEM_COUNT = 3;
-
-      static JoyDirection_t last_dir_manual = JOY_NONE;
-      JoyDirection_t dir = Get_Joy_Direction();
-
-      if (dir == JOY_NONE)
-        last_dir_manual = JOY_NONE;
-
-      // ⭐ X축 이동 (LEFT/RIGHT)
-      if (dir == JOY_RIGHT && last_dir_manual != JOY_RIGHT &&
-          cursor_pos < ITEM_COUNT - 1) {
-        cursor_pos++;
-        if (cursor_pos >= scroll_offset + 2) {
-          scroll_offset = cursor_pos - 1;
-        }
-        LCD_Clear();
-        last_dir_manual = JOY_RIGHT;
-        HAL_Delay(200);
-      } else if (dir == JOY_LEFT && last_dir_manual != JOY_LEFT &&
-                 cursor_pos > 0) {
-        cursor_pos--;
-        if (cursor_pos < scroll_offset) {
-          scroll_offset = cursor_pos;
-        }
-        LCD_Clear();
-        last_dir_manual = JOY_LEFT;
-        HAL_Delay(200);
-      }
+  case MODE_MENU_SELECT: {
+    const char *menu_items[] = {
+        "1.Water Status ",  "2.Dam Control   ", "3.Threshold Set ",
+        "4.Environment   ", "5.Clock         ", "6.Change PW     ",
+        "7.Event Log     ", "8.Diagnostics   " // ⭐ 추가
+    };
 
-      for (uint8_t i = 0; i < 2 && (scroll_offset + i) < ITEM_COUNT; i++) {
-        uint8_t item_idx = scroll_offset + i;
-        LCD_Print_With_Cursor(i, (item_idx == cursor_pos), items[item_idx]);
-      }
+    static JoyDirection_t last_dir = JOY_NONE;
+    static uint8_t menu_locked = 0;
 
-      if (Is_Joy_Button_Clicked()) {
-        if (cursor_pos == 0) {
-          static uint8_t servo1_state = 0;
-          servo1_state = !servo1_state;
-          Servo_Set_Angle(1, servo1_state ? 90 : 0);
-        } else if (cursor_pos == 1) {
-          static uint8_t servo2_state = 0;
-          servo2_state = !servo2_state;
-          Servo_Set_Angle(2, servo2_state ? 90 : 0);
-        } else {
-          current_mode = MODE_DAM_CONTROL;
-          cursor_pos = 0;
-          scroll_offset = 0;
-          LCD_Clear();
-        }
-      }
-      break;
+    JoyDirection_t dir = Get_Joy_Direction();
+
+    if (dir == JOY_NONE) {
+      last_dir = JOY_NONE;
+      menu_locked = 0;
     }
 
-    // ============ 2-2. 자동 제어 ============
-    case MODE_DAM_AUTO: {
-      char status_str[16];
-      sprintf(status_str, "Now: %s     ",
-              dam_auto_mode ? "ON " : "OFF"); // ⭐ 수정: 16칸
-
-      const char *items[] = {dam_auto_mode ? "Turn OFF    "
-                                           : "Turn ON     ", // ⭐ 수정: 12칸
-                             status_str, "Back        "};
-      const uint8_t ITEM_COUNT = 3;
-
-      static JoyDirection_t last_dir_auto = JOY_NONE;
-      JoyDirection_t dir = Get_Joy_Direction();
-
-      if (dir == JOY_NONE)
-        last_dir_auto = JOY_NONE;
-
-      // ⭐ X축 이동
-      if (dir == JOY_RIGHT && last_dir_auto != JOY_RIGHT &&
-          cursor_pos < ITEM_COUNT - 1) {
-        cursor_pos++;
-        if (cursor_pos >= scroll_offset + 2) {
-          scroll_offset = cursor_pos - 1;
-        }
+    if (dir != JOY_NONE && !menu_locked) {
+      if (dir == JOY_UP && last_dir != JOY_UP) {
+        menu_selected = (menu_selected + 1) % 8; // ⭐ 7 → 8
         LCD_Clear();
-        last_dir_auto = JOY_RIGHT;
-        HAL_Delay(200);
-      } else if (dir == JOY_LEFT && last_dir_auto != JOY_LEFT &&
-                 cursor_pos > 0) {
-        cursor_pos--;
-        if (cursor_pos < scroll_offset) {
-          scroll_offset = cursor_pos;
-        }
+        menu_locked = 1;
+        // ⭐ HAL_Delay 제거
+      } else if (dir == JOY_DOWN && last_dir != JOY_DOWN) {
+        menu_selected =
+            (menu_selected == 0) ? 7 : menu_selected - 1; // ⭐ 6 → 7
         LCD_Clear();
-        last_dir_auto = JOY_LEFT;
-        HAL_Delay(200);
+        menu_locked = 1;
       }
+      last_dir = dir;
+    }
 
-      for (uint8_t i = 0; i < 2 && (scroll_offset + i) < ITEM_COUNT; i++) {
-        uint8_t item_idx = scroll_offset + i;
-        LCD_Print_With_Cursor(i, (item_idx == cursor_pos), items[item_idx]);
-      }
+    LCD_SetCursor(0, 0);
+    LCD_Print((char *)menu_items[menu_selected]);
+    LCD_SetCursor(1, 0);
+    LCD_Print("Click to Enter  ");
 
-      if (Is_Joy_Button_Clicked()) {
-        if (cursor_pos == 0) {
-          dam_auto_mode = !dam_auto_mode;
-          printf("[AUTO] Mode: %s\r\n", dam_auto_mode ? "ON" : "OFF");
-          LCD_Clear();
-        } else if (cursor_pos == 2) {
-          current_mode = MODE_DAM_CONTROL;
-          cursor_pos = 0;
-          scroll_offset = 0;
-          LCD_Clear();
-        }
+    if (Is_Joy_Button_Clicked()) {
+      cursor_pos = 0;
+      scroll_offset = 0;
+      LCD_Clear();
+
+      switch (menu_selected) {
+      case 0:
+        current_mode = MODE_WATER_STATUS;
+        break;
+      case 1:
+        current_mode = MODE_DAM_CONTROL;
+        break;
+      case 2:
+        current_mode = MODE_THRESHOLD_SET;
+        break;
+      case 3:
+        current_mode = MODE_ENVIRONMENT;
+        break;
+      case 4:
+        current_mode = MODE_CLOCK;
+        break;
+      case 5:
+        current_mode = MODE_PW_CHANGE;
+        pw_idx = 0;
+        memset(input_pw, 0, sizeof(input_pw));
+        break;
+      case 6: // ⭐ 로그 화면
+        current_mode = MODE_LOG;
+        cursor_pos = 0;
+        break;
+      case 7: // ⭐ 진단 화면
+        current_mode = MODE_DIAG;
+        break;
       }
-      break;
     }
+    break;
+  }
 
-    // ============ 3. 기준치 변경 ============
-    case MODE_THRESHOLD_SET: {
-      char item0[16], item1[16];
-      sprintf(item0, "High:%2d%%   ", threshold_high);
-      sprintf(item1, "Low: %2d%%   ", threshold_low);
+    // ============ 1. 수위 상태 ============
+    // ============ 1. 수위 상태 ============
+  case MODE_WATER_STATUS: {
+    LCD_SetCursor(0, 0);
+    sprintf(buffer, "Water:%3d%% %02d:%02d", water_level, global_time.Hours,
+            global_time.Minutes);
+    LCD_Print(buffer);
+
+    LCD_SetCursor(1, 0);
+    if (water_state == WATER_ST_LOW) {
+      LCD_Print("LOW   (Back)    ");
+    } else if (water_state == WATER_ST_HIGH) {
+      LCD_Print("HIGH  (Back)    ");
+    } else {
+      LCD_Print("OK    (Back)    ");
+    }
 
-      const char *items[] = {item0, item1, "Back        "};
-      const uint8_t ITEM_COUNT = 3;
+    if (Is_Joy_Button_Clicked()) {
+      current_mode = MODE_MENU_SELECT;
+      LCD_Clear();
+    }
+    break;
+  }
 
-      static JoyDirection_t last_dir_th = JOY_NONE;
-      JoyDirection_t dir = Get_Joy_Direction();
+  // ============ 2. 댐 제어 / 3. 기준치 변경 (표 기반 메뉴) ============
+  case MODE_DAM_CONTROL:
+  case MODE_DAM_MANUAL:
+  case MODE_DAM_AUTO:
+  case MODE_THRESHOLD_SET: {
+    const Menu_t *menu = Ui_ModeMenu(current_mode);
+    if (entered || ui_menu.menu != menu) {
+      Menu_Open(&ui_menu, menu, cursor_pos);
+    }
+    Menu_Update(&ui_menu, Ui_MenuInput());
+    break;
+  }
 
-      if (dir == JOY_NONE)
-        last_dir_th = JOY_NONE;
+  // ============ 3-1. 기준치 입력 ============
+  case MODE_THRESHOLD_INPUT: {
+    // 화면 표시
+    LCD_SetCursor(0, 0);
+    if (threshold_input_mode == 0) {
+      sprintf(buffer, "Set High (0-50) ");
+    } else {
+      sprintf(buffer, "Set Low  (0-50) ");
+    }
+    LCD_Print(buffer);
 
-      if (dir == JOY_RIGHT && last_dir_th != JOY_RIGHT &&
-          cursor_pos < ITEM_COUNT - 1) {
-        cursor_pos++;
-        if (cursor_pos >= scroll_offset + 2) {
-          scroll_offset = cursor_pos - 1;
-        }
-        LCD_Clear();
-        last_dir_th = JOY_RIGHT;
-        HAL_Delay(200);
-      } else if (dir == JOY_LEFT && last_dir_th != JOY_LEFT && cursor_pos > 0) {
-        cursor_pos--;
-        if (cursor_pos < scroll_offset) {
-          scroll_offset = cursor_pos;
-        }
-        LCD_Clear();
-        last_dir_th = JOY_LEFT;
-        HAL_Delay(200);
-      }
+    // ⭐ 현재 입력 상태를 buffer에 한번에 구성
+    LCD_SetCursor(1, 0);
+    char display_line[17]; // 16칸 + NULL
+
+    // 입력된 숫자들
+    if (threshold_input_idx == 0) {
+      sprintf(display_line, "__ (#:OK *:Back)"); // 16칸
+    } else if (threshold_input_idx == 1) {
+      sprintf(display_line, "%c_ (#:OK *:Back)", threshold_input[0]); // 16칸
+    } else {
+      sprintf(display_line, "%c%c (#:OK *:Back)", threshold_input[0],
+              threshold_input[1]); // 16칸
+    }
 
-      for (uint8_t i = 0; i < 2 && (scroll_offset + i) < ITEM_COUNT; i++) {
-        uint8_t item_idx = scroll_offset + i;
-        LCD_Print_With_Cursor(i, (item_idx == cursor_pos), items[item_idx]);
+    LCD_Print(display_line);
+
+    // 숫자 키 입력 (0~9)
+    if (key >= '0' && key <= '9') {
+      if (threshold_input_idx < 2) {
+        threshold_input[threshold_input_idx] = key;
+        threshold_input_idx++;
+        printf("[THRESHOLD] Input: %c (idx=%d)\r\n", key,
+               threshold_input_idx);
       }
+    }
+    // '*' 누르면 취소하고 돌아가기
+    else if (key == '*') {
+      threshold_input_idx = 0;
+      memset(threshold_input, 0, sizeof(threshold_input));
+      current_mode = MODE_THRESHOLD_SET;
+      cursor_pos = threshold_input_mode;
+      printf("[THRESHOLD] Cancelled\r\n");
+      LCD_Clear();
+    }
+    // '#' 누르면 값 저장
+    else if (key == '#' && threshold_input_idx > 0) {
+      threshold_input[threshold_input_idx] = '\0';
+      int new_value = atoi(threshold_input);
+
+      printf("[THRESHOLD] Input value: %d\r\n", new_value);
+
+      // 유효성 검사
+      if (new_value < 0 || new_value > 50) {
+        // 범위 초과 (⭐ 메시지는 덮어쓰기만, 제어/로그는 계속 동작)
+        Toast_Show("Error: 0-50 Only", "Try Again", 1500, TOAST_PRIO_WARN,
+                   TOAST_BEEP_SHORT);
+        threshold_input_idx = 0;
+        memset(threshold_input, 0, sizeof(threshold_input));
 
-      if (Is_Joy_Button_Clicked()) {
-        if (cursor_pos == 0) {
-          // High 기준치 변경 ⭐
-          threshold_input_mode = 0; // High 모드
+      } else if (threshold_input_mode == 0) {
+        // High 값 설정
+        if (new_value <= threshold_low) {
+          sprintf(buffer, "High > Low(%d%%)", threshold_low);
+          Toast_Show(buffer, "Try Again", 1500, TOAST_PRIO_WARN,
+                     TOAST_BEEP_SHORT);
           threshold_input_idx = 0;
           memset(threshold_input, 0, sizeof(threshold_input));
-          current_mode = MODE_THRESHOLD_INPUT;
-          LCD_Clear();
-          printf("[THRESHOLD] Entering High input mode\r\n");
-        } else if (cursor_pos == 1) {
-          // Low 기준치 변경 ⭐
-          threshold_input_mode = 1; // Low 모드
-          threshold_input_idx = 0;
-          memset(threshold_input, 0, sizeof(threshold_input));
-          current_mode = MODE_THRESHOLD_INPUT;
-          LCD_Clear();
-          printf("[THRESHOLD] Entering Low input mode\r\n");
+
         } else {
-          // Back
-          current_mode = MODE_MENU_SELECT;
-          cursor_pos = 0;
-          scroll_offset = 0;
-          LCD_Clear();
-        }
-      }
-      break;
-    }
+          // 성공
+          threshold_high = new_value;
+          printf("[THRESHOLD] High set to: %d\r\n", threshold_high);
 
-    // ============ 3-1. 기준치 입력 ============
-    case MODE_THRESHOLD_INPUT: {
-      // 화면 표시
-      LCD_SetCursor(0, 0);
-      if (threshold_input_mode == 0) {
-        sprintf(buffer, "Set High (0-50) ");
-      } else {
-        sprintf(buffer, "Set Low  (0-50) ");
-      }
-      LCD_Print(buffer);
+          sprintf(buffer, "High Set: %d%%", threshold_high);
+          Toast_Show(buffer, "Success!", 1500, TOAST_PRIO_INFO,
+                     TOAST_BEEP_NONE);
 
-      // ⭐ 현재 입력 상태를 buffer에 한번에 구성
-      LCD_SetCursor(1, 0);
-      char display_line[17]; // 16칸 + NULL
+          threshold_input_idx = 0;
+          memset(threshold_input, 0, sizeof(threshold_input));
+          Ui_Goto(MODE_THRESHOLD_SET, 0);
+        }
 
-      // 입력된 숫자들
-      if (threshold_input_idx == 0) {
-        sprintf(display_line, "__ (#:OK *:Back)"); // 16칸
-      } else if (threshold_input_idx == 1) {
-        sprintf(display_line, "%c_ (#:OK *:Back)", threshold_input[0]); // 16칸
       } else {
-        sprintf(display_line, "%c%c (#:OK *:Back)", threshold_input[0],
-                threshold_input[1]); // 16칸
-      }
+        // Low 값 설정
+        if (new_value >= threshold_high) {
+          sprintf(buffer, "Low < High(%d%%)", threshold_high);
+          Toast_Show(buffer, "Try Again", 1500, TOAST_PRIO_WARN,
+                     TOAST_BEEP_SHORT);
+          threshold_input_idx = 0;
+          memset(threshold_input, 0, sizeof(threshold_input));
 
-      LCD_Print(display_line);
+        } else {
+          // 성공
+          threshold_low = new_value;
+          printf("[THRESHOLD] Low set to: %d\r\n", threshold_low);
 
-      // 숫자 키 입력 (0~9)
-      if (key >= '0' && key <= '9') {
-        if (threshold_input_idx < 2) {
-          threshold_input[threshold_input_idx] = key;
-          threshold_input_idx++;
-          printf("[THRESHOLD] Input: %c (idx=%d)\r\n", key,
-                 threshold_input_idx);
-        }
-      }
-      // '*' 누르면 취소하고 돌아가기
-      else if (key == '*') {
-        threshold_input_idx = 0;
-        memset(threshold_input, 0, sizeof(threshold_input));
-        current_mode = MODE_THRESHOLD_SET;
-        cursor_pos = threshold_input_mode;
-        printf("[THRESHOLD] Cancelled\r\n");
-        LCD_Clear();
-      }
-      // '#' 누르면 값 저장
-      else if (key == '#' && threshold_input_idx > 0) {
-        threshold_input[threshold_input_idx] = '\0';
-        int new_value = atoi(threshold_input);
-
-        printf("[THRESHOLD] Input value: %d\r\n", new_value);
-
-        // 유효성 검사
-        if (new_value < 0 || new_value > 50) {
-          // 범위 초과
-          LCD_Clear();
-          LCD_SetCursor(0, 0);
-          LCD_Print("Error: 0-50 Only");
-          LCD_SetCursor(1, 0);
-          LCD_Print("Try Again       ");
-          HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_SET);
-          HAL_Delay(300);
-          HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_RESET);
-          HAL_Delay(1200);
+          sprintf(buffer, "Low Set: %d%%", threshold_low);
+          Toast_Show(buffer, "Success!", 1500, TOAST_PRIO_INFO,
+                     TOAST_BEEP_NONE);
 
           threshold_input_idx = 0;
           memset(threshold_input, 0, sizeof(threshold_input));
-          LCD_Clear();
-
-        } else if (threshold_input_mode == 0) {
-          // High 값 설정
-          if (new_value <= threshold_low) {
-            LCD_Clear();
-            LCD_SetCursor(0, 0);
-            sprintf(buffer, "High > Low(%d%%) ", threshold_low);
-            LCD_Print(buffer);
-            LCD_SetCursor(1, 0);
-            LCD_Print("Try Again       ");
-            HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_SET);
-            HAL_Delay(300);
-            HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_RESET);
-            HAL_Delay(1200);
-
-            threshold_input_idx = 0;
-            memset(threshold_input, 0, sizeof(threshold_input));
-            LCD_Clear();
-
-          } else {
-            // 성공
-            threshold_high = new_value;
-            printf("[THRESHOLD] High set to: %d\r\n", threshold_high);
-
-            LCD_Clear();
-            LCD_SetCursor(0, 0);
-            sprintf(buffer, "High Set: %d%%  ", threshold_high);
-            LCD_Print(buffer);
-            LCD_SetCursor(1, 0);
-            LCD_Print("Success!        ");
-            HAL_Delay(1500);
-
-            current_mode = MODE_THRESHOLD_SET;
-            threshold_input_idx = 0;
-            memset(threshold_input, 0, sizeof(threshold_input));
-            cursor_pos = 0;
-            scroll_offset = 0;
-            LCD_Clear();
-          }
-
-        } else {
-          // Low 값 설정
-          if (new_value >= threshold_high) {
-            LCD_Clear();
-            LCD_SetCursor(0, 0);
-            sprintf(buffer, "Low < High(%d%%)", threshold_high);
-            LCD_Print(buffer);
-            LCD_SetCursor(1, 0);
-            LCD_Print("Try Again       ");
-            HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_SET);
-            HAL_Delay(300);
-            HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_RESET);
-            HAL_Delay(1200);
-
-            threshold_input_idx = 0;
-            memset(threshold_input, 0, sizeof(threshold_input));
-            LCD_Clear();
-
-          } else {
-            // 성공
-            threshold_low = new_value;
-            printf("[THRESHOLD] Low set to: %d\r\n", threshold_low);
-
-            LCD_Clear();
-            LCD_SetCursor(0, 0);
-            sprintf(buffer, "Low Set: %d%%   ", threshold_low);
-            LCD_Print(buffer);
-            LCD_SetCursor(1, 0);
-            LCD_Print("Success!        ");
-            HAL_Delay(1500);
-
-            current_mode = MODE_THRESHOLD_SET;
-            threshold_input_idx = 0;
-            memset(threshold_input, 0, sizeof(threshold_input));
-            cursor_pos = 1;
-            scroll_offset = 0;
-            LCD_Clear();
-          }
+          Ui_Goto(MODE_THRESHOLD_SET, 1);
         }
       }
-      break;
     }
+    break;
+  }
 
-      // ============ 4. 환경 정보 ============
-    case MODE_ENVIRONMENT: {
-      LCD_SetCursor(0, 0);
-      if (dht11_valid) {
-        sprintf(buffer, "T:%2dC H:%2d%%    ", // ⭐ 수정: 16칸
-                global_dht11_data.temperature, global_dht11_data.humidity);
-        LCD_Print(buffer); // "T:24C H:55%    " = 16칸
-      } else {
-        LCD_Print("Sensor Error!   "); // 16칸 ✅
-      }
+    // ============ 4. 환경 정보 ============
+  case MODE_ENVIRONMENT: {
+    LCD_SetCursor(0, 0);
+    if (dht11_valid) {
+      sprintf(buffer, "T:%2d.%dC H:%2d%%   ", // ⭐ 소수부 추가: 16칸
+              global_dht11_data.temperature,
+              global_dht11_data.temperature_dec % 10,
+              global_dht11_data.humidity);
+      LCD_Print(buffer); // "T:24.5C H:55%   " = 16칸
+    } else {
+      LCD_Print("Sensor Error!   "); // 16칸 ✅
+    }
 
-      // 시스템 내부 온도
-      uint16_t temp_adc = adc_values[3];
-      float vsense = (temp_adc * 3.3f) / 4095.0f;
-      float sys_temp = ((vsense - 0.76f) / 0.0025f) + 25.0f;
+    // 시스템 내부 온도 (Task_Level 이 프레임마다 계산한 값, 부호는 따로)
+    int16_t t = sys_temp_x10;
+    const char *sign = (t < 0) ? "-" : "";
+    if (t < 0)
+      t = (int16_t)-t;
 
-      LCD_SetCursor(1, 0);
-      sprintf(buffer, "Sys:%.1fC (Back)", sys_temp); // 16칸 ✅
-      LCD_Print(buffer);
+    LCD_SetCursor(1, 0);
+    snprintf(buffer, sizeof(buffer), "Sys:%s%d.%dC (Back)", sign, t / 10,
+             t % 10); // "Sys:31.2C (Back)" = 16칸
+    LCD_Print(buffer);
 
-      // 온도 경고 (30도 이상)
-      if (dht11_valid && global_dht11_data.temperature >= 30) {
-        HAL_GPIO_WritePin(LED_RED_GPIO_Port, LED_RED_Pin, GPIO_PIN_SET);
-      } else {
-        HAL_GPIO_WritePin(LED_RED_GPIO_Port, LED_RED_Pin, GPIO_PIN_RESET);
-      }
+    // 온도 경고 (30도 이상)
+    if (dht11_valid && global_dht11_data.temperature >= 30) {
+      HAL_GPIO_WritePin(LED_RED_GPIO_Port, LED_RED_Pin, GPIO_PIN_SET);
+    } else {
+      HAL_GPIO_WritePin(LED_RED_GPIO_Port, LED_RED_Pin, GPIO_PIN_RESET);
+    }
 
-      if (Is_Joy_Button_Clicked()) {
-        current_mode = MODE_MENU_SELECT;
-        HAL_GPIO_WritePin(LED_RED_GPIO_Port, LED_RED_Pin, GPIO_PIN_RESET);
-        LCD_Clear();
-      }
-      break;
+    if (Is_Joy_Button_Clicked()) {
+      current_mode = MODE_MENU_SELECT;
+      HAL_GPIO_WritePin(LED_RED_GPIO_Port, LED_RED_Pin, GPIO_PIN_RESET);
+      LCD_Clear();
     }
+    break;
+  }
 
-    // ============ 5. 시계 ============
-    case MODE_CLOCK:
-      LCD_SetCursor(0, 0);
-      sprintf(buffer, "20%02d-%02d-%02d    ", // ⭐ 수정: 16칸
-              global_date.Year, global_date.Month, global_date.Date);
-      LCD_Print(buffer); // "2026-01-27    " = 16칸
+  // ============ 5. 시계 ============
+  case MODE_CLOCK:
+    LCD_SetCursor(0, 0);
+    sprintf(buffer, "20%02d-%02d-%02d    ", // ⭐ 수정: 16칸
+            global_date.Year, global_date.Month, global_date.Date);
+    LCD_Print(buffer); // "2026-01-27    " = 16칸
 
-      LCD_SetCursor(1, 0);
-      sprintf(buffer, "%02d:%02d:%02d (Back)", // 16칸 ✅
-              global_time.Hours, global_time.Minutes, global_time.Seconds);
-      LCD_Print(buffer); // "14:30:25 (Back)" = 16칸
+    LCD_SetCursor(1, 0);
+    sprintf(buffer, "%02d:%02d:%02d (Back)", // 16칸 ✅
+            global_time.Hours, global_time.Minutes, global_time.Seconds);
+    LCD_Print(buffer); // "14:30:25 (Back)" = 16칸
 
-      if (Is_Joy_Button_Clicked()) {
-        current_mode = MODE_MENU_SELECT;
-        LCD_Clear();
+    if (Is_Joy_Button_Clicked()) {
+      current_mode = MODE_MENU_SELECT;
+      LCD_Clear();
+    }
+    break;
+  // ============ 6. 비밀번호 변경 ============
+  case MODE_PW_CHANGE: {
+    LCD_SetCursor(0, 0);
+    LCD_Print("New Password:   ");
+
+    LCD_SetCursor(1, 0);
+    for (int i = 0; i < 4; i++) {
+      if (i < pw_idx) {
+        LCD_Print("*");
+      } else {
+        LCD_Print("_");
       }
-      break;
-    // ============ 6. 비밀번호 변경 ============
-    case MODE_PW_CHANGE: {
-      LCD_SetCursor(0, 0);
-      LCD_Print("New Password:   ");
+    }
+    LCD_Print(" (#:OK)     ");
 
-      LCD_SetCursor(1, 0);
-      for (int i = 0; i < 4; i++) {
-        if (i < pw_idx) {
-          LCD_Print("*");
-        } else {
-          LCD_Print("_");
-        }
+    if (key >= '0' && key <= '9') {
+      if (pw_idx < 4) {
+        input_pw[pw_idx] = key;
+        pw_idx++;
+        printf("[PW-CHG] Input: %c (idx=%d)\r\n", key, pw_idx);
       }
-      LCD_Print(" (#:OK)     ");
+    } else if (key == '*') {
+      pw_idx = 0;
+      memset(input_pw, 0, sizeof(input_pw));
+      current_mode = MODE_MENU_SELECT;
+      printf("[PW-CHG] Cancelled\r\n");
+      LCD_Clear();
+    } else if (key == '#' && pw_idx == 4) {
+      input_pw[4] = '\0';
 
-      if (key >= '0' && key <= '9') {
-        if (pw_idx < 4) {
-          input_pw[pw_idx] = key;
-          pw_idx++;
-          printf("[PW-CHG] Input: %c (idx=%d)\r\n", key, pw_idx);
-        }
-      } else if (key == '*') {
-        pw_idx = 0;
-        memset(input_pw, 0, sizeof(input_pw));
-        current_mode = MODE_MENU_SELECT;
-        printf("[PW-CHG] Cancelled\r\n");
-        LCD_Clear();
-      } else if (key == '#' && pw_idx == 4) {
-        input_pw[4] = '\0';
+      strcpy(target_pw, input_pw);
+      printf("[PW-CHG] New: %s\r\n", target_pw);
 
-        strcpy(target_pw, input_pw);
-        printf("[PW-CHG] New: %s\r\n", target_pw);
+      LCD_Clear();
+      Toast_Show("PW CHANGED!", "Re-login Please", 1500, TOAST_PRIO_INFO,
+                 TOAST_BEEP_SHORT);
 
-        LCD_Clear();
-        LCD_SetCursor(0, 0);
-        LCD_Print("PW CHANGED!     ");
-        LCD_SetCursor(1, 0);
-        LCD_Print("Re-login Please ");
+      // ⭐ 로그아웃 처리
+      is_logged_in = 0;
+      current_mode = MODE_PASSWORD_INPUT;
+      pw_idx = 0;
+      memset(input_pw, 0, sizeof(input_pw));
 
-        HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin, GPIO_PIN_SET);
-        buzzer_off_time = HAL_GetTick() + 300;
+      printf("[LOGOUT] RGB LED Disabled.\r\n"); // ⭐ 디버그
+    }
+    break;
+  }
 
-        message_clear_time = HAL_GetTick() + 1500;
+  // ============ 7. 로그 화면 ============
+  case MODE_LOG: {
+    uint16_t log_count = WaterLog_Count(&water_log);
+
+    // ⭐ 0 = Back, 1..log_count = 이벤트 (uint8 커서는 128개부터 넘침)
+    static uint16_t log_pos = 0;
+    static uint8_t log_filter = WATERLOG_F_ALL; // '*' 로 ALL → LOW → HIGH
+    static uint8_t log_detail = 0; // ⭐ 위/아래: 시간 ↔ 통계 화면
+    if (log_pos > log_count)
+      log_pos = log_count;
+
+    if (key == '#' && export_pos == WATERLOG_NONE) {
+      // ⭐ CSV 내보내기 시작 (실제 출력은 Task_Export가 나눠서)
+      //    화면의 상태 필터 그대로
+      WaterLog_ExportHeader();
+      export_range = (WaterLog_Range_t)WATERLOG_RANGE_ALL;
+      export_range.filter = log_filter;
+      export_pos = 0;
+    } else if (key == '*') {
+      log_filter = (log_filter == WATERLOG_F_ALL)   ? WATERLOG_F_LOW
+                   : (log_filter == WATERLOG_F_LOW) ? WATERLOG_F_HIGH
+                                                    : WATERLOG_F_ALL;
+      log_pos = 0;
+      LCD_Clear();
+    } else if (key == 'D') {
+      // ⭐ 최근 24시간 첫 이벤트로 이동 (이진 탐색)
+      uint32_t now_epoch = WaterLog_ToEpoch(&global_time, &global_date);
+      uint16_t v = WaterLog_FindNext(
+          &water_log,
+          WaterLog_FindFirstAtOrAfter(&water_log, now_epoch - 86400u),
+          log_filter);
+      if (v != WATERLOG_NONE)
+        log_pos = v + 1;
+      LCD_Clear();
+    }
 
-        // ⭐ 로그아웃 처리
-        is_logged_in = 0;
-        current_mode = MODE_PASSWORD_INPUT;
-        pw_idx = 0;
-        memset(input_pw, 0, sizeof(input_pw));
+    static JoyDirection_t last_dir_log = JOY_NONE;
+    JoyDirection_t dir = Get_Joy_Direction();
 
-        printf("[LOGOUT] RGB LED Disabled.\r\n"); // ⭐ 디버그
-      }
-      break;
+    if (dir == JOY_NONE) {
+      last_dir_log = JOY_NONE;
     }
 
-    // ============ 7. 로그 화면 ============
-    case MODE_LOG: {
-      uint8_t log_count = WaterLog_Count(&water_log);
+    // X축으로 이동 (필터에 맞는 이벤트만)
+    if (dir == JOY_RIGHT && last_dir_log != JOY_RIGHT) {
+      uint16_t v = WaterLog_FindNext(&water_log, log_pos, log_filter);
+      if (v != WATERLOG_NONE)
+        log_pos = v + 1;
+      LCD_Clear();
+      last_dir_log = JOY_RIGHT;
 
-      uint8_t total_lines = 1 + (log_count * 2);
+    } else if (dir == JOY_LEFT && last_dir_log != JOY_LEFT) {
+      uint16_t v = (log_pos > 1)
+                       ? WaterLog_FindPrev(&water_log, log_pos - 2, log_filter)
+                       : WATERLOG_NONE;
+      log_pos = (v != WATERLOG_NONE) ? v + 1 : 0;
+      LCD_Clear();
+      last_dir_log = JOY_LEFT;
 
-      static JoyDirection_t last_dir_log = JOY_NONE;
-      JoyDirection_t dir = Get_Joy_Direction();
+    } else if ((dir == JOY_UP || dir == JOY_DOWN) && last_dir_log != dir) {
+      log_detail = !log_detail;
+      LCD_Clear();
+      last_dir_log = dir;
+    }
 
-      if (dir == JOY_NONE) {
-        last_dir_log = JOY_NONE;
+    // ⭐ 2줄 표시
+    if (log_pos == 0) {
+      // ⭐ Back 화면 (필터 + 최근 24시간 요약)
+      const char *filter_str = (log_filter == WATERLOG_F_LOW)    ? "LOW"
+                               : (log_filter == WATERLOG_F_HIGH) ? "HIGH"
+                                                                 : "ALL";
+      snprintf(buffer, sizeof(buffer), "[V] Back   %s", filter_str);
+      LCD_PrintLine(0, buffer);
+
+      LCD_SetCursor(1, 0);
+      if (log_count > 0) {
+        uint32_t now_epoch = WaterLog_ToEpoch(&global_time, &global_date);
+        WaterLog_Agg_t agg;
+        WaterLog_Aggregate(&water_log, now_epoch - 86400u, now_epoch + 1,
+                           now_epoch, &agg);
+        snprintf(buffer, sizeof(buffer), "24h L:%u H:%u",
+                 agg.count[WATER_ST_LOW], agg.count[WATER_ST_HIGH]);
+        LCD_PrintLine(1, buffer);
+      } else {
+        LCD_Print("No Logs         "); // ⭐ 체크박스 제거
       }
 
-      // X축으로 이동 (2줄씩 건너뛰기)
-      if (dir == JOY_RIGHT && last_dir_log != JOY_RIGHT) {
-        if (cursor_pos == 0 && log_count > 0) {
-          cursor_pos = 1;
-          scroll_offset = 0;
-        } else if (cursor_pos > 0) {
-          cursor_pos += 2;
-          if (cursor_pos >= total_lines) {
-            cursor_pos = total_lines - 2;
-          }
-          if (cursor_pos >= scroll_offset + 2) {
-            scroll_offset = cursor_pos;
-          }
-        }
-        LCD_Clear();
-        last_dir_log = JOY_RIGHT;
-
-      } else if (dir == JOY_LEFT && last_dir_log != JOY_LEFT) {
-        if (cursor_pos > 1) {
-          cursor_pos -= 2;
-          if (cursor_pos < 1)
-            cursor_pos = 1;
-          if (cursor_pos < scroll_offset) {
-            scroll_offset = cursor_pos - 1;
-            if (scroll_offset < 0)
-              scroll_offset = 0;
+    } else {
+      // ⭐ 로그 표시 (필요한 레코드 하나만 풀어서 사용)
+      WaterEvent_t ev;
+
+      if (WaterLog_GetByViewIndex(&water_log, log_pos - 1, &ev)) {
+        char log_line[LCD_COLS + 1];
+        const char *state_str = (ev.state == WATER_ST_LOW) ? "L" : "H";
+
+        if (log_detail) {
+          // ⭐ 통계 화면: 최고/최저/평균, 지속 시간 + 적분(%·h)
+          // 16칸에 다 들어가도록 값마다 자릿수 상한 (잘리면 '+' 가 사라짐)
+          char dur[8];
+          Log_FormatDuration(dur, ev.duration_s);
+          if (!ev.has_stats) {
+            // 통계 없음: 저장소가 없거나 종료 기록이 깨진 오래된 이벤트
+            LCD_PrintLine(0, "P- T- M-");
+            LCD_PrintLine(1, dur);
+            break;
           }
-        } else {
-          cursor_pos = 0;
-          scroll_offset = 0;
+          snprintf(log_line, sizeof(log_line), "P%u T%u M%u%%",
+                   Log_Pct(ev.peak_percent), Log_Pct(ev.trough_percent),
+                   Log_Pct(ev.mean_percent));
+          LCD_PrintLine(0, log_line);
+
+          uint32_t pct_h = (ev.integral + 1800) / 3600;
+          snprintf(log_line, sizeof(log_line), "%s %lu%%h%s", dur,
+                   (unsigned long)(pct_h > 9999u ? 9999u : pct_h),
+                   ev.ended ? "" : "+");
+          LCD_PrintLine(1, log_line);
+          break;
         }
-        LCD_Clear();
-        last_dir_log = JOY_LEFT;
-      }
-
-      // ⭐ 2줄 표시
-      if (cursor_pos == 0) {
-        // ⭐ Back 화면
-        LCD_SetCursor(0, 0);
-        LCD_Print("[V] Back        "); // 체크박스 유지
 
-        LCD_SetCursor(1, 0);
-        if (log_count > 0) {
-          sprintf(buffer, "Logs:%2d/10     ", log_count); // ⭐ 체크박스 제거
-          LCD_Print(buffer);
+        // ⭐ 첫 줄: 번호 (최대 WATERLOG_MAX, 3자리) + 상태 + 시작 시간
+        snprintf(log_line, sizeof(log_line), "#%-3u %s %02u:%02u:%02u",
+                 (unsigned)(log_pos % 1000u), state_str,
+                 ev.t_start.Hours % 24u, ev.t_start.Minutes % 60u,
+                 ev.t_start.Seconds % 60u);
+        LCD_PrintLine(0, log_line);
+
+        // ⭐ 둘째 줄: 종료 시간
+        if (ev.ended) {
+          snprintf(log_line, sizeof(log_line), "    ~ %02u:%02u:%02u",
+                   ev.t_end.Hours % 24u, ev.t_end.Minutes % 60u,
+                   ev.t_end.Seconds % 60u);
         } else {
-          LCD_Print("No Logs         "); // ⭐ 체크박스 제거
+          snprintf(log_line, sizeof(log_line), "(ongoing)");
         }
+        LCD_PrintLine(1, log_line);
+      }
+    }
 
-      } else {
-        // ⭐ 로그 표시 (체크박스 완전 제거)
-        uint8_t log_idx = (cursor_pos - 1) / 2;
-        const WaterEvent_t *ev = WaterLog_GetByViewIndex(&water_log, log_idx);
-
-        if (ev) {
-          char log_line[17];
-          const char *state_str = (ev->state == WATER_ST_LOW) ? "L" : "H";
-
-          // ⭐ 첫 줄: 번호 + 상태 + 시작 시간 (체크박스 없음)
-          LCD_SetCursor(0, 0);
-          sprintf(log_line, "%d/%d %s %02d:%02d:%02d   ", log_idx + 1,
-                  log_count, state_str, ev->t_start.Hours, ev->t_start.Minutes,
-                  ev->t_start.Seconds);
-          LCD_Print(log_line);
-
-          // ⭐ 둘째 줄: 종료 시간 (체크박스 없음)
-          LCD_SetCursor(1, 0);
-          if (ev->ended) {
-            sprintf(log_line, "    ~ %02d:%02d:%02d      ", ev->t_end.Hours,
-                    ev->t_end.Minutes, ev->t_end.Seconds);
-          } else {
-            sprintf(log_line, "(ongoing)       ");
-          }
-          LCD_Print(log_line);
-        }
+    // Back 선택 시 돌아가기
+    if (Is_Joy_Button_Clicked() && log_pos == 0) {
+      current_mode = MODE_MENU_SELECT;
+      cursor_pos = 0;
+      scroll_offset = 0;
+      LCD_Clear();
+    }
+    break;
+  }
+    // ============ 8. 진단 (구간 실행 시간) ============
+  case MODE_DIAG: {
+#if PROF_ENABLE
+    // ⭐ 0 = Back, 1.. = 이름 있는 구간 (좌/우 이동, '*' 통계 초기화)
+    static uint8_t diag_pos = 0;
+    static JoyDirection_t last_dir_diag = JOY_NONE;
+    JoyDirection_t dir = Get_Joy_Direction();
+
+    if (dir != last_dir_diag) {
+      if (dir == JOY_RIGHT || dir == JOY_LEFT) {
+        int8_t step = (dir == JOY_RIGHT) ? 1 : -1;
+        uint8_t p = diag_pos;
+        do {
+          p = (uint8_t)((p + PROF_ZONE_COUNT + 1 + step) %
+                        (PROF_ZONE_COUNT + 1));
+        } while (p != 0 && Prof_Get(p - 1)->name == NULL);
+        diag_pos = p;
       }
+      last_dir_diag = dir;
+    }
+    if (key == '*') {
+      Prof_Reset();
+    }
 
-      // Back 선택 시 돌아가기
-      if (Is_Joy_Button_Clicked() && cursor_pos == 0) {
-        current_mode = MODE_MENU_SELECT;
-        cursor_pos = 0;
-        scroll_offset = 0;
-        LCD_Clear();
+    if (diag_pos > 0) {
+      const Prof_Stats_t *s = Prof_Get(diag_pos - 1);
+      uint32_t tpu = Prof_TicksPerUs();
+
+      snprintf(buffer, sizeof(buffer), "%-7s n%lu", s->name,
+               (unsigned long)s->count);
+      LCD_PrintLine(0, buffer);
+      if (s->count > 0) {
+        // 최소/평균/최대 (µs)
+        snprintf(buffer, sizeof(buffer), "%lu/%lu/%luus",
+                 (unsigned long)(s->min / tpu),
+                 (unsigned long)(s->sum / s->count / tpu),
+                 (unsigned long)(s->max / tpu));
+        LCD_PrintLine(1, buffer);
+      } else {
+        LCD_PrintLine(1, "no samples");
       }
       break;
     }
-    default:
-      break;
+#endif
+
+    LCD_PrintLine(0, "[V] Back  <Diag>");
+    LCD_PrintLine(1, PROF_ENABLE ? "* reset  <> zone" : "Profiling off");
+
+    if (Is_Joy_Button_Clicked()) {
+      current_mode = MODE_MENU_SELECT;
+      cursor_pos = 0;
+      scroll_offset = 0;
+      LCD_Clear();
     }
+    break;
+  }
+  default:
+    break;
+  }
 
-    // ⭐ 10ms 대신 짧게
-    for (volatile int i = 0; i < 1000; i++)
-      ;
+  // ⭐ 메시지는 화면 위에 덮어쓰기, 사라지면 게으른 화면(메뉴)은 다시 그림
+  if (Toast_Render()) {
+    Menu_Invalidate(&ui_menu);
+  }
+
+  // ⭐ 이번 패스에서 바뀐 칸만 LCD로 전송
+  PROF_START(t_flush);
+  LCD_Flush();
+  PROF_STOP(t_flush, PROF_Z_LCD_FLUSH);
+}
+
+// ========== 메인 루프 ==========
+void apMain(void) {
+  LCD_Clear();
+  Console_Init(&console, console_cmds,
+               sizeof(console_cmds) / sizeof(console_cmds[0]));
+
+  // ⭐ 제어 경로는 고정 주기, UI는 남는 시간에
+  //    (phase를 어긋나게 줘서 같은 tick에 몰리지 않게)
+  Sched_Init();
+  Sched_Add("level", Task_Level, 5, 0, SCHED_PRIO_CONTROL);
+  Sched_Add("ctrl", Task_Control, CONTROL_PERIOD_MS, 1, SCHED_PRIO_CONTROL);
+  Sched_Add("log", Task_Log, 1000, 3, SCHED_PRIO_NORMAL);
+  Sched_Add("rtc", Task_RTC, 1000, 2, SCHED_PRIO_NORMAL);
+  Sched_Add("dht", Task_DHT11, 5, 4, SCHED_PRIO_NORMAL);
+  task_dht_start =
+      Sched_Add("dht_st", Task_DHT11_Start, 2000, 2000, SCHED_PRIO_NORMAL);
+  Sched_Add("timer", Task_Timers, 10, 6, SCHED_PRIO_NORMAL);
+  Sched_Add("ui", Task_UI, 20, 8, SCHED_PRIO_UI);
+  Sched_Add("export", Task_Export, 20, 13, SCHED_PRIO_UI);
+  Sched_Add("tlm", Task_Telemetry, 1000, 5, SCHED_PRIO_NORMAL);
+  Sched_Add("console", Task_Console, 20, 11, SCHED_PRIO_UI);
+  task_modbus = Sched_Add("modbus", Task_Modbus, 1, 0, SCHED_PRIO_NORMAL);
+  Sched_Enable(task_modbus, 0); // 'modbus' 명령 때 켬
+  Sched_Add("flash", Task_FlashService, 1000, 7, SCHED_PRIO_UI);
+
+  while (1) {
+    Sched_Dispatch();
   }
 }
\ No newline at end of file
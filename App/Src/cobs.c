@@ -0,0 +1,45 @@
+#include "cobs.h"
+
+uint16_t COBS_Encode(const uint8_t *src, uint16_t len, uint8_t *dst) {
+  uint16_t code_pos = 0; // 현재 블록의 코드 바이트 위치
+  uint16_t out = 1;
+  uint8_t code = 1;
+
+  for (uint16_t i = 0; i < len; i++) {
+    if (src[i] == 0) {
+      dst[code_pos] = code;
+      code_pos = out++;
+      code = 1;
+    } else {
+      dst[out++] = src[i];
+      if (++code == 0xFF) { // 254바이트 꽉 찬 블록
+        dst[code_pos] = code;
+        code_pos = out++;
+        code = 1;
+      }
+    }
+  }
+  dst[code_pos] = code;
+  return out;
+}
+
+uint16_t COBS_Decode(const uint8_t *src, uint16_t len, uint8_t *dst) {
+  uint16_t in = 0;
+  uint16_t out = 0;
+
+  while (in < len) {
+    uint8_t code = src[in++];
+    if (code == 0 || (uint16_t)(in + code - 1) > len)
+      return 0;
+
+    for (uint8_t k = 1; k < code; k++) {
+      if (src[in] == 0)
+        return 0;
+      dst[out++] = src[in++];
+    }
+    // 0xFF 블록 뒤와 마지막 블록 뒤에는 0 이 없음
+    if (code != 0xFF && in < len)
+      dst[out++] = 0;
+  }
+  return out;
+}
@@ -0,0 +1,85 @@
+#include "console.h"
+#include <stdio.h>
+#include <string.h>
+
+void Console_Init(Console_t *c, const Console_Cmd_t *cmds, uint8_t n_cmds) {
+  memset(c, 0, sizeof(*c));
+  c->cmds = cmds;
+  c->n_cmds = n_cmds;
+}
+
+void Console_PrintHelp(const Console_t *c) {
+  for (uint8_t i = 0; i < c->n_cmds; i++) {
+    printf("  %s\r\n", c->cmds[i].usage);
+  }
+}
+
+// 제자리에서 공백 기준으로 자름. 인자가 너무 많으면 CONSOLE_MAX_ARGS + 1
+static uint8_t split_args(char *line, char **argv) {
+  uint8_t argc = 0;
+  char *p = line;
+
+  while (*p) {
+    while (*p == ' ' || *p == '\t')
+      *p++ = '\0';
+    if (!*p)
+      break;
+    if (argc == CONSOLE_MAX_ARGS)
+      return CONSOLE_MAX_ARGS + 1;
+    argv[argc++] = p;
+    while (*p && *p != ' ' && *p != '\t')
+      p++;
+  }
+  return argc;
+}
+
+static void execute(Console_t *c) {
+  char *argv[CONSOLE_MAX_ARGS];
+  uint8_t argc = split_args(c->line, argv);
+
+  if (argc == 0)
+    return;
+  if (argc > CONSOLE_MAX_ARGS) {
+    c->errors++;
+    printf("ERR too many args\r\n");
+    return;
+  }
+
+  for (uint8_t i = 0; i < c->n_cmds; i++) {
+    if (strcmp(argv[0], c->cmds[i].name) == 0) {
+      c->lines++;
+      c->cmds[i].fn(argc, argv);
+      return;
+    }
+  }
+
+  c->errors++;
+  printf("ERR unknown '%s' (help)\r\n", argv[0]);
+}
+
+void Console_Feed(Console_t *c, const uint8_t *data, uint16_t len) {
+  for (uint16_t i = 0; i < len; i++) {
+    uint8_t ch = data[i];
+
+    if (ch == '\r' || ch == '\n') {
+      if (c->overflow) {
+        c->errors++;
+        printf("ERR line too long\r\n");
+      } else if (c->len > 0) {
+        c->line[c->len] = '\0';
+        execute(c);
+      }
+      c->len = 0;
+      c->overflow = 0;
+    } else if (ch == 0x08 || ch == 0x7F) {
+      if (c->len > 0)
+        c->len--;
+    } else if (ch >= 0x20 && ch < 0x7F) {
+      if (c->len < CONSOLE_LINE_MAX - 1)
+        c->line[c->len++] = (char)ch;
+      else
+        c->overflow = 1;
+    }
+    // 그 밖의 제어 문자는 무시
+  }
+}
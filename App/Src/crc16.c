@@ -0,0 +1,33 @@
+#include "crc16.h"
+
+// 니블 단위 테이블 (32바이트, 바이트당 2번 조회)
+static const uint16_t crc16_nibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF};
+
+uint16_t CRC16_Update(uint16_t crc, const void *data, uint32_t len) {
+  const uint8_t *p = (const uint8_t *)data;
+
+  while (len--) {
+    crc = (uint16_t)((crc << 4) ^ crc16_nibble[(crc >> 12) ^ (*p >> 4)]);
+    crc = (uint16_t)((crc << 4) ^ crc16_nibble[(crc >> 12) ^ (*p & 0x0F)]);
+    p++;
+  }
+  return crc;
+}
+
+// 반사(LSB 먼저) 니블 테이블
+static const uint16_t crc16_modbus_nibble[16] = {
+    0x0000, 0xCC01, 0xD801, 0x1400, 0xF001, 0x3C00, 0x2800, 0xE401,
+    0xA001, 0x6C00, 0x7800, 0xB401, 0x5000, 0x9C01, 0x8801, 0x4400};
+
+uint16_t CRC16_ModbusUpdate(uint16_t crc, const void *data, uint32_t len) {
+  const uint8_t *p = (const uint8_t *)data;
+
+  while (len--) {
+    crc = (uint16_t)((crc >> 4) ^ crc16_modbus_nibble[(crc ^ *p) & 0x0F]);
+    crc = (uint16_t)((crc >> 4) ^ crc16_modbus_nibble[(crc ^ (*p >> 4)) & 0x0F]);
+    p++;
+  }
+  return crc;
+}
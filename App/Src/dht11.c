@@ -3,88 +3,197 @@
 #include "tim.h"
 #include <stdio.h>
 
-// 마이크로초 지연 함수 (htim2 사용)
-void delay_us(uint16_t us) {
-    __HAL_TIM_SET_COUNTER(&htim2, 0);
-    while (__HAL_TIM_GET_COUNTER(&htim2) < us);
-}
+// =======================================
+// 입력 캡처 기반 DHT11 드라이버
+// =======================================
+// 1. DHT11_Start(): 핀을 LOW로 내리고 시각만 기록 (HAL_Delay 없음)
+// 2. DHT11_Process(): 20ms 지나면 핀을 TIM3_CH4 입력 캡처로 전환 (라인 해제)
+// 3. ISR: 하강 에지마다 TIM3 카운터(1us) 기록
+// 4. DHT11_Process(): 에지가 다 모이면 펄스 폭 → 비트 → 바이트 디코딩
+//
+// 하강 에지 순서:
+//   F0: 센서 응답 시작 (80us LOW + 80us HIGH)
+//   F1: 비트0 시작 ... F41: 비트39 끝
+//   비트 i 길이 = F(i+2) - F(i+1) = 50us LOW + HIGH(26~28us: 0 / 70us: 1)
+#define DHT11_EDGES 42
+#define DHT11_BIT_THRESHOLD_US 100 // 0: ~77us, 1: ~120us
+#define DHT11_RESP_MIN_US 120      // F0 → F1 (정상 ~160us)
+#define DHT11_RESP_MAX_US 220
 
-void DHT11_Init(void) {
-    HAL_TIM_Base_Start(&htim2);
-    
+typedef enum {
+    DHT11_ST_IDLE = 0,
+    DHT11_ST_START_LOW,
+    DHT11_ST_CAPTURE,
+    DHT11_ST_DONE
+} DHT11_State_t;
+
+static DHT11_State_t dht_state = DHT11_ST_IDLE;
+static DHT11_Status_t dht_result = DHT11_IDLE;
+static uint32_t dht_t0 = 0;
+static uint32_t dht_ready_tick = 0;
+
+static volatile uint16_t dht_edges[DHT11_EDGES];
+static volatile uint8_t dht_edge_count = 0;
+
+static DHT11_Data_t dht_last = {0};
+static DHT11_Data_t dht_last_good = {0};
+static uint32_t dht_last_good_tick = 0;
+static uint8_t dht_has_good = 0;
+
+static void DHT11_PinOutputLow(void) {
     GPIO_InitTypeDef GPIO_InitStruct = {0};
     GPIO_InitStruct.Pin = DHT11_PIN;
-    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
-    GPIO_InitStruct.Pull = GPIO_PULLUP; // 기본 상태 HIGH 유지
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
+    GPIO_InitStruct.Pull = GPIO_PULLUP;
     GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    HAL_GPIO_WritePin(DHT11_PORT, DHT11_PIN, GPIO_PIN_RESET);
     HAL_GPIO_Init(DHT11_PORT, &GPIO_InitStruct);
-    
-    HAL_GPIO_WritePin(DHT11_PORT, DHT11_PIN, GPIO_PIN_SET);
-    HAL_Delay(1000); // 센서 안정화
 }
 
-uint8_t DHT11_Read(DHT11_Data_t *data) {
-    uint8_t dht_data[5] = {0};
-    uint32_t timeout = 0;
+// 라인 해제 (풀업으로 HIGH) + TIM3_CH4 입력으로 연결
+static void DHT11_PinCapture(void) {
     GPIO_InitTypeDef GPIO_InitStruct = {0};
-
-    // 1. MCU 시작 신호 전송
     GPIO_InitStruct.Pin = DHT11_PIN;
-    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
-    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Pull = GPIO_PULLUP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    GPIO_InitStruct.Alternate = GPIO_AF2_TIM3;
     HAL_GPIO_Init(DHT11_PORT, &GPIO_InitStruct);
+}
 
-    HAL_GPIO_WritePin(DHT11_PORT, DHT11_PIN, GPIO_PIN_RESET);
-    HAL_Delay(18); // 최소 18ms 유지
-    HAL_GPIO_WritePin(DHT11_PORT, DHT11_PIN, GPIO_PIN_SET);
-    delay_us(30);  // 20~40us 대기
+// TIM3는 서보 PWM(20ms 주기)과 공유 → 카운터 wrap 고려한 차이
+static uint16_t DHT11_Elapsed(uint16_t from, uint16_t to) {
+    uint32_t period = htim3.Init.Period + 1;
+    return (to >= from) ? (to - from) : (uint16_t)(to + period - from);
+}
 
-    // 2. MCU 수신 모드로 전환
-    GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
-    GPIO_InitStruct.Pull = GPIO_PULLUP;
-    HAL_GPIO_Init(DHT11_PORT, &GPIO_InitStruct);
+static uint8_t DHT11_Decode(DHT11_Data_t *data) {
+    uint8_t dht_data[5] = {0};
 
-    // 3. 센서 응답 확인 (LOW -> HIGH)
-    timeout = 0;
-    while(HAL_GPIO_ReadPin(DHT11_PORT, DHT11_PIN) == GPIO_PIN_SET) {
-        if(++timeout > 10000) return 0; // 응답 없음
+    uint16_t resp = DHT11_Elapsed(dht_edges[0], dht_edges[1]);
+    if (resp < DHT11_RESP_MIN_US || resp > DHT11_RESP_MAX_US) {
+        return 0; // 응답 신호 이상
     }
-    timeout = 0;
-    while(HAL_GPIO_ReadPin(DHT11_PORT, DHT11_PIN) == GPIO_PIN_RESET) {
-        if(++timeout > 10000) return 0;
+
+    for (int bit = 0; bit < 40; bit++) {
+        uint16_t width = DHT11_Elapsed(dht_edges[bit + 1], dht_edges[bit + 2]);
+        if (width > DHT11_BIT_THRESHOLD_US) {
+            dht_data[bit / 8] |= (1 << (7 - (bit % 8)));
+        }
     }
-    timeout = 0;
-    while(HAL_GPIO_ReadPin(DHT11_PORT, DHT11_PIN) == GPIO_PIN_SET) {
-        if(++timeout > 10000) return 0;
+
+    // 체크섬 확인
+    if (dht_data[4] != (uint8_t)(dht_data[0] + dht_data[1] + dht_data[2] + dht_data[3])) {
+        return 0;
     }
 
-    // 4. 40비트 데이터 읽기
-    for(int j = 0; j < 5; j++) {
-        for(int i = 7; i >= 0; i--) {
-            // 비트 시작 (LOW 대기)
-            while(HAL_GPIO_ReadPin(DHT11_PORT, DHT11_PIN) == GPIO_PIN_RESET);
-            
-            // 비트 길이 측정 (HIGH 유지 시간)
-            delay_us(40); // 40us 대기 후 샘플링
-            
-            if(HAL_GPIO_ReadPin(DHT11_PORT, DHT11_PIN) == GPIO_PIN_SET) {
-                dht_data[j] |= (1 << i);
-                // 나머지 HIGH 시간 대기 (타임아웃 처리)
-                timeout = 0;
-                while(HAL_GPIO_ReadPin(DHT11_PORT, DHT11_PIN) == GPIO_PIN_SET) {
-                    if(++timeout > 10000) return 0;
-                }
-            }
+    data->humidity = dht_data[0];
+    data->humidity_dec = dht_data[1];
+    data->temperature = dht_data[2];
+    data->temperature_dec = dht_data[3] & 0x7F; // bit7: 영하 표시 (사용 범위 0~50°C)
+    data->checksum_ok = 1;
+    return 1;
+}
+
+static void DHT11_Finish(DHT11_Status_t result) {
+    HAL_TIM_IC_Stop_IT(&htim3, TIM_CHANNEL_4);
+    dht_result = result;
+    dht_state = DHT11_ST_DONE;
+
+    if (result == DHT11_DONE_OK) {
+        dht_last_good = dht_last;
+        dht_last_good_tick = HAL_GetTick();
+        dht_has_good = 1;
+    }
+}
+
+void DHT11_Init(void) {
+    // 기본 상태: 라인 HIGH (풀업), 1초 동안은 측정 시작 안 함 (HAL_Delay 제거)
+    DHT11_PinCapture();
+    dht_state = DHT11_ST_IDLE;
+    dht_result = DHT11_IDLE;
+    dht_ready_tick = HAL_GetTick() + DHT11_POWERUP_MS;
+}
+
+uint8_t DHT11_Start(void) {
+    if (dht_state == DHT11_ST_START_LOW || dht_state == DHT11_ST_CAPTURE) {
+        return 0;
+    }
+    if ((int32_t)(HAL_GetTick() - dht_ready_tick) < 0) {
+        return 0; // 센서 안정화 중
+    }
+
+    // 1. MCU 시작 신호: LOW 유지 (해제는 DHT11_Process에서)
+    DHT11_PinOutputLow();
+    dht_t0 = HAL_GetTick();
+    dht_state = DHT11_ST_START_LOW;
+    dht_result = DHT11_BUSY;
+    return 1;
+}
+
+void DHT11_Process(void) {
+    uint32_t now = HAL_GetTick();
+
+    switch (dht_state) {
+    case DHT11_ST_START_LOW:
+        if (now - dht_t0 >= DHT11_START_LOW_MS) {
+            // 2. 하강 에지 캡처 시작 후 라인 해제 (해제는 상승 에지라 캡처 안 됨)
+            dht_edge_count = 0;
+            __HAL_TIM_CLEAR_FLAG(&htim3, TIM_FLAG_CC4);
+            HAL_TIM_IC_Start_IT(&htim3, TIM_CHANNEL_4);
+            DHT11_PinCapture();
+            dht_t0 = now;
+            dht_state = DHT11_ST_CAPTURE;
+        }
+        break;
+
+    case DHT11_ST_CAPTURE:
+        if (dht_edge_count >= DHT11_EDGES) {
+            // 3. 40비트 디코딩 + 체크섬
+            DHT11_Finish(DHT11_Decode(&dht_last) ? DHT11_DONE_OK : DHT11_DONE_ERROR);
+        } else if (now - dht_t0 > DHT11_TIMEOUT_MS) {
+            DHT11_Finish(DHT11_DONE_ERROR); // 응답 없음 / 에지 누락
         }
+        break;
+
+    default:
+        break;
+    }
+}
+
+DHT11_Status_t DHT11_Collect(DHT11_Data_t *data) {
+    if (dht_state != DHT11_ST_DONE) {
+        return dht_result;
     }
 
-    // 5. 체크섬 확인
-    if(dht_data[4] == (uint8_t)(dht_data[0] + dht_data[1] + dht_data[2] + dht_data[3])) {
-        data->humidity = dht_data[0];
-        data->temperature = dht_data[2];
-        return 1;
+    DHT11_Status_t result = dht_result;
+    if (result == DHT11_DONE_OK && data) {
+        *data = dht_last;
     }
+    dht_state = DHT11_ST_IDLE;
+    dht_result = DHT11_IDLE;
+    return result;
+}
 
+// ⭐ NFR-02: 마지막 정상값 + 경과 시간
+uint8_t DHT11_GetLastGood(DHT11_Data_t *data, uint32_t *age_ms) {
+    if (!dht_has_good) {
+        return 0;
+    }
+    if (data) {
+        *data = dht_last_good;
+    }
+    if (age_ms) {
+        *age_ms = HAL_GetTick() - dht_last_good_tick;
+    }
+    return 1;
+}
 
-    return 0;
-}
\ No newline at end of file
+// TIM3 CH4 하강 에지 (ISR)
+void DHT11_CaptureISR(uint16_t capture) {
+    uint8_t n = dht_edge_count;
+    if (n < DHT11_EDGES) {
+        dht_edges[n] = capture;
+        dht_edge_count = n + 1;
+    }
+}
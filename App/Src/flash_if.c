@@ -0,0 +1,64 @@
+#include "flash_if.h"
+#include "main.h"
+#include <string.h>
+
+static uint32_t FlashIf_Addr(uint8_t sector, uint32_t offset) {
+  return (sector ? FLASH_IF_SECTOR1_ADDR : FLASH_IF_SECTOR0_ADDR) + offset;
+}
+
+// 내부 플래시는 메모리 맵 → 그냥 복사
+static int FlashIf_Read(uint8_t sector, uint32_t offset, void *buf,
+                        uint32_t len) {
+  if (sector > 1 || offset + len > FLASH_IF_SECTOR_SIZE)
+    return -1;
+  memcpy(buf, (const void *)(uintptr_t)FlashIf_Addr(sector, offset), len);
+  return 0;
+}
+
+static int FlashIf_Program(uint8_t sector, uint32_t offset, const void *data,
+                           uint32_t len) {
+  if (sector > 1 || (offset & 3u) || (len & 3u) ||
+      offset + len > FLASH_IF_SECTOR_SIZE)
+    return -1;
+
+  const uint8_t *src = (const uint8_t *)data;
+  uint32_t addr = FlashIf_Addr(sector, offset);
+  int ret = 0;
+
+  HAL_FLASH_Unlock();
+  for (uint32_t i = 0; i < len; i += 4) {
+    uint32_t word;
+    memcpy(&word, &src[i], 4);
+    if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr + i, word) != HAL_OK) {
+      ret = -1;
+      break;
+    }
+  }
+  HAL_FLASH_Lock();
+  return ret;
+}
+
+// ⭐ 128KB 섹터 삭제는 1~2초, 단일 뱅크라 그 동안 CPU도 멈춤
+static int FlashIf_Erase(uint8_t sector) {
+  if (sector > 1)
+    return -1;
+
+  FLASH_EraseInitTypeDef erase = {0};
+  uint32_t sector_error = 0;
+  erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+  erase.Sector = sector ? FLASH_SECTOR_7 : FLASH_SECTOR_6;
+  erase.NbSectors = 1;
+  erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+  HAL_FLASH_Unlock();
+  HAL_StatusTypeDef st = HAL_FLASHEx_Erase(&erase, &sector_error);
+  HAL_FLASH_Lock();
+  return (st == HAL_OK) ? 0 : -1;
+}
+
+const FlashIf_Ops_t flash_if_stm32 = {
+    .sector_size = FLASH_IF_SECTOR_SIZE,
+    .read = FlashIf_Read,
+    .program = FlashIf_Program,
+    .erase = FlashIf_Erase,
+};
@@ -0,0 +1,74 @@
+#include "gate_actuator.h"
+#include "latency.h"
+#include "tim.h"
+#include <stdio.h>
+
+static Gate_Stats_t gates[GATE_COUNT];
+
+static const uint32_t gate_channel[GATE_COUNT] = {TIM_CHANNEL_1,
+                                                  TIM_CHANNEL_2};
+
+// ========== 하드웨어 기록 ==========
+// 0도 = 1000us, 90도 = 2000us
+static void gate_write(Gate_t gate, uint8_t angle) {
+  uint16_t pulse = 1000 + (angle * 1000 / 90);
+  __HAL_TIM_SET_COMPARE(&htim3, gate_channel[gate], pulse);
+  LAT_ACTUATE();
+}
+
+void Gate_Init(void) {
+  for (uint8_t g = 0; g < GATE_COUNT; g++) {
+    gates[g].angle = GATE_ANGLE_UNKNOWN;
+    gates[g].moves = 0;
+    gates[g].open_ms = 0;
+    gates[g].open_since = 0;
+    gate_write((Gate_t)g, GATE_ANGLE_CLOSED);
+    gates[g].angle = GATE_ANGLE_CLOSED;
+  }
+}
+
+uint8_t Gate_Set(Gate_t gate, uint8_t angle) {
+  if (gate >= GATE_COUNT)
+    return 0;
+
+  Gate_Stats_t *st = &gates[gate];
+  if (st->angle == angle)
+    return 0; // ⭐ 변화 없음 → CCR, UART 모두 건드리지 않음
+
+  uint32_t now = HAL_GetTick();
+  uint8_t was_open = (st->angle != GATE_ANGLE_UNKNOWN) &&
+                     (st->angle != GATE_ANGLE_CLOSED);
+  uint8_t will_open = (angle != GATE_ANGLE_CLOSED);
+
+  if (was_open && !will_open) {
+    st->open_ms += now - st->open_since;
+  } else if (!was_open && will_open) {
+    st->open_since = now;
+  }
+
+  gate_write(gate, angle);
+  printf("[GATE%d] %d -> %d deg (moves: %lu)\r\n", gate + 1, st->angle, angle,
+         (unsigned long)(st->moves + 1));
+
+  st->angle = angle;
+  st->moves++;
+  return 1;
+}
+
+uint8_t Gate_GetAngle(Gate_t gate) {
+  return (gate < GATE_COUNT) ? gates[gate].angle : GATE_ANGLE_UNKNOWN;
+}
+
+uint8_t Gate_IsOpen(Gate_t gate) {
+  return (gate < GATE_COUNT) && (gates[gate].angle != GATE_ANGLE_CLOSED);
+}
+
+void Gate_GetStats(Gate_t gate, Gate_Stats_t *out) {
+  if (gate >= GATE_COUNT)
+    return;
+
+  *out = gates[gate];
+  if (Gate_IsOpen(gate)) {
+    out->open_ms += HAL_GetTick() - gates[gate].open_since;
+  }
+}
@@ -5,10 +5,109 @@
 
 extern I2C_HandleTypeDef hi2c1; // main.c에 정의된 핸들러 가져오기
 
-#define SLAVE_ADDRESS_LCD 0x4E // 0x27 주소 << 1 = 0x4E (또는 0x3F << 1 = 0x7E)
-
 static uint8_t lcd_backlight = LCD_BACKLIGHT;
 
+// ========== 섀도 프레임버퍼 ==========
+// ap.c는 lcd_shadow에만 쓰고, LCD_Flush()가 lcd_glass(실제 LCD에 보낸 내용)와
+// 비교해서 바뀐 구간만 I2C로 전송한다.
+#define LCD_ADDR_UNKNOWN 0xFF
+#define LCD_FLUSH_MERGE_GAP 1 // 커서 이동(4바이트) = 글자 1개(4바이트)
+#define LCD_STREAM_MAX (4 + LCD_COLS * 4) // 커서 명령 1개 + 한 줄
+
+static const uint8_t lcd_row_offsets[LCD_ROWS] = {0x00, 0x40};
+
+static char lcd_shadow[LCD_ROWS][LCD_COLS]; // 다음 프레임
+static char lcd_glass[LCD_ROWS][LCD_COLS];  // LCD에 표시 중인 프레임
+static uint8_t fb_row = 0;
+static uint8_t fb_col = 0;
+static uint8_t lcd_hw_addr = LCD_ADDR_UNKNOWN; // LCD 내부 DDRAM 주소 추적
+
+// ========== 비동기 전송 큐 ==========
+// 메인 루프는 니블 바이트를 큐에 넣기만 하고, 실제 전송은 I2C 인터럽트가
+// 이어서 처리한다. 대기 중인 연속 구간은 한 번의 I2C 전송으로 묶어 보낸다.
+static uint8_t lcd_txq[LCD_TXQ_SIZE];
+static volatile uint16_t lcd_txq_head = 0;     // 쓰기 위치 (메인 루프만 변경)
+static volatile uint16_t lcd_txq_tail = 0;     // 읽기 위치 (ISR만 변경)
+static volatile uint16_t lcd_txq_inflight = 0; // 전송 중인 바이트 수
+static volatile uint8_t lcd_resync = 0;        // I2C 오류 → 화면 다시 그리기
+static LCD_TxStats_t lcd_tx_stats;
+
+static uint16_t LCD_TxDepth(void) {
+  return (uint16_t)(lcd_txq_head - lcd_txq_tail);
+}
+
+static uint16_t LCD_TxFree(void) { return LCD_TXQ_SIZE - LCD_TxDepth(); }
+
+// 대기 중인 데이터가 있고 버스가 놀고 있으면 다음 구간 전송 시작
+static void LCD_TxKick(void) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  uint16_t depth = LCD_TxDepth();
+  if (lcd_txq_inflight == 0 && depth > 0) {
+    uint16_t pos = lcd_txq_tail & (LCD_TXQ_SIZE - 1);
+    uint16_t len = LCD_TXQ_SIZE - pos; // 버퍼 끝에서 잘림
+    if (len > depth)
+      len = depth;
+
+    lcd_txq_inflight = len;
+    if (HAL_I2C_Master_Transmit_IT(&hi2c1, LCD_I2C_ADDR, &lcd_txq[pos], len) !=
+        HAL_OK) {
+      // 버스가 바쁘면 다음 Kick에서 재시도
+      lcd_txq_inflight = 0;
+    }
+  }
+
+  __set_PRIMASK(primask);
+}
+
+// 전부 들어가거나 전혀 안 들어감 (니블 시퀀스가 중간에 잘리면 안 됨)
+static uint8_t LCD_TxEnqueue(const uint8_t *data, uint16_t len) {
+  if (LCD_TxFree() < len) {
+    lcd_tx_stats.overflow++;
+    return 0;
+  }
+
+  uint16_t head = lcd_txq_head;
+  for (uint16_t i = 0; i < len; i++) {
+    lcd_txq[(head + i) & (LCD_TXQ_SIZE - 1)] = data[i];
+  }
+  lcd_txq_head = head + len; // 다 쓴 뒤에 공개
+
+  uint16_t depth = LCD_TxDepth();
+  if (depth > lcd_tx_stats.high_water)
+    lcd_tx_stats.high_water = depth;
+
+  LCD_TxKick();
+  return 1;
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+  if (hi2c->Instance != I2C1)
+    return;
+  lcd_txq_tail += lcd_txq_inflight;
+  lcd_tx_stats.bytes += lcd_txq_inflight;
+  lcd_tx_stats.bursts++;
+  lcd_txq_inflight = 0;
+  LCD_TxKick();
+}
+
+// ⭐ 오류(NACK 등) 시 해당 구간은 버리고 다음 Flush에서 전체 재전송
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+  if (hi2c->Instance != I2C1)
+    return;
+  lcd_txq_tail += lcd_txq_inflight;
+  lcd_tx_stats.errors++;
+  lcd_txq_inflight = 0;
+  lcd_resync = 1;
+  LCD_TxKick();
+}
+
+void LCD_GetTxStats(LCD_TxStats_t *stats) {
+  *stats = lcd_tx_stats;
+  stats->depth = LCD_TxDepth();
+}
+
 void LCD_SendCmd(char cmd) {
   char data_u, data_l;
   uint8_t data_t[4];
@@ -18,7 +117,7 @@ void LCD_SendCmd(char cmd) {
   data_t[1] = data_u | 0x08; // en=0, rs=0
   data_t[2] = data_l | 0x0C; // en=1, rs=0
   data_t[3] = data_l | 0x08; // en=0, rs=0
-  HAL_I2C_Master_Transmit(&hi2c1, SLAVE_ADDRESS_LCD, data_t, 4, 100);
+  LCD_TxEnqueue(data_t, 4);
 }
 
 void LCD_SendData(char data) {
@@ -30,20 +129,25 @@ void LCD_SendData(char data) {
   data_t[1] = data_u | 0x09; // en=0, rs=1
   data_t[2] = data_l | 0x0D; // en=1, rs=1
   data_t[3] = data_l | 0x09; // en=0, rs=1
-  HAL_I2C_Master_Transmit(&hi2c1, SLAVE_ADDRESS_LCD, (uint8_t *)data_t, 4, 100);
+  LCD_TxEnqueue(data_t, 4);
 }
 
-static void LCD_SendInternal(uint8_t data, uint8_t flags) {
+// 한 바이트(명령/글자)를 PCF8574 니블 4바이트로 펼침
+static uint8_t LCD_PackByte(uint8_t *dst, uint8_t data, uint8_t flags) {
   uint8_t up = data & 0xF0;
   uint8_t lo = (data << 4) & 0xF0;
 
-  uint8_t data_arr[4];
-  data_arr[0] = up | flags | En | lcd_backlight;
-  data_arr[1] = up | flags | lcd_backlight;
-  data_arr[2] = lo | flags | En | lcd_backlight;
-  data_arr[3] = lo | flags | lcd_backlight;
+  dst[0] = up | flags | En | lcd_backlight;
+  dst[1] = up | flags | lcd_backlight;
+  dst[2] = lo | flags | En | lcd_backlight;
+  dst[3] = lo | flags | lcd_backlight;
+  return 4;
+}
 
-  HAL_I2C_Master_Transmit(&hi2c1, LCD_I2C_ADDR, data_arr, 4, 100);
+static void LCD_SendInternal(uint8_t data, uint8_t flags) {
+  uint8_t data_arr[4];
+  LCD_PackByte(data_arr, data, flags);
+  LCD_TxEnqueue(data_arr, 4);
 }
 
 static void LCD_SendCommand(uint8_t cmd) { LCD_SendInternal(cmd, 0); }
@@ -74,6 +178,13 @@ void LCD_Init(void) {
   HAL_Delay(1);
 
   LCD_SendCmd(0x0C); // Display On, Cursor Off, Blink Off
+
+  // ⭐ Clear 직후 LCD는 공백 + 주소 0 상태
+  memset(lcd_glass, ' ', sizeof(lcd_glass));
+  memset(lcd_shadow, ' ', sizeof(lcd_shadow));
+  fb_row = 0;
+  fb_col = 0;
+  lcd_hw_addr = 0;
 }
 void LCD_Init2(void) {
   LCD_SendCmd(0x33); // 초기화 시퀀스
@@ -91,9 +202,19 @@ void LCD_Init2(void) {
   HAL_Delay(50);
 }
 
+// ⭐ LCD_SendString / LCD_PutCur 는 프레임버퍼를 거치지 않는 직접 출력
+// ⭐ 글자마다 4바이트 전송하지 않고, 최대 한 줄 분량을 한 번에 큐에 넣음
 void LCD_SendString(char *str) {
-  while (*str)
-    LCD_SendData(*str++);
+  uint8_t stream[LCD_STREAM_MAX];
+
+  while (*str) {
+    uint16_t n = 0;
+    for (uint8_t i = 0; i < LCD_COLS && *str; i++) {
+      n += LCD_PackByte(&stream[n], (uint8_t)*str++, Rs);
+    }
+    LCD_TxEnqueue(stream, n);
+  }
+  lcd_hw_addr = LCD_ADDR_UNKNOWN;
 }
 
 void LCD_PutCur(int row, int col) {
@@ -106,25 +227,95 @@ void LCD_PutCur(int row, int col) {
     break;
   }
   LCD_SendCmd(col);
+  lcd_hw_addr = LCD_ADDR_UNKNOWN;
 }
 
+// ⭐ 버퍼만 지움 (0x01 명령 + 2ms 대기 없음, 실제 반영은 LCD_Flush)
 void LCD_Clear(void) {
-  LCD_SendCmd(0x01); // 전체 지우기
-  HAL_Delay(2);
+  memset(lcd_shadow, ' ', sizeof(lcd_shadow));
+  fb_row = 0;
+  fb_col = 0;
 }
 
 void LCD_SetCursor(uint8_t row, uint8_t col) {
-  uint8_t row_offsets[] = {0x00, 0x40};
-  if (row >= 2)
+  if (row >= LCD_ROWS)
     row = 0;
-  if (col >= 16)
+  if (col >= LCD_COLS)
     col = 0;
-  LCD_SendCommand(LCD_SETDDRAM_ADDR | (col + row_offsets[row]));
+  fb_row = row;
+  fb_col = col;
 }
 
+// ⭐ 16칸을 넘는 글자는 원래도 화면 밖 DDRAM에 써져서 보이지 않았음 → 버림
 void LCD_Print(const char *str) {
-  while (*str) {
-    LCD_SendData(*str++);
+  while (*str && fb_col < LCD_COLS) {
+    lcd_shadow[fb_row][fb_col++] = *str++;
+  }
+}
+
+// ========== 프레임 전송 ==========
+// 행마다 바뀐 구간(run)을 찾아 커서 이동 + 데이터만 보낸다.
+// 사이에 안 바뀐 칸이 LCD_FLUSH_MERGE_GAP 이하이면 커서 명령 대신 다시 쓴다.
+// 쓰고 나면 DDRAM 주소가 자동 증가하므로 이어지는 구간은 커서 명령 생략.
+// 큐 공간이 모자라면 남은 구간은 다음 Flush로 미룬다 (glass는 보낸 것만 반영).
+void LCD_Flush(void) {
+  if (lcd_resync) {
+    lcd_resync = 0;
+    memset(lcd_glass, 0, sizeof(lcd_glass)); // 모든 칸을 "바뀜"으로
+    lcd_hw_addr = LCD_ADDR_UNKNOWN;
+  }
+
+  for (uint8_t row = 0; row < LCD_ROWS; row++) {
+    char *shadow = lcd_shadow[row];
+    char *glass = lcd_glass[row];
+    uint8_t col = 0;
+
+    while (col < LCD_COLS) {
+      if (shadow[col] == glass[col]) {
+        col++;
+        continue;
+      }
+
+      uint8_t start = col;
+      uint8_t end = col + 1;
+      for (uint8_t c = col + 1; c < LCD_COLS; c++) {
+        if (shadow[c] != glass[c]) {
+          end = c + 1;
+        } else if (c + 1 - end > LCD_FLUSH_MERGE_GAP) {
+          break;
+        }
+      }
+
+      // ⭐ 커서 이동 + 구간 전체를 하나의 니블 스트림으로 (I2C 1회 전송)
+      uint8_t addr = lcd_row_offsets[row] + start;
+      uint8_t stream[LCD_STREAM_MAX];
+      uint16_t n = 0;
+
+      if (lcd_hw_addr != addr) {
+        n += LCD_PackByte(&stream[n], LCD_SETDDRAM_ADDR | addr, 0);
+      }
+      for (uint8_t c = start; c < end; c++) {
+        n += LCD_PackByte(&stream[n], (uint8_t)shadow[c], Rs);
+      }
+      if (!LCD_TxEnqueue(stream, n)) {
+        return; // 큐 부족 → 나머지는 다음 Flush에서
+      }
+
+      memcpy(&glass[start], &shadow[start], end - start);
+      lcd_hw_addr = addr + (end - start);
+      col = end;
+    }
+  }
+
+  LCD_TxKick(); // 이전에 버스가 바빠서 못 보낸 것 재시도
+}
+
+// 한 줄 전체를 쓰고 남은 칸은 공백으로 채움
+void LCD_PrintLine(uint8_t row, const char *str) {
+  LCD_SetCursor(row, 0);
+  LCD_Print(str);
+  while (fb_col < LCD_COLS) {
+    lcd_shadow[fb_row][fb_col++] = ' ';
   }
 }
 
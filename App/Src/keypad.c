@@ -1,5 +1,6 @@
 #include "keypad.h"
 #include "stm32f4xx_hal.h"
+#include "tim.h"
 
 // =======================================
 // STM32F4 핀 매핑 (CubeMX 기준)
@@ -17,6 +18,41 @@ char keys[4][4] = {
     {'*','0','#','D'}
 };
 
+// =======================================
+// 키별 디바운스 상태 머신
+// =======================================
+typedef enum {
+    KEY_ST_UP = 0,       // 떼어진 상태
+    KEY_ST_DOWN_PENDING, // 눌림 감지, 안정화 대기
+    KEY_ST_DOWN,         // 눌린 상태
+    KEY_ST_UP_PENDING    // 떼어짐 감지, 안정화 대기
+} KeyState_t;
+
+#define KEYPAD_DEBOUNCE_SAMPLES (KEYPAD_DEBOUNCE_MS / KEYPAD_SCAN_ROWS)
+
+static uint8_t key_state[4][4];
+static uint8_t key_count[4][4];
+static uint8_t scan_row = 0; // 현재 LOW로 내려둔 행
+
+// =======================================
+// 이벤트 큐 (ISR → 메인 루프, lock-free SPSC)
+// =======================================
+static Keypad_Event_t key_evq[KEYPAD_EVQ_SIZE];
+static volatile uint8_t key_evq_head = 0; // ISR만 변경
+static volatile uint8_t key_evq_tail = 0; // 메인 루프만 변경
+static volatile uint32_t key_evq_overflow = 0;
+
+static void Keypad_PushEvent(char key, uint8_t pressed) {
+    uint8_t head = key_evq_head;
+    if ((uint8_t)(head - key_evq_tail) >= KEYPAD_EVQ_SIZE) {
+        key_evq_overflow++;
+        return;
+    }
+    key_evq[head & (KEYPAD_EVQ_SIZE - 1)].key = key;
+    key_evq[head & (KEYPAD_EVQ_SIZE - 1)].pressed = pressed;
+    key_evq_head = head + 1; // 다 쓴 뒤에 공개
+}
+
 // =======================================
 // 키패드 초기화 (필수는 아님, CubeMX에서 설정해도 됨)
 // =======================================
@@ -25,35 +61,92 @@ void Keypad_Init(void) {
     for(int i=0;i<4;i++) {
         HAL_GPIO_WritePin(ROW_Ports[i], ROW_Pins[i], GPIO_PIN_SET);
     }
+
+    // 첫 행을 LOW로 내려두고 1ms 스캔 타이머 시작 (TIM2 CH1 출력 비교)
+    scan_row = 0;
+    HAL_GPIO_WritePin(ROW_Ports[0], ROW_Pins[0], GPIO_PIN_RESET);
+    __HAL_TIM_SET_COMPARE(&htim2, TIM_CHANNEL_1,
+                          (uint16_t)(__HAL_TIM_GET_COUNTER(&htim2) + TIM2_TICK_US));
+    HAL_TIM_OC_Start_IT(&htim2, TIM_CHANNEL_1);
 }
 
 // =======================================
-// 키 읽기 함수
+// 1ms 스캔 (TIM2 인터럽트에서 호출)
 // =======================================
-char Keypad_Read(void) {
-    char key = 0;
-
-    for(int row=0; row<4; row++) {
-        // 모든 ROW를 HIGH로 초기화
-        for(int i=0;i<4;i++)
-            HAL_GPIO_WritePin(ROW_Ports[i], ROW_Pins[i], GPIO_PIN_SET);
-
-        // 현재 ROW만 LOW로 내림
-        HAL_GPIO_WritePin(ROW_Ports[row], ROW_Pins[row], GPIO_PIN_RESET);
-        HAL_Delay(1); // 안정화 짧게 대기
-
-        // 각 컬럼 검사
-        for(int col=0; col<4; col++) {
-            if(HAL_GPIO_ReadPin(COL_Ports[col], COL_Pins[col]) == GPIO_PIN_RESET) {
-                // 디바운싱
-                HAL_Delay(50);
-                while(HAL_GPIO_ReadPin(COL_Ports[col], COL_Pins[col]) == GPIO_PIN_RESET);
-
-                key = keys[row][col];
-                return key;
+// 이전 틱에 LOW로 내린 행은 1ms 동안 안정화됐으므로 바로 읽고,
+// 다음 행으로 넘어간다. HAL_Delay/대기 루프 없음.
+void Keypad_ScanTick(void) {
+    uint8_t row = scan_row;
+
+    for(int col=0; col<4; col++) {
+        uint8_t down = (HAL_GPIO_ReadPin(COL_Ports[col], COL_Pins[col]) == GPIO_PIN_RESET);
+        uint8_t *st = &key_state[row][col];
+        uint8_t *cnt = &key_count[row][col];
+
+        switch (*st) {
+        case KEY_ST_UP:
+            if (down) {
+                *st = KEY_ST_DOWN_PENDING;
+                *cnt = 1;
+            }
+            break;
+        case KEY_ST_DOWN_PENDING:
+            if (!down) {
+                *st = KEY_ST_UP; // 채터링
+            } else if (++(*cnt) >= KEYPAD_DEBOUNCE_SAMPLES) {
+                *st = KEY_ST_DOWN;
+                Keypad_PushEvent(keys[row][col], 1);
             }
+            break;
+        case KEY_ST_DOWN:
+            if (!down) {
+                *st = KEY_ST_UP_PENDING;
+                *cnt = 1;
+            }
+            break;
+        case KEY_ST_UP_PENDING:
+            if (down) {
+                *st = KEY_ST_DOWN;
+            } else if (++(*cnt) >= KEYPAD_DEBOUNCE_SAMPLES) {
+                *st = KEY_ST_UP;
+                Keypad_PushEvent(keys[row][col], 0);
+            }
+            break;
+        }
+    }
+
+    // 다음 행 선택
+    HAL_GPIO_WritePin(ROW_Ports[row], ROW_Pins[row], GPIO_PIN_SET);
+    row = (row + 1) % KEYPAD_SCAN_ROWS;
+    HAL_GPIO_WritePin(ROW_Ports[row], ROW_Pins[row], GPIO_PIN_RESET);
+    scan_row = row;
+}
+
+uint8_t Keypad_GetEvent(Keypad_Event_t *ev) {
+    uint8_t tail = key_evq_tail;
+    if (tail == key_evq_head) {
+        return 0;
+    }
+    *ev = key_evq[tail & (KEYPAD_EVQ_SIZE - 1)];
+    key_evq_tail = tail + 1;
+    return 1;
+}
+
+// =======================================
+// 키 읽기 함수 (눌림 이벤트만, 떼어짐은 버림)
+// =======================================
+char Keypad_Read(void) {
+    Keypad_Event_t ev;
+
+    while (Keypad_GetEvent(&ev)) {
+        if (ev.pressed) {
+            return ev.key;
         }
     }
 
     return 0; // 눌린 키 없으면 0 리턴
 }
+
+uint32_t Keypad_GetOverflowCount(void) {
+    return key_evq_overflow;
+}
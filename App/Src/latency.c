@@ -0,0 +1,131 @@
+#include "latency.h"
+
+#if PROF_ENABLE
+
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+  uint32_t ring[LAT_WINDOW];
+  uint16_t head;
+  uint16_t n;
+  uint32_t count;
+  uint32_t max_all;
+} Lat_Ring_t;
+
+static Lat_Ring_t series[LAT_S_COUNT];
+
+static const char *const series_names[LAT_S_COUNT] = {
+    [LAT_S_AGE] = "age",       [LAT_S_JITTER] = "jitter",
+    [LAT_S_DECIDE] = "decide", [LAT_S_ACTUATE] = "actuate",
+    [LAT_S_END_TO_END] = "e2e",
+};
+
+// 진행 중인 측정 (상태 바뀜 → 결정 → CCR)
+static enum { LAT_IDLE, LAT_CROSSED, LAT_DECIDED } phase = LAT_IDLE;
+static uint32_t t_sample, t_decide;
+
+static uint32_t t_last_control;
+static uint8_t have_last_control = 0;
+
+static void push(Lat_Series_t s, uint32_t ticks) {
+  Lat_Ring_t *r = &series[s];
+  r->ring[r->head] = ticks;
+  r->head = (uint16_t)((r->head + 1) % LAT_WINDOW);
+  if (r->n < LAT_WINDOW)
+    r->n++;
+  r->count++;
+  if (ticks > r->max_all)
+    r->max_all = ticks;
+}
+
+void Lat_Reset(void) {
+  memset(series, 0, sizeof(series));
+  phase = LAT_IDLE;
+  have_last_control = 0;
+}
+
+void Lat_Cross(uint32_t sample_stamp) {
+  t_sample = sample_stamp;
+  phase = LAT_CROSSED;
+}
+
+void Lat_Decide(void) {
+  if (phase != LAT_CROSSED)
+    return;
+  t_decide = Prof_Now();
+  push(LAT_S_DECIDE, t_decide - t_sample);
+  phase = LAT_DECIDED;
+}
+
+void Lat_DecideEnd(void) {
+  if (phase == LAT_DECIDED)
+    phase = LAT_IDLE; // 이미 그 각도 → 움직인 수문 없음
+}
+
+void Lat_Actuate(void) {
+  if (phase != LAT_DECIDED)
+    return;
+  uint32_t now = Prof_Now();
+  push(LAT_S_ACTUATE, now - t_decide);
+  push(LAT_S_END_TO_END, now - t_sample);
+  phase = LAT_IDLE;
+}
+
+void Lat_ControlTick(uint32_t sample_stamp, uint32_t period_ms) {
+  uint32_t now = Prof_Now();
+  push(LAT_S_AGE, now - sample_stamp);
+
+  if (have_last_control) {
+    uint32_t nominal = period_ms * 1000u * Prof_TicksPerUs();
+    uint32_t interval = now - t_last_control;
+    push(LAT_S_JITTER,
+         (interval > nominal) ? interval - nominal : nominal - interval);
+  }
+  t_last_control = now;
+  have_last_control = 1;
+}
+
+// 창 복사 + 삽입 정렬 (조회할 때만, 최대 LAT_WINDOW 개)
+void Lat_Summary(Lat_Series_t s, Lat_Summary_t *out) {
+  static uint32_t sorted[LAT_WINDOW];
+  const Lat_Ring_t *r = &series[s];
+
+  memset(out, 0, sizeof(*out));
+  out->count = r->count;
+  out->max_all = r->max_all;
+  if (r->n == 0)
+    return;
+
+  memcpy(sorted, r->ring, r->n * sizeof(sorted[0]));
+  for (uint16_t i = 1; i < r->n; i++) {
+    uint32_t v = sorted[i];
+    uint16_t j = i;
+    while (j > 0 && sorted[j - 1] > v) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = v;
+  }
+
+  // 최근접 순위: p번째 = ceil(p/100 * n) 번째 값
+  out->p50 = sorted[(r->n * 50u + 99u) / 100u - 1u];
+  out->p99 = sorted[(r->n * 99u + 99u) / 100u - 1u];
+  out->max = sorted[r->n - 1];
+}
+
+void Lat_Print(void) {
+  uint32_t tpu = Prof_TicksPerUs();
+
+  printf("series     count    p50    p99    max  max_all (us)\r\n");
+  for (uint8_t s = 0; s < LAT_S_COUNT; s++) {
+    Lat_Summary_t sum;
+    Lat_Summary((Lat_Series_t)s, &sum);
+    printf("%-8s %7lu %6lu %6lu %6lu %8lu\r\n", series_names[s],
+           (unsigned long)sum.count, (unsigned long)(sum.p50 / tpu),
+           (unsigned long)(sum.p99 / tpu), (unsigned long)(sum.max / tpu),
+           (unsigned long)(sum.max_all / tpu));
+  }
+}
+
+#endif // PROF_ENABLE
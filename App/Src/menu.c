@@ -0,0 +1,95 @@
+#include "menu.h"
+#include <stdio.h>
+#include <string.h>
+
+#define MENU_ALL_ROWS ((uint8_t)((1u << LCD_ROWS) - 1))
+
+void Menu_Open(Menu_State_t *st, const Menu_t *menu, uint8_t cursor) {
+  memset(st, 0, sizeof(*st));
+  st->menu = menu;
+  st->cursor = (cursor < menu->count) ? cursor : 0;
+  st->scroll = (st->cursor >= LCD_ROWS) ? st->cursor - (LCD_ROWS - 1) : 0;
+  st->dirty = MENU_ALL_ROWS;
+}
+
+void Menu_Close(Menu_State_t *st) { st->menu = NULL; }
+
+void Menu_Invalidate(Menu_State_t *st) { st->dirty = MENU_ALL_ROWS; }
+
+// ⭐ 커서 이동 + 스크롤 (모든 메뉴 공용)
+static void menu_move(Menu_State_t *st, Menu_Input_t in) {
+  uint8_t old = st->cursor;
+
+  if (in == MENU_IN_NEXT && st->cursor + 1 < st->menu->count)
+    st->cursor++;
+  else if (in == MENU_IN_PREV && st->cursor > 0)
+    st->cursor--;
+
+  if (st->cursor == old)
+    return;
+
+  uint8_t old_scroll = st->scroll;
+  if (st->cursor >= st->scroll + LCD_ROWS)
+    st->scroll = st->cursor - (LCD_ROWS - 1);
+  else if (st->cursor < st->scroll)
+    st->scroll = st->cursor;
+
+  if (st->scroll != old_scroll) {
+    st->dirty = MENU_ALL_ROWS;
+  } else {
+    // 커서 표시만 옮김
+    st->dirty |= (uint8_t)(1u << (old - st->scroll));
+    st->dirty |= (uint8_t)(1u << (st->cursor - st->scroll));
+  }
+}
+
+static void menu_render(Menu_State_t *st) {
+  for (uint8_t row = 0; row < LCD_ROWS; row++) {
+    uint8_t idx = st->scroll + row;
+    uint8_t bit = (uint8_t)(1u << row);
+
+    if (idx >= st->menu->count) {
+      if (st->dirty & bit)
+        LCD_PrintLine(row, "");
+      continue;
+    }
+
+    const Menu_Item_t *it = &st->menu->items[idx];
+
+    // 값 칸: 처음 그릴 때와 bind 가 바뀌었을 때만 format
+    if (it->format && ((st->dirty & bit) ||
+                       (it->bind && *it->bind != st->shown[row]))) {
+      if (it->bind)
+        st->shown[row] = *it->bind;
+      it->format(st->value[row], sizeof(st->value[row]));
+      st->dirty |= bit;
+    }
+
+    if (!(st->dirty & bit))
+      continue;
+
+    char line[LCD_COLS + 1];
+    snprintf(line, sizeof(line), "%s%s%s", (idx == st->cursor) ? "[V] " : "[ ] ",
+             it->label ? it->label : "", it->format ? st->value[row] : "");
+    LCD_PrintLine(row, line);
+  }
+  st->dirty = 0;
+}
+
+void Menu_Update(Menu_State_t *st, Menu_Input_t in) {
+  if (!st->menu)
+    return;
+
+  if (in == MENU_IN_SELECT) {
+    const Menu_Item_t *it = &st->menu->items[st->cursor];
+    if (it->on_select) {
+      it->on_select();
+      if (!st->menu)
+        return; // 다른 화면으로 넘어감
+    }
+  } else if (in != MENU_IN_NONE) {
+    menu_move(st, in);
+  }
+
+  menu_render(st);
+}
@@ -0,0 +1,126 @@
+#include "modbus_map.h"
+#include "dht11.h"
+#include "gate_actuator.h"
+#include "water_classifier.h"
+#include "water_log_flash.h"
+#include "water_state_logger.h"
+#include <stddef.h>
+
+// ========== 표가 가리키는 전역 변수 (ap.c) ==========
+extern uint16_t water_level_hires;
+extern uint8_t water_level;
+extern int16_t sys_temp_x10;
+extern WaterState_t water_state;
+extern DHT11_Data_t global_dht11_data;
+extern uint8_t dht11_valid;
+extern uint8_t dam_auto_mode;
+extern uint8_t threshold_high;
+extern uint8_t threshold_low;
+extern WaterLog_t water_log;
+extern WLFlash_t water_log_store;
+
+static uint8_t mb_exit_pending = 0;
+static Gate_Stats_t mb_gate_stats[GATE_COUNT]; // MB_MapRefresh 스냅샷
+
+static uint16_t MB_GetState(void) { return (uint16_t)water_state; }
+static uint16_t MB_GetProto(void) { return uart_proto; }
+static uint16_t MB_GetGate1(void) { return Gate_GetAngle(GATE_1); }
+static uint16_t MB_GetGate2(void) { return Gate_GetAngle(GATE_2); }
+
+// 같은 요청에서 auto 를 끄면 그 값이 이미 반영된 뒤에 확인됨
+static uint8_t MB_CanSetGate(uint16_t angle) {
+  (void)angle;
+  return dam_auto_mode ? MB_EX_DEVICE_FAILURE // 자동 제어가 다음 주기에 되돌림
+                       : MB_EX_NONE;
+}
+
+static uint8_t MB_SetGate(Gate_t gate, uint16_t angle) {
+  uint8_t ex = MB_CanSetGate(angle);
+  if (ex != MB_EX_NONE)
+    return ex;
+  Gate_Set(gate, (uint8_t)angle);
+  return MB_EX_NONE;
+}
+static uint8_t MB_SetGate1(uint16_t v) { return MB_SetGate(GATE_1, v); }
+static uint8_t MB_SetGate2(uint16_t v) { return MB_SetGate(GATE_2, v); }
+
+static uint8_t MB_SetProto(uint16_t v) {
+  if (v == UART_PROTO_CONSOLE)
+    mb_exit_pending = 1; // 응답을 보낸 뒤 전환
+  return MB_EX_NONE;
+}
+
+// 키패드 입력과 같은 조건 (low < high)
+static uint8_t MB_Validate(void) {
+  return (threshold_low < threshold_high) ? MB_EX_NONE : MB_EX_ILLEGAL_VALUE;
+}
+
+static const MB_Reg_t mb_input_regs[MB_IN_COUNT] = {
+    [MB_IN_LEVEL] = {MB_REG_U8, &water_level, NULL, 0, 0, NULL, NULL},
+    [MB_IN_LEVEL_HIRES] = {MB_REG_U16, &water_level_hires, NULL, 0, 0, NULL,
+                           NULL},
+    [MB_IN_STATE] = {MB_REG_FN, NULL, MB_GetState, 0, 0, NULL, NULL},
+    [MB_IN_TEMP] = {MB_REG_U8, &global_dht11_data.temperature, NULL, 0, 0,
+                    NULL, NULL},
+    [MB_IN_TEMP_DEC] = {MB_REG_U8, &global_dht11_data.temperature_dec, NULL,
+                        0, 0, NULL, NULL},
+    [MB_IN_HUMIDITY] = {MB_REG_U8, &global_dht11_data.humidity, NULL, 0, 0,
+                        NULL, NULL},
+    [MB_IN_DHT11_VALID] = {MB_REG_U8, &dht11_valid, NULL, 0, 0, NULL, NULL},
+    [MB_IN_SYS_TEMP_X10] = {MB_REG_I16, &sys_temp_x10, NULL, 0, 0, NULL,
+                            NULL},
+    [MB_IN_LOG_COUNT] = {MB_REG_U16, &water_log.count, NULL, 0, 0, NULL,
+                         NULL},
+    [MB_IN_LOG_APPENDS_LO] = {MB_REG_U32_LO, &water_log_store.appends, NULL,
+                              0, 0, NULL, NULL},
+    [MB_IN_LOG_APPENDS_HI] = {MB_REG_U32_HI, &water_log_store.appends, NULL,
+                              0, 0, NULL, NULL},
+    [MB_IN_GATE1_MOVES_LO] = {MB_REG_U32_LO, &mb_gate_stats[GATE_1].moves,
+                              NULL, 0, 0, NULL, NULL},
+    [MB_IN_GATE1_MOVES_HI] = {MB_REG_U32_HI, &mb_gate_stats[GATE_1].moves,
+                              NULL, 0, 0, NULL, NULL},
+    [MB_IN_GATE1_OPEN_MS_LO] = {MB_REG_U32_LO, &mb_gate_stats[GATE_1].open_ms,
+                                NULL, 0, 0, NULL, NULL},
+    [MB_IN_GATE1_OPEN_MS_HI] = {MB_REG_U32_HI, &mb_gate_stats[GATE_1].open_ms,
+                                NULL, 0, 0, NULL, NULL},
+    [MB_IN_GATE2_MOVES_LO] = {MB_REG_U32_LO, &mb_gate_stats[GATE_2].moves,
+                              NULL, 0, 0, NULL, NULL},
+    [MB_IN_GATE2_MOVES_HI] = {MB_REG_U32_HI, &mb_gate_stats[GATE_2].moves,
+                              NULL, 0, 0, NULL, NULL},
+    [MB_IN_GATE2_OPEN_MS_LO] = {MB_REG_U32_LO, &mb_gate_stats[GATE_2].open_ms,
+                                NULL, 0, 0, NULL, NULL},
+    [MB_IN_GATE2_OPEN_MS_HI] = {MB_REG_U32_HI, &mb_gate_stats[GATE_2].open_ms,
+                                NULL, 0, 0, NULL, NULL},
+};
+
+static const MB_Reg_t mb_holding_regs[MB_HR_COUNT] = {
+    [MB_HR_TH_LOW] = {MB_REG_U8, &threshold_low, NULL, 0, 50, NULL, NULL},
+    [MB_HR_TH_HIGH] = {MB_REG_U8, &threshold_high, NULL, 0, 50, NULL, NULL},
+    [MB_HR_AUTO] = {MB_REG_U8, &dam_auto_mode, NULL, 0, 1, NULL, NULL},
+    [MB_HR_GATE1] = {MB_REG_FN, NULL, MB_GetGate1, 0, GATE_ANGLE_OPEN,
+                     MB_SetGate1, MB_CanSetGate},
+    [MB_HR_GATE2] = {MB_REG_FN, NULL, MB_GetGate2, 0, GATE_ANGLE_OPEN,
+                     MB_SetGate2, MB_CanSetGate},
+    [MB_HR_PROTO] = {MB_REG_FN, NULL, MB_GetProto, 0, 1, MB_SetProto, NULL},
+};
+
+void MB_MapInit(MB_Slave_t *mb) {
+  MB_Init(mb, MODBUS_SLAVE_ADDR);
+  mb->input = mb_input_regs;
+  mb->n_input = MB_IN_COUNT;
+  mb->holding = mb_holding_regs;
+  mb->n_holding = MB_HR_COUNT;
+  mb->validate = MB_Validate;
+  mb_exit_pending = 0;
+}
+
+void MB_MapRefresh(void) {
+  for (uint8_t g = 0; g < GATE_COUNT; g++)
+    Gate_GetStats((Gate_t)g, &mb_gate_stats[g]);
+}
+
+uint8_t MB_MapTakeExit(void) {
+  uint8_t pending = mb_exit_pending;
+  mb_exit_pending = 0;
+  return pending;
+}
@@ -0,0 +1,251 @@
+#include "modbus_slave.h"
+#include "crc16.h"
+#include <string.h>
+
+#define MB_FC_READ_HOLDING 0x03
+#define MB_FC_READ_INPUT 0x04
+#define MB_FC_WRITE_SINGLE 0x06
+#define MB_FC_WRITE_MULTIPLE 0x10
+
+#define MB_READ_MAX 125  // 한 번에 읽을 수 있는 레지스터
+#define MB_WRITE_MAX 123 // 한 번에 쓸 수 있는 레지스터
+
+void MB_Init(MB_Slave_t *mb, uint8_t addr) {
+  memset(mb, 0, sizeof(*mb));
+  mb->addr = addr;
+}
+
+// ========== 레지스터 접근 (살아 있는 변수 직접) ==========
+static uint16_t reg_read(const MB_Reg_t *r) {
+  switch (r->type) {
+  case MB_REG_U8:
+    return *(volatile uint8_t *)r->ptr;
+  case MB_REG_U16:
+    return *(volatile uint16_t *)r->ptr;
+  case MB_REG_I16:
+    return (uint16_t)*(volatile int16_t *)r->ptr;
+  case MB_REG_U32_LO:
+    return (uint16_t)*(volatile uint32_t *)r->ptr;
+  case MB_REG_U32_HI:
+    return (uint16_t)(*(volatile uint32_t *)r->ptr >> 16);
+  default:
+    return r->get ? r->get() : 0;
+  }
+}
+
+// 변수형만 (MB_REG_FN 은 set 으로)
+static void reg_store(const MB_Reg_t *r, uint16_t v) {
+  switch (r->type) {
+  case MB_REG_U8:
+    *(volatile uint8_t *)r->ptr = (uint8_t)v;
+    break;
+  case MB_REG_U16:
+    *(volatile uint16_t *)r->ptr = v;
+    break;
+  case MB_REG_I16:
+    *(volatile int16_t *)r->ptr = (int16_t)v;
+    break;
+  default:
+    break; // 32비트 값은 읽기 전용
+  }
+}
+
+static uint8_t reg_writable(const MB_Reg_t *r, uint16_t v) {
+  if (r->type == MB_REG_U32_LO || r->type == MB_REG_U32_HI)
+    return 0;
+  if (r->type == MB_REG_FN && !r->set)
+    return 0;
+  return v >= r->min && v <= r->max;
+}
+
+static void restore(MB_Slave_t *mb, uint16_t start, uint16_t count,
+                    const uint16_t *old) {
+  for (uint16_t i = 0; i < count; i++) {
+    const MB_Reg_t *r = &mb->holding[start + i];
+    if (r->type != MB_REG_FN)
+      reg_store(r, old[i]);
+  }
+}
+
+// ========== 쓰기 (범위 확인 → 변수 기록 → 교차 확인 → 함수형 반영) ==========
+// ⭐ 함수형은 can_set 으로 전부 확인한 뒤에만 set → 요청 하나는 전부 또는 전혀
+static uint8_t write_regs(MB_Slave_t *mb, uint16_t start, uint16_t count,
+                          const uint8_t *values) {
+  uint16_t old[MB_WRITE_MAX];
+
+  if ((uint32_t)start + count > mb->n_holding)
+    return MB_EX_ILLEGAL_ADDRESS;
+
+  for (uint16_t i = 0; i < count; i++) {
+    uint16_t v = (uint16_t)((values[2 * i] << 8) | values[2 * i + 1]);
+    if (!reg_writable(&mb->holding[start + i], v))
+      return MB_EX_ILLEGAL_VALUE;
+  }
+
+  for (uint16_t i = 0; i < count; i++) {
+    const MB_Reg_t *r = &mb->holding[start + i];
+    old[i] = reg_read(r);
+    if (r->type != MB_REG_FN)
+      reg_store(r, (uint16_t)((values[2 * i] << 8) | values[2 * i + 1]));
+  }
+
+  if (mb->validate && mb->validate() != MB_EX_NONE) {
+    restore(mb, start, count, old);
+    return MB_EX_ILLEGAL_VALUE;
+  }
+
+  for (uint16_t i = 0; i < count; i++) {
+    const MB_Reg_t *r = &mb->holding[start + i];
+    if (r->type == MB_REG_FN && r->can_set) {
+      uint8_t ex =
+          r->can_set((uint16_t)((values[2 * i] << 8) | values[2 * i + 1]));
+      if (ex != MB_EX_NONE) {
+        restore(mb, start, count, old);
+        return ex;
+      }
+    }
+  }
+
+  // 부작용 있는 값(서보 등)은 검증이 끝난 뒤에만
+  for (uint16_t i = 0; i < count; i++) {
+    const MB_Reg_t *r = &mb->holding[start + i];
+    if (r->type == MB_REG_FN) {
+      uint8_t ex = r->set((uint16_t)((values[2 * i] << 8) | values[2 * i + 1]));
+      if (ex != MB_EX_NONE) {
+        // can_set 과 set 이 어긋난 경우: 변수형이라도 되돌림
+        restore(mb, start, count, old);
+        return ex;
+      }
+    }
+  }
+  return MB_EX_NONE;
+}
+
+// ========== 프레임 ==========
+static uint16_t finish(uint8_t *resp, uint16_t n) {
+  uint16_t crc = CRC16_ModbusUpdate(CRC16_MODBUS_INIT, resp, n);
+  resp[n++] = (uint8_t)crc;
+  resp[n++] = (uint8_t)(crc >> 8);
+  return n;
+}
+
+static uint16_t exception(MB_Slave_t *mb, uint8_t fc, uint8_t code,
+                          uint8_t *resp) {
+  mb->exceptions++;
+  resp[0] = mb->addr;
+  resp[1] = fc | 0x80;
+  resp[2] = code;
+  return finish(resp, 3);
+}
+
+uint16_t MB_Process(MB_Slave_t *mb, const uint8_t *req, uint16_t len,
+                    uint8_t *resp) {
+  if (len < 4 || len > MB_ADU_MAX)
+    return 0;
+  if (req[0] != mb->addr && req[0] != 0)
+    return 0;
+
+  uint16_t crc = (uint16_t)(req[len - 2] | (req[len - 1] << 8));
+  if (CRC16_ModbusUpdate(CRC16_MODBUS_INIT, req, len - 2) != crc) {
+    mb->crc_errors++;
+    return 0;
+  }
+  mb->frames++;
+
+  uint8_t broadcast = (req[0] == 0);
+  uint8_t fc = req[1];
+  const uint8_t *pdu = &req[2];
+  uint16_t pdu_len = len - 4;
+  uint8_t ex = MB_EX_NONE;
+  uint16_t n = 0;
+
+  if (pdu_len < 4) {
+    ex = MB_EX_ILLEGAL_VALUE;
+    if (fc != MB_FC_READ_HOLDING && fc != MB_FC_READ_INPUT &&
+        fc != MB_FC_WRITE_SINGLE && fc != MB_FC_WRITE_MULTIPLE)
+      ex = MB_EX_ILLEGAL_FUNCTION;
+  } else {
+    uint16_t start = (uint16_t)((pdu[0] << 8) | pdu[1]);
+    uint16_t count = (uint16_t)((pdu[2] << 8) | pdu[3]);
+
+    switch (fc) {
+    case MB_FC_READ_HOLDING:
+    case MB_FC_READ_INPUT: {
+      const MB_Reg_t *tbl = (fc == MB_FC_READ_INPUT) ? mb->input : mb->holding;
+      uint16_t n_tbl = (fc == MB_FC_READ_INPUT) ? mb->n_input : mb->n_holding;
+      if (broadcast)
+        return 0; // 읽기는 브로드캐스트 불가
+      if (count == 0 || count > MB_READ_MAX) {
+        ex = MB_EX_ILLEGAL_VALUE;
+        break;
+      }
+      if ((uint32_t)start + count > n_tbl) {
+        ex = MB_EX_ILLEGAL_ADDRESS;
+        break;
+      }
+      resp[0] = mb->addr;
+      resp[1] = fc;
+      resp[2] = (uint8_t)(count * 2);
+      n = 3;
+      for (uint16_t i = 0; i < count; i++) {
+        uint16_t v = reg_read(&tbl[start + i]);
+        resp[n++] = (uint8_t)(v >> 8);
+        resp[n++] = (uint8_t)v;
+      }
+      break;
+    }
+
+    case MB_FC_WRITE_SINGLE:
+      // 값 자리(count)가 곧 쓸 값
+      ex = write_regs(mb, start, 1, &pdu[2]);
+      if (ex == MB_EX_NONE) {
+        memcpy(resp, req, 6); // 요청 그대로 되돌려줌
+        n = 6;
+      }
+      break;
+
+    case MB_FC_WRITE_MULTIPLE:
+      if (count == 0 || count > MB_WRITE_MAX || pdu_len < 5 ||
+          pdu[4] != count * 2 || pdu_len != 5u + count * 2u) {
+        ex = MB_EX_ILLEGAL_VALUE;
+        break;
+      }
+      ex = write_regs(mb, start, count, &pdu[5]);
+      if (ex == MB_EX_NONE) {
+        memcpy(resp, req, 6); // 주소, 기능, 시작, 개수
+        n = 6;
+      }
+      break;
+
+    default:
+      ex = MB_EX_ILLEGAL_FUNCTION;
+      break;
+    }
+  }
+
+  if (broadcast)
+    return 0;
+  if (ex != MB_EX_NONE)
+    return exception(mb, fc, ex, resp);
+  return finish(resp, n);
+}
+
+// ========== 3.5문자 프레임 간격 감지 ==========
+void MB_TimerReset(MB_FrameTimer_t *t, uint16_t pos) {
+  t->last_pos = pos;
+  t->quiet = 0;
+  t->active = 0;
+  t->frame_ready = 0;
+}
+
+// 1ms 마다: 수신 위치가 움직이면 프레임 진행 중, MB_T35_TICKS 동안 멈추면 끝
+void MB_TimerTick(MB_FrameTimer_t *t, uint16_t pos) {
+  if (pos != t->last_pos) {
+    t->last_pos = pos;
+    t->quiet = 0;
+    t->active = 1;
+  } else if (t->active && ++t->quiet >= MB_T35_TICKS) {
+    t->active = 0;
+    t->frame_ready = 1;
+  }
+}
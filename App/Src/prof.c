@@ -0,0 +1,126 @@
+#include "prof.h"
+
+#if PROF_ENABLE
+
+#include <stdio.h>
+#include <string.h>
+
+static const char *const fixed_names[PROF_Z_TASK0] = {
+    [PROF_Z_KEYPAD] = "keypad",
+    [PROF_Z_LCD_FLUSH] = "lcd",
+    [PROF_Z_PUTCHAR] = "putchar",
+    [PROF_Z_WLF_MEDIAN] = "median",
+    [PROF_Z_WLF_IIR] = "iir",
+    [PROF_Z_WLF_MOVAVG] = "movavg",
+};
+
+static Prof_Stats_t zones[PROF_ZONE_COUNT];
+
+void Prof_Init(void) {
+#if defined(__arm__) || defined(PROF_DWT)
+  // ⭐ 디버거가 없으면 TRCENA 가 꺼져 있어 CYCCNT 가 멈춰 있음
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+  for (uint8_t z = 0; z < PROF_ZONE_COUNT; z++)
+    zones[z].name = (z < PROF_Z_TASK0) ? fixed_names[z] : NULL;
+  Prof_Reset();
+}
+
+void Prof_Reset(void) {
+  for (uint8_t z = 0; z < PROF_ZONE_COUNT; z++) {
+    Prof_Stats_t *s = &zones[z];
+    s->count = 0;
+    s->min = UINT32_MAX;
+    s->max = 0;
+    s->sum = 0;
+    memset(s->hist, 0, sizeof(s->hist));
+  }
+}
+
+void Prof_SetName(uint8_t zone, const char *name) {
+  if (zone < PROF_ZONE_COUNT)
+    zones[zone].name = name;
+}
+
+void Prof_Record(uint8_t zone, uint32_t ticks) {
+  if (zone >= PROF_ZONE_COUNT)
+    return;
+  Prof_Stats_t *s = &zones[zone];
+
+  s->count++;
+  s->sum += ticks;
+  if (ticks < s->min)
+    s->min = ticks;
+  if (ticks > s->max)
+    s->max = ticks;
+
+  // log2 칸 = 최상위 비트 위치 (CLZ 한 번)
+  uint8_t bin = (uint8_t)(31 - __builtin_clz(ticks | 1u));
+  if (bin >= PROF_HIST_BINS)
+    bin = PROF_HIST_BINS - 1;
+  s->hist[bin]++;
+}
+
+const Prof_Stats_t *Prof_Get(uint8_t zone) {
+  return (zone < PROF_ZONE_COUNT) ? &zones[zone] : NULL;
+}
+
+uint32_t Prof_TicksPerUs(void) {
+#if defined(__arm__) || defined(PROF_DWT)
+  return SystemCoreClock / 1000000u;
+#else
+  return 1000u;
+#endif
+}
+
+uint8_t Prof_Find(const char *name) {
+  for (uint8_t z = 0; z < PROF_ZONE_COUNT; z++) {
+    if (zones[z].name != NULL && strcmp(zones[z].name, name) == 0)
+      return z;
+  }
+  return PROF_ZONE_COUNT;
+}
+
+// 틱 → "123.45" µs
+static const char *fmt_us(char *out, uint8_t size, uint64_t ticks) {
+  uint32_t tpu = Prof_TicksPerUs();
+  uint64_t centi = ticks * 100u / tpu;
+  snprintf(out, size, "%lu.%02lu", (unsigned long)(centi / 100),
+           (unsigned long)(centi % 100));
+  return out;
+}
+
+void Prof_PrintTable(void) {
+  char a[24], b[24], c[24];
+
+  printf("zone        count    min   mean    max (us)\r\n");
+  for (uint8_t z = 0; z < PROF_ZONE_COUNT; z++) {
+    const Prof_Stats_t *s = &zones[z];
+    if (s->name == NULL || s->count == 0)
+      continue;
+    printf("%-8s %8lu %6s %6s %6s\r\n", s->name, (unsigned long)s->count,
+           fmt_us(a, sizeof(a), s->min),
+           fmt_us(b, sizeof(b), s->sum / s->count),
+           fmt_us(c, sizeof(c), s->max));
+  }
+}
+
+void Prof_PrintHist(uint8_t zone) {
+  char a[24];
+  const Prof_Stats_t *s = Prof_Get(zone);
+  if (s == NULL || s->name == NULL)
+    return;
+
+  printf("%s: %lu runs (bin = ticks 2^n, %lu ticks/us)\r\n", s->name,
+         (unsigned long)s->count, (unsigned long)Prof_TicksPerUs());
+  for (uint8_t i = 0; i < PROF_HIST_BINS; i++) {
+    if (s->hist[i] == 0)
+      continue;
+    printf("  2^%-2u >=%8sus %8lu\r\n", i,
+           fmt_us(a, sizeof(a), (uint64_t)1 << i), (unsigned long)s->hist[i]);
+  }
+}
+
+#endif // PROF_ENABLE
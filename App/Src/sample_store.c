@@ -0,0 +1,239 @@
+#include "sample_store.h"
+#include <string.h>
+
+#define TOK_RUN 0x01u
+#define MASK_LEVEL 0x1u
+#define MASK_HUM 0x2u
+#define MASK_TEMP 0x4u
+
+#define MAX_VARINT 5
+// 샘플 토큰 최대 크기 (헤더 + 채널 3개)
+#define MAX_SAMPLE_BYTES (MAX_VARINT + 3 * 3)
+
+// ========== varint ==========
+static uint8_t put_varint(uint8_t *p, uint32_t v) {
+  uint8_t n = 0;
+  while (v >= 0x80u) {
+    p[n++] = (uint8_t)(v | 0x80u);
+    v >>= 7;
+  }
+  p[n++] = (uint8_t)v;
+  return n;
+}
+
+static uint32_t get_varint(const uint8_t *p, uint16_t *pos, uint16_t len) {
+  uint32_t v = 0;
+  uint8_t shift = 0;
+  while (*pos < len && shift < 35) {
+    uint8_t b = p[(*pos)++];
+    v |= (uint32_t)(b & 0x7Fu) << shift;
+    if (!(b & 0x80u))
+      break;
+    shift += 7;
+  }
+  return v;
+}
+
+static uint32_t zigzag(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+static int32_t unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1u); }
+
+// ========== 블록 ==========
+static SStore_Block_t *blk_at(const SStore_t *st, uint16_t logical) {
+  uint16_t oldest = (st->head + SSTORE_NUM_BLOCKS + 1 - st->count) %
+                    SSTORE_NUM_BLOCKS;
+  return (SStore_Block_t *)&st->blk[(oldest + logical) % SSTORE_NUM_BLOCKS];
+}
+
+static void flush_run(SStore_t *st) {
+  if (st->run == 0)
+    return;
+  SStore_Block_t *b = &st->blk[st->head];
+  b->len += put_varint(&b->data[b->len], ((uint32_t)st->run << 1) | TOK_RUN);
+  b->n += st->run;
+  st->run = 0;
+}
+
+static void open_block(SStore_t *st, uint32_t epoch, const HistSample_t *s) {
+  if (st->count > 0) {
+    flush_run(st);
+    st->head = (st->head + 1) % SSTORE_NUM_BLOCKS;
+  }
+  if (st->count < SSTORE_NUM_BLOCKS) {
+    st->count++;
+  } else {
+    st->evicted++;
+  }
+
+  SStore_Block_t *b = &st->blk[st->head];
+  b->t0 = epoch;
+  b->first = *s;
+  b->n = 1;
+  b->len = 0;
+}
+
+void SStore_Init(SStore_t *st) { memset(st, 0, sizeof(*st)); }
+
+void SStore_Append(SStore_t *st, uint32_t epoch, const HistSample_t *s) {
+  st->samples++;
+
+  // 첫 샘플 / 시간 역행 (RTC 재설정) → 새 블록
+  if (st->count == 0 || epoch <= st->prev_t) {
+    open_block(st, epoch, s);
+    st->prev = *s;
+    st->prev_t = epoch;
+    return;
+  }
+
+  int32_t dl = (int32_t)s->level - st->prev.level;
+  int32_t dh = (int32_t)s->humidity - st->prev.humidity;
+  int32_t dt = (int32_t)s->temp_x10 - st->prev.temp_x10;
+  uint32_t gap = epoch - st->prev_t;
+
+  st->prev = *s;
+  st->prev_t = epoch;
+
+  // ⭐ 변화 없고 1초 간격이면 카운터만 증가 (블록에는 나중에 한 번에)
+  if (gap == 1 && dl == 0 && dh == 0 && dt == 0 && st->run < 0x7FFF) {
+    st->run++;
+    return;
+  }
+
+  SStore_Block_t *b = &st->blk[st->head];
+  // 연속 구간 플러시 2번 (지금 + 블록 닫을 때) 여유까지 확보
+  if (b->len + 2 * MAX_VARINT + MAX_SAMPLE_BYTES > SSTORE_BLOCK_BYTES) {
+    open_block(st, epoch, s);
+    return;
+  }
+  flush_run(st);
+
+  uint8_t mask = (dl ? MASK_LEVEL : 0) | (dh ? MASK_HUM : 0) |
+                 (dt ? MASK_TEMP : 0);
+  uint8_t *p = &b->data[b->len];
+  uint8_t n = put_varint(p, ((gap - 1) << 4) | ((uint32_t)mask << 1));
+  if (dl)
+    n += put_varint(&p[n], zigzag(dl));
+  if (dh)
+    n += put_varint(&p[n], zigzag(dh));
+  if (dt)
+    n += put_varint(&p[n], zigzag(dt));
+  b->len += n;
+  b->n++;
+}
+
+// ========== 읽기 ==========
+// 첫 샘플 시각이 from 이하인 마지막 블록
+static uint16_t find_block(const SStore_t *st, uint32_t from) {
+  uint16_t lo = 0, hi = st->count;
+  while (lo < hi) {
+    uint16_t mid = lo + (hi - lo) / 2;
+    if (blk_at(st, mid)->t0 <= from)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return (lo > 0) ? lo - 1 : 0;
+}
+
+static uint8_t iter_step(SStore_Iter_t *it) {
+  const SStore_t *st = it->st;
+
+  while (it->blk < st->count) {
+    const SStore_Block_t *b = blk_at(st, it->blk);
+    uint8_t is_open = (it->blk == st->count - 1);
+
+    if (!it->started) {
+      it->started = 1;
+      it->pos = 0;
+      it->run = 0;
+      it->t = b->t0;
+      it->s = b->first;
+      return 1;
+    }
+
+    if (it->run > 0) {
+      it->run--;
+      it->t++;
+      return 1;
+    }
+
+    if (it->pos < b->len) {
+      uint32_t tok = get_varint(b->data, &it->pos, b->len);
+      if (tok & TOK_RUN) {
+        it->run = (uint16_t)(tok >> 1);
+        continue;
+      }
+      uint8_t mask = (tok >> 1) & 0x7u;
+      it->t += (tok >> 4) + 1;
+      if (mask & MASK_LEVEL)
+        it->s.level += unzigzag(get_varint(b->data, &it->pos, b->len));
+      if (mask & MASK_HUM)
+        it->s.humidity += unzigzag(get_varint(b->data, &it->pos, b->len));
+      if (mask & MASK_TEMP)
+        it->s.temp_x10 += unzigzag(get_varint(b->data, &it->pos, b->len));
+      return 1;
+    }
+
+    // 기록 중인 블록이면 아직 플러시 안 된 연속 구간까지
+    if (is_open && it->pos == b->len && st->run > 0) {
+      it->run = st->run;
+      it->pos++; // len + 1 = 대기 구간까지 읽음
+      continue;
+    }
+
+    it->blk++;
+    it->started = 0;
+  }
+  return 0;
+}
+
+void SStore_IterBegin(const SStore_t *st, uint32_t from, SStore_Iter_t *it) {
+  memset(it, 0, sizeof(*it));
+  it->st = st;
+  it->blk = find_block(st, from);
+
+  // 블록 안에서 from 이하 마지막 샘플까지 진행 (다음 Next 가 그 샘플 반환)
+  SStore_Iter_t probe = *it;
+  while (iter_step(&probe) && probe.t <= from) {
+    *it = probe;
+    it->hold = 1;
+  }
+}
+
+uint8_t SStore_IterNext(SStore_Iter_t *it, uint32_t *t, HistSample_t *s) {
+  if (it->hold) {
+    it->hold = 0;
+  } else if (!iter_step(it)) {
+    return 0;
+  }
+  *t = it->t;
+  *s = it->s;
+  return 1;
+}
+
+uint8_t SStore_Find(const SStore_t *st, uint32_t epoch, uint32_t *t,
+                    HistSample_t *out) {
+  SStore_Iter_t it;
+  if (st->count == 0 || blk_at(st, 0)->t0 > epoch)
+    return 0;
+  SStore_IterBegin(st, epoch, &it);
+  return SStore_IterNext(&it, t, out);
+}
+
+uint32_t SStore_BytesUsed(const SStore_t *st) {
+  uint32_t bytes = 0;
+  for (uint16_t i = 0; i < st->count; i++) {
+    // 블록 머리 (시각 + 첫 샘플 + n + len) 포함
+    bytes += blk_at(st, i)->len + 12;
+  }
+  return bytes;
+}
+
+uint32_t SStore_RatioX100(const SStore_t *st) {
+  uint32_t n = 0;
+  for (uint16_t i = 0; i < st->count; i++)
+    n += blk_at(st, i)->n;
+  n += st->run;
+
+  uint32_t used = SStore_BytesUsed(st);
+  return used ? (n * 8u * 100u) / used : 0;
+}
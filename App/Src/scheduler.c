@@ -0,0 +1,100 @@
+#include "scheduler.h"
+#include "main.h"
+#include "prof.h"
+#include <string.h>
+
+static Sched_Task_t tasks[SCHED_MAX_TASKS];
+static uint8_t task_count = 0;
+
+void Sched_Init(void) {
+  memset(tasks, 0, sizeof(tasks));
+  task_count = 0;
+}
+
+int8_t Sched_Add(const char *name, Sched_TaskFn_t fn, uint32_t period_ms,
+                 uint32_t phase_ms, uint8_t priority) {
+  if (task_count >= SCHED_MAX_TASKS || fn == NULL || period_ms == 0)
+    return -1;
+
+  Sched_Task_t *t = &tasks[task_count];
+  t->name = name;
+  t->fn = fn;
+  t->period_ms = period_ms;
+  t->next_due = HAL_GetTick() + phase_ms;
+  t->priority = priority;
+  t->enabled = 1;
+  t->runs = 0;
+  t->overruns = 0;
+  t->max_late_ms = 0;
+  PROF_NAME(PROF_Z_TASK0 + task_count, name);
+  return (int8_t)task_count++;
+}
+
+void Sched_Delay(int8_t id, uint32_t delay_ms) {
+  if (id < 0 || id >= task_count)
+    return;
+  tasks[id].next_due = HAL_GetTick() + delay_ms;
+}
+
+void Sched_Enable(int8_t id, uint8_t on) {
+  if (id < 0 || id >= task_count)
+    return;
+  if (on && !tasks[id].enabled)
+    tasks[id].next_due = HAL_GetTick();
+  tasks[id].enabled = on;
+}
+
+// 마감된 태스크 중 우선순위가 가장 높은 것 (같으면 먼저 등록된 것)
+static Sched_Task_t *Sched_PickDue(uint32_t now) {
+  Sched_Task_t *best = NULL;
+  for (uint8_t i = 0; i < task_count; i++) {
+    Sched_Task_t *t = &tasks[i];
+    if (!t->enabled || !SCHED_EXPIRED(now, t->next_due))
+      continue;
+    if (best == NULL || t->priority < best->priority)
+      best = t;
+  }
+  return best;
+}
+
+void Sched_Dispatch(void) {
+  uint8_t ran = 0;
+  Sched_Task_t *t;
+
+  // ⭐ 하나 실행할 때마다 다시 골라서, 느린 태스크 뒤에도 제어 태스크가 먼저
+  while ((t = Sched_PickDue(HAL_GetTick())) != NULL) {
+    uint32_t start = HAL_GetTick();
+    uint32_t late = start - t->next_due;
+    if (late > t->max_late_ms)
+      t->max_late_ms = late;
+
+    PROF_START(t0);
+    t->fn();
+    PROF_STOP(t0, PROF_Z_TASK0 + (uint8_t)(t - tasks));
+    t->runs++;
+    ran = 1;
+
+    // 고정 주기 유지 (실행 시간이 누적되지 않게 마감 기준으로 전진)
+    t->next_due += t->period_ms;
+    uint32_t now = HAL_GetTick();
+    uint32_t behind = now - t->next_due;
+    if (SCHED_EXPIRED(now, t->next_due) && behind >= t->period_ms) {
+      // ⭐ 한 주기 이상 늦은 슬롯만 건너뜀 (몰아서 실행 안 함)
+      //    주기 단위로만 전진 → 위상(phase) 격자 유지
+      //    1주기 미만 늦은 슬롯은 바로 실행 (지연은 max_late_ms 에만)
+      uint32_t skip = behind / t->period_ms;
+      t->overruns += skip;
+      t->next_due += skip * t->period_ms;
+    }
+  }
+
+  if (!ran) {
+    __WFI(); // SysTick(1ms) 또는 주변장치 인터럽트에서 깨어남
+  }
+}
+
+uint8_t Sched_Count(void) { return task_count; }
+
+const Sched_Task_t *Sched_Get(uint8_t id) {
+  return (id < task_count) ? &tasks[id] : NULL;
+}
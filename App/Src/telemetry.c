@@ -0,0 +1,183 @@
+#include "telemetry.h"
+#include "crc16.h"
+#include <string.h>
+
+// ========== 리틀 엔디언 직렬화 ==========
+static uint8_t *put_u16(uint8_t *p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  return p + 2;
+}
+
+static uint8_t *put_u32(uint8_t *p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+  return p + 4;
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+         ((uint32_t)p[3] << 24);
+}
+
+// ========== 프레임 ==========
+uint16_t Tlm_BuildFrame(uint8_t type, uint16_t seq, const uint8_t *payload,
+                        uint8_t len, uint8_t *frame) {
+  uint8_t raw[TLM_MAX_RAW];
+
+  if (len > TLM_MAX_PAYLOAD)
+    return 0;
+
+  raw[0] = TLM_VERSION;
+  raw[1] = type;
+  put_u16(&raw[2], seq);
+  memcpy(&raw[TLM_HDR_LEN], payload, len);
+  uint16_t n = TLM_HDR_LEN + len;
+  put_u16(&raw[n], CRC16_Update(CRC16_INIT, raw, n));
+  n += TLM_CRC_LEN;
+
+  // ⭐ 앞 구분자: 앞서 나간 텍스트가 프레임 앞에 붙지 않게
+  frame[0] = 0x00;
+  uint16_t enc = COBS_Encode(raw, n, &frame[1]);
+  frame[1 + enc] = 0x00;
+  return enc + 2;
+}
+
+uint8_t Tlm_ParseFrame(const uint8_t *enc, uint16_t len, Tlm_Frame_t *out) {
+  uint8_t raw[TLM_MAX_RAW];
+
+  if (len == 0 || len > COBS_MAX_ENCODED(TLM_MAX_RAW))
+    return 0;
+
+  uint16_t n = COBS_Decode(enc, len, raw);
+  if (n < TLM_HDR_LEN + TLM_CRC_LEN || n > TLM_MAX_RAW)
+    return 0;
+
+  n -= TLM_CRC_LEN;
+  if (CRC16_Update(CRC16_INIT, raw, n) != get_u16(&raw[n]))
+    return 0;
+  if (raw[0] != TLM_VERSION)
+    return 0;
+
+  out->ver = raw[0];
+  out->type = raw[1];
+  out->seq = get_u16(&raw[2]);
+  out->len = (uint8_t)(n - TLM_HDR_LEN);
+  memcpy(out->payload, &raw[TLM_HDR_LEN], out->len);
+  return 1;
+}
+
+// ========== 송신 ==========
+void Tlm_Init(Tlm_t *t, const Tlm_Port_t *port) {
+  memset(t, 0, sizeof(*t));
+  t->port = port;
+}
+
+// ⭐ 프레임 단위로 전부 보내거나 전혀 안 보냄 (대기 없음, 반쪽 프레임 없음)
+static uint8_t tlm_send(Tlm_t *t, uint8_t type, const uint8_t *payload,
+                        uint8_t len) {
+  uint8_t frame[TLM_MAX_FRAME];
+  uint16_t n = Tlm_BuildFrame(type, t->seq, payload, len, frame);
+
+  t->seq++; // 버려도 증가 → 수신 측에서 seq 틈으로 손실 확인
+  if (n == 0 || t->port->room() < n) {
+    t->dropped++;
+    return 0;
+  }
+
+  t->port->write(frame, n);
+  t->sent++;
+  t->bytes += n;
+  return 1;
+}
+
+uint8_t Tlm_SendSample(Tlm_t *t, const Tlm_Sample_t *s) {
+  uint8_t p[TLM_SAMPLE_LEN];
+  uint8_t *w = put_u32(p, s->epoch);
+  w = put_u16(w, s->level_hires);
+  *w++ = s->level;
+  *w++ = s->state;
+  w = put_u16(w, (uint16_t)s->temp_x10);
+  *w++ = s->humidity;
+  return tlm_send(t, TLM_TYPE_SAMPLE, p, (uint8_t)(w - p));
+}
+
+uint8_t Tlm_SendEvent(Tlm_t *t, const Tlm_Event_t *e) {
+  uint8_t p[TLM_EVENT_LEN];
+  uint8_t *w = put_u32(p, e->start);
+  w = put_u32(w, e->duration_s);
+  w = put_u32(w, e->integral);
+  *w++ = e->state;
+  *w++ = e->level;
+  *w++ = e->peak;
+  *w++ = e->trough;
+  *w++ = e->mean;
+  *w++ = e->ended;
+  return tlm_send(t, TLM_TYPE_EVENT, p, (uint8_t)(w - p));
+}
+
+uint8_t Tlm_SendStatus(Tlm_t *t, const Tlm_Status_t *st) {
+  uint8_t p[TLM_STATUS_LEN];
+  uint8_t *w = put_u32(p, st->uptime_ms);
+  w = put_u32(w, st->uart_dropped);
+  w = put_u32(w, st->tlm_dropped);
+  w = put_u16(w, st->log_count);
+  *w++ = st->th_low;
+  *w++ = st->th_high;
+  *w++ = st->auto_mode;
+  *w++ = st->gate_mask;
+  *w++ = st->state;
+  return tlm_send(t, TLM_TYPE_STATUS, p, (uint8_t)(w - p));
+}
+
+// ========== 수신 ==========
+uint8_t Tlm_DecodeSample(const Tlm_Frame_t *f, Tlm_Sample_t *s) {
+  if (f->type != TLM_TYPE_SAMPLE || f->len < TLM_SAMPLE_LEN)
+    return 0;
+  const uint8_t *p = f->payload;
+  s->epoch = get_u32(&p[0]);
+  s->level_hires = get_u16(&p[4]);
+  s->level = p[6];
+  s->state = p[7];
+  s->temp_x10 = (int16_t)get_u16(&p[8]);
+  s->humidity = p[10];
+  return 1;
+}
+
+uint8_t Tlm_DecodeEvent(const Tlm_Frame_t *f, Tlm_Event_t *e) {
+  if (f->type != TLM_TYPE_EVENT || f->len < TLM_EVENT_LEN)
+    return 0;
+  const uint8_t *p = f->payload;
+  e->start = get_u32(&p[0]);
+  e->duration_s = get_u32(&p[4]);
+  e->integral = get_u32(&p[8]);
+  e->state = p[12];
+  e->level = p[13];
+  e->peak = p[14];
+  e->trough = p[15];
+  e->mean = p[16];
+  e->ended = p[17];
+  return 1;
+}
+
+uint8_t Tlm_DecodeStatus(const Tlm_Frame_t *f, Tlm_Status_t *st) {
+  if (f->type != TLM_TYPE_STATUS || f->len < TLM_STATUS_LEN)
+    return 0;
+  const uint8_t *p = f->payload;
+  st->uptime_ms = get_u32(&p[0]);
+  st->uart_dropped = get_u32(&p[4]);
+  st->tlm_dropped = get_u32(&p[8]);
+  st->log_count = get_u16(&p[12]);
+  st->th_low = p[14];
+  st->th_high = p[15];
+  st->auto_mode = p[16];
+  st->gate_mask = p[17];
+  st->state = p[18];
+  return 1;
+}
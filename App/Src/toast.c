@@ -0,0 +1,105 @@
+#include "toast.h"
+#include "i2c-lcd.h"
+#include "main.h"
+#include <string.h>
+
+// 부저 패턴: 비트 i = i번째 50ms 칸에 ON (LSB 먼저)
+static const uint32_t beep_patterns[] = {
+    [TOAST_BEEP_NONE] = 0x0,
+    [TOAST_BEEP_SHORT] = 0x3F,   // ON 6칸
+    [TOAST_BEEP_LONG] = 0x3FF,   // ON 10칸
+    [TOAST_BEEP_DOUBLE] = 0x33,  // ON 2, OFF 2, ON 2
+    [TOAST_BEEP_ALARM] = 0x1CE7, // (ON 3, OFF 2) x 3
+};
+
+static struct {
+  char line[LCD_ROWS][LCD_COLS + 1];
+  uint8_t has_line; // bit = 줄
+  uint8_t active;
+  uint8_t expired; // 만료됨, 다음 Render 에서 알림
+  Toast_Prio_t prio;
+  uint32_t start;
+  uint16_t duration_ms;
+
+  uint32_t beep;       // 남은 패턴
+  uint32_t beep_start; // 패턴 시작 시각
+  uint8_t buzzer_on;
+} toast;
+
+static void buzzer(uint8_t on) {
+  if (on != toast.buzzer_on) {
+    toast.buzzer_on = on;
+    HAL_GPIO_WritePin(BUZZER_GPIO_Port, BUZZER_Pin,
+                      on ? GPIO_PIN_SET : GPIO_PIN_RESET);
+  }
+}
+
+uint8_t Toast_Show(const char *line0, const char *line1, uint16_t duration_ms,
+                   Toast_Prio_t prio, Toast_Beep_t beep) {
+  if (toast.active && prio < toast.prio)
+    return 0;
+
+  const char *lines[LCD_ROWS] = {line0, line1};
+  toast.has_line = 0;
+  for (uint8_t r = 0; r < LCD_ROWS; r++) {
+    if (lines[r]) {
+      strncpy(toast.line[r], lines[r], LCD_COLS);
+      toast.line[r][LCD_COLS] = '\0';
+      toast.has_line |= (uint8_t)(1u << r);
+    }
+  }
+
+  toast.active = 1;
+  toast.expired = 0;
+  toast.prio = prio;
+  toast.start = HAL_GetTick();
+  toast.duration_ms = duration_ms;
+
+  if (beep != TOAST_BEEP_NONE) {
+    toast.beep = beep_patterns[beep];
+    toast.beep_start = toast.start;
+    buzzer(toast.beep & 1u);
+  }
+  return 1;
+}
+
+void Toast_Cancel(void) {
+  if (toast.active) {
+    toast.active = 0;
+    toast.expired = 1;
+  }
+}
+
+uint8_t Toast_IsActive(void) { return toast.active; }
+
+void Toast_Tick(uint32_t now) {
+  if (toast.active && (uint32_t)(now - toast.start) >= toast.duration_ms) {
+    toast.active = 0;
+    toast.expired = 1;
+  }
+
+  if (toast.beep) {
+    uint32_t slot = (now - toast.beep_start) / TOAST_BEEP_SLOT_MS;
+    if (slot >= 32 || (toast.beep >> slot) == 0) {
+      toast.beep = 0; // 패턴 끝
+      buzzer(0);
+    } else {
+      buzzer((toast.beep >> slot) & 1u);
+    }
+  }
+}
+
+uint8_t Toast_Render(void) {
+  if (toast.active) {
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+      if (toast.has_line & (1u << r))
+        LCD_PrintLine(r, toast.line[r]);
+    }
+    return 0;
+  }
+  if (toast.expired) {
+    toast.expired = 0;
+    return 1;
+  }
+  return 0;
+}
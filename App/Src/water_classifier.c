@@ -0,0 +1,55 @@
+#include "water_classifier.h"
+
+void WaterCls_Init(WaterClassifier_t *c, uint8_t hysteresis,
+                   uint32_t dwell_ms) {
+  c->hysteresis = hysteresis;
+  c->dwell_ms = dwell_ms;
+  c->state = WATER_ST_OK;
+  c->pending = WATER_ST_OK;
+  c->pending_since = 0;
+  c->changes = 0;
+  c->rejected = 0;
+}
+
+// 현재 상태 기준 히스테리시스 적용한 즉시 판정
+static WaterState_t classify(const WaterClassifier_t *c, uint8_t level,
+                             uint8_t th_low, uint8_t th_high) {
+  uint16_t h = c->hysteresis;
+
+  if (c->state == WATER_ST_LOW && level < th_low + h)
+    return WATER_ST_LOW;
+  if (c->state == WATER_ST_HIGH && level + h > th_high)
+    return WATER_ST_HIGH;
+
+  if (level < th_low)
+    return WATER_ST_LOW;
+  if (level > th_high)
+    return WATER_ST_HIGH;
+  return WATER_ST_OK;
+}
+
+WaterState_t WaterCls_Update(WaterClassifier_t *c, uint8_t level,
+                             uint8_t th_low, uint8_t th_high,
+                             uint32_t now_ms) {
+  WaterState_t cand = classify(c, level, th_low, th_high);
+
+  if (cand == c->state) {
+    if (c->pending != c->state)
+      c->rejected++; // 후보가 dwell 전에 사라짐
+    c->pending = c->state;
+    return c->state;
+  }
+
+  if (cand != c->pending) {
+    if (c->pending != c->state)
+      c->rejected++;
+    c->pending = cand;
+    c->pending_since = now_ms;
+  }
+
+  if (now_ms - c->pending_since >= c->dwell_ms) {
+    c->state = cand;
+    c->changes++;
+  }
+  return c->state;
+}
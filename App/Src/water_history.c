@@ -0,0 +1,163 @@
+#include "water_history.h"
+#include <string.h>
+
+_Static_assert(sizeof(History_t) <= HIST_RAM_BUDGET,
+               "History_t exceeds HIST_RAM_BUDGET");
+
+// ========== 누적기 ==========
+static void acc_reset(HistAcc_t *a) { memset(a, 0, sizeof(*a)); }
+
+static void acc_add_sample(HistAcc_t *a, const HistSample_t *s) {
+  if (a->n == 0 || s->level < a->level_min)
+    a->level_min = s->level;
+  if (a->n == 0 || s->level > a->level_max)
+    a->level_max = s->level;
+  a->level_sum += s->level;
+  a->n++;
+
+  if (s->humidity == HIST_ENV_INVALID)
+    return;
+  if (a->n_env == 0 || s->humidity < a->hum_min)
+    a->hum_min = s->humidity;
+  if (a->n_env == 0 || s->humidity > a->hum_max)
+    a->hum_max = s->humidity;
+  if (a->n_env == 0 || s->temp_x10 < a->temp_min)
+    a->temp_min = s->temp_x10;
+  if (a->n_env == 0 || s->temp_x10 > a->temp_max)
+    a->temp_max = s->temp_x10;
+  a->hum_sum += s->humidity;
+  a->temp_sum += s->temp_x10;
+  a->n_env++;
+}
+
+// 분 단위 결과를 시간 누적기에 합침 (합계를 그대로 더하므로 평균 정확)
+static void acc_merge(HistAcc_t *dst, const HistAcc_t *src) {
+  if (src->n) {
+    if (dst->n == 0 || src->level_min < dst->level_min)
+      dst->level_min = src->level_min;
+    if (dst->n == 0 || src->level_max > dst->level_max)
+      dst->level_max = src->level_max;
+    dst->level_sum += src->level_sum;
+    dst->n += src->n;
+  }
+  if (src->n_env) {
+    if (dst->n_env == 0 || src->hum_min < dst->hum_min)
+      dst->hum_min = src->hum_min;
+    if (dst->n_env == 0 || src->hum_max > dst->hum_max)
+      dst->hum_max = src->hum_max;
+    if (dst->n_env == 0 || src->temp_min < dst->temp_min)
+      dst->temp_min = src->temp_min;
+    if (dst->n_env == 0 || src->temp_max > dst->temp_max)
+      dst->temp_max = src->temp_max;
+    dst->hum_sum += src->hum_sum;
+    dst->temp_sum += src->temp_sum;
+    dst->n_env += src->n_env;
+  }
+}
+
+static void acc_to_rollup(const HistAcc_t *a, HistRollup_t *r) {
+  memset(r, 0, sizeof(*r));
+  r->n = a->n;
+  r->n_env = a->n_env;
+  if (a->n) {
+    r->level_min = a->level_min;
+    r->level_max = a->level_max;
+    r->level_mean = (uint8_t)(a->level_sum / a->n);
+  }
+  if (a->n_env) {
+    r->hum_min = a->hum_min;
+    r->hum_max = a->hum_max;
+    r->hum_mean = (uint8_t)(a->hum_sum / a->n_env);
+    r->temp_min = a->temp_min;
+    r->temp_max = a->temp_max;
+    r->temp_mean = (int16_t)(a->temp_sum / (int32_t)a->n_env);
+  }
+}
+
+// ========== 링 ==========
+static void ring_push(HistRollup_t *buf, uint16_t len, uint16_t *head,
+                      uint16_t *count, const HistRollup_t *r) {
+  buf[*head] = *r;
+  *head = (*head + 1) % len;
+  if (*count < len)
+    (*count)++;
+}
+
+static uint8_t ring_get(const HistRollup_t *buf, uint16_t len, uint16_t head,
+                        uint16_t count, uint16_t age, HistRollup_t *out) {
+  if (age >= count)
+    return 0;
+  *out = buf[(head + len - 1 - age) % len];
+  return 1;
+}
+
+static void close_minute(History_t *h) {
+  HistRollup_t r;
+  acc_to_rollup(&h->min_acc, &r);
+  ring_push(h->min.buf, HIST_MIN_LEN, &h->min.head, &h->min.count, &r);
+  acc_merge(&h->hour_acc, &h->min_acc);
+  acc_reset(&h->min_acc);
+}
+
+static void close_hour(History_t *h) {
+  HistRollup_t r;
+  acc_to_rollup(&h->hour_acc, &r);
+  ring_push(h->hour.buf, HIST_HOUR_LEN, &h->hour.head, &h->hour.count, &r);
+  acc_reset(&h->hour_acc);
+}
+
+// ========== API ==========
+void History_Init(History_t *h) { memset(h, 0, sizeof(*h)); }
+
+void History_AddSample(History_t *h, uint32_t epoch, const HistSample_t *s) {
+  if (h->last_epoch != 0) {
+    uint32_t prev_min = h->last_epoch / 60u;
+    uint32_t cur_min = epoch / 60u;
+
+    if (cur_min != prev_min) {
+      // 이전 분 마감 (시간이 건너뛰면 빈 구간 채움, 링 길이까지만)
+      uint32_t steps = (cur_min > prev_min) ? cur_min - prev_min : 1;
+      if (steps > HIST_MIN_LEN)
+        steps = HIST_MIN_LEN;
+
+      for (uint32_t i = 0; i < steps; i++) {
+        close_minute(h);
+        if (((prev_min + i + 1) % 60u) == 0)
+          close_hour(h);
+      }
+      h->gaps += steps - 1;
+    }
+  }
+  h->last_epoch = epoch;
+
+  h->raw[h->raw_head] = *s;
+  h->raw_head = (h->raw_head + 1) % HIST_RAW_LEN;
+  if (h->raw_count < HIST_RAW_LEN)
+    h->raw_count++;
+
+  acc_add_sample(&h->min_acc, s);
+}
+
+uint8_t History_GetRaw(const History_t *h, uint16_t age, HistSample_t *out) {
+  if (age >= h->raw_count)
+    return 0;
+  *out = h->raw[(h->raw_head + HIST_RAW_LEN - 1 - age) % HIST_RAW_LEN];
+  return 1;
+}
+
+uint8_t History_GetMinute(const History_t *h, uint16_t age,
+                          HistRollup_t *out) {
+  return ring_get(h->min.buf, HIST_MIN_LEN, h->min.head, h->min.count, age,
+                  out);
+}
+
+uint8_t History_GetHour(const History_t *h, uint16_t age, HistRollup_t *out) {
+  return ring_get(h->hour.buf, HIST_HOUR_LEN, h->hour.head, h->hour.count,
+                  age, out);
+}
+
+uint16_t History_RawCount(const History_t *h) { return h->raw_count; }
+uint16_t History_MinuteCount(const History_t *h) { return h->min.count; }
+uint16_t History_HourCount(const History_t *h) { return h->hour.count; }
+
+uint32_t History_MemoryBytes(void) { return sizeof(History_t); }
@@ -0,0 +1,120 @@
+#include "water_level_filter.h"
+#include "prof.h"
+#include <string.h>
+
+#if WLF_PROF_STAGES
+#define WLF_PROF_START(v) PROF_START(v)
+#define WLF_PROF_STOP(v, zone) PROF_STOP(v, zone)
+#else
+#define WLF_PROF_START(v)
+#define WLF_PROF_STOP(v, zone) ((void)0)
+#endif
+
+// ========== 중앙값 ==========
+// 링에 넣고 복사본을 삽입 정렬 (N ≤ 7 이라 분기 적고 빠름)
+static uint16_t stage_median(WLF_Stage_t *st, uint16_t x) {
+  st->hist[st->idx] = x;
+  st->idx = (st->idx + 1) % st->param;
+  if (st->count < st->param)
+    st->count++;
+
+  uint16_t sorted[WLF_MEDIAN_MAX];
+  uint8_t n = st->count;
+  for (uint8_t i = 0; i < n; i++) {
+    uint16_t v = st->hist[i];
+    int8_t j = i - 1;
+    while (j >= 0 && sorted[j] > v) {
+      sorted[j + 1] = sorted[j];
+      j--;
+    }
+    sorted[j + 1] = v;
+  }
+  return sorted[n / 2];
+}
+
+// ========== 1차 IIR ==========
+static uint16_t stage_iir(WLF_Stage_t *st, uint16_t x) {
+  int32_t xq = (int32_t)x << WLF_IIR_FRAC_BITS;
+
+  if (st->count == 0) {
+    st->acc = (uint32_t)xq; // 첫 샘플로 초기화 (0에서 천천히 올라오지 않게)
+    st->count = 1;
+  } else {
+    int32_t y = (int32_t)st->acc;
+    y += (xq - y) >> st->param;
+    st->acc = (uint32_t)y;
+  }
+  return (uint16_t)((st->acc + (1u << (WLF_IIR_FRAC_BITS - 1))) >>
+                    WLF_IIR_FRAC_BITS);
+}
+
+// ========== 이동 평균 ==========
+// 합계를 유지하고 빠지는 값만 빼므로 창 크기와 무관하게 O(1)
+static uint16_t stage_movavg(WLF_Stage_t *st, uint16_t x) {
+  if (st->count == st->param) {
+    st->acc -= st->hist[st->idx];
+  } else {
+    st->count++;
+  }
+  st->hist[st->idx] = x;
+  st->acc += x;
+  st->idx = (st->idx + 1) % st->param;
+  return (uint16_t)(st->acc / st->count);
+}
+
+void WLF_Init(WaterLevelFilter_t *f) { memset(f, 0, sizeof(*f)); }
+
+uint8_t WLF_AddStage(WaterLevelFilter_t *f, WLF_StageType_t type,
+                     uint8_t param) {
+  if (f->num_stages >= WLF_MAX_STAGES)
+    return 0;
+
+  switch (type) {
+  case WLF_STAGE_MEDIAN:
+    if (param == 0 || param > WLF_MEDIAN_MAX || (param % 2) == 0)
+      return 0;
+    break;
+  case WLF_STAGE_IIR:
+    if (param == 0 || param > 15)
+      return 0;
+    break;
+  case WLF_STAGE_MOVAVG:
+    if (param == 0 || param > WLF_MOVAVG_MAX)
+      return 0;
+    break;
+  default:
+    return 0;
+  }
+
+  WLF_Stage_t *st = &f->stage[f->num_stages++];
+  memset(st, 0, sizeof(*st));
+  st->type = type;
+  st->param = param;
+  return 1;
+}
+
+uint16_t WLF_Process(WaterLevelFilter_t *f, uint16_t sample) {
+  uint16_t x = sample;
+
+  for (uint8_t i = 0; i < f->num_stages; i++) {
+    WLF_Stage_t *st = &f->stage[i];
+    WLF_PROF_START(t0);
+    switch (st->type) {
+    case WLF_STAGE_MEDIAN:
+      x = stage_median(st, x);
+      WLF_PROF_STOP(t0, PROF_Z_WLF_MEDIAN);
+      break;
+    case WLF_STAGE_IIR:
+      x = stage_iir(st, x);
+      WLF_PROF_STOP(t0, PROF_Z_WLF_IIR);
+      break;
+    case WLF_STAGE_MOVAVG:
+      x = stage_movavg(st, x);
+      WLF_PROF_STOP(t0, PROF_Z_WLF_MOVAVG);
+      break;
+    }
+  }
+
+  f->out = x;
+  return x;
+}
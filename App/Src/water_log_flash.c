@@ -0,0 +1,355 @@
+#include "water_log_flash.h"
+#include "crc16.h"
+#include <stddef.h>
+#include <string.h>
+
+#define ERASED32 0xFFFFFFFFu
+#define ERASED16 0xFFFFu
+
+// packed 하위 9비트 (상태 + 수위) = 처음 기록 후 바뀌지 않는 부분
+#define KEY_MASK ((1u << WATERLOG_DUR_SHIFT) - 1u)
+
+typedef struct {
+  uint32_t magic;
+  uint32_t seq;
+  uint32_t seq_inv;
+  uint32_t reserved;
+} WLFlash_Header_t;
+
+static uint32_t slot_offset(uint32_t slot) {
+  return WLFLASH_HDR_SIZE + slot * WLFLASH_SLOT_SIZE;
+}
+
+static uint16_t slot_crc(const WaterRecord_t *rec) {
+  uint32_t key = rec->packed & KEY_MASK;
+  uint16_t crc = CRC16_Update(CRC16_INIT, &rec->start, sizeof(rec->start));
+  return CRC16_Update(crc, &key, sizeof(key));
+}
+
+// 0xFFFF 는 "종료 기록 없음" 이므로 피함
+static uint16_t dur_crc(const WLFlash_Slot_t *slot) {
+  uint32_t dur = WATERLOG_DUR(slot->rec.packed);
+  uint16_t crc = CRC16_Update(CRC16_INIT, &dur, sizeof(dur));
+  crc = CRC16_Update(crc, &slot->st, sizeof(slot->st));
+  return (crc == ERASED16) ? 0 : crc;
+}
+
+static uint8_t read_header(WLFlash_t *fs, uint8_t sector, uint32_t *seq) {
+  WLFlash_Header_t h;
+  if (fs->ops->read(sector, 0, &h, sizeof(h)) != 0)
+    return 0;
+  if (h.magic != WLFLASH_MAGIC || (h.seq ^ h.seq_inv) != ERASED32)
+    return 0;
+  *seq = h.seq;
+  return 1;
+}
+
+static uint8_t erase_sector(WLFlash_t *fs, uint8_t sector) {
+  fs->erases++;
+  if (fs->ops->erase(sector) != 0) {
+    fs->io_errors++;
+    return 0;
+  }
+  return 1;
+}
+
+static uint8_t write_header(WLFlash_t *fs, uint8_t sector, uint32_t seq) {
+  WLFlash_Header_t h = {WLFLASH_MAGIC, seq, ~seq, ERASED32};
+  if (fs->ops->program(sector, 0, &h, sizeof(h)) != 0) {
+    fs->io_errors++;
+    return 0;
+  }
+  return 1;
+}
+
+static uint8_t format_sector(WLFlash_t *fs, uint8_t sector, uint32_t seq) {
+  return erase_sector(fs, sector) && write_header(fs, sector, seq);
+}
+
+// 섹터 전체가 0xFF 인지 (이미 지워진 섹터를 또 지우지 않게)
+static uint8_t sector_blank(WLFlash_t *fs, uint8_t sector) {
+  uint32_t buf[16];
+  for (uint32_t off = 0; off < fs->ops->sector_size; off += sizeof(buf)) {
+    if (fs->ops->read(sector, off, buf, sizeof(buf)) != 0)
+      return 0;
+    for (uint8_t i = 0; i < 16; i++) {
+      if (buf[i] != ERASED32)
+        return 0;
+    }
+  }
+  return 1;
+}
+
+static uint8_t slot_used(WLFlash_t *fs, uint8_t sector, uint32_t slot) {
+  uint32_t start = ERASED32;
+  fs->ops->read(sector, slot_offset(slot), &start, sizeof(start));
+  return start != ERASED32;
+}
+
+// 슬롯은 앞에서부터 채워지므로 [0, tail) 사용, [tail, N) 빈 칸 → 이진 탐색
+static uint32_t find_tail(WLFlash_t *fs, uint8_t sector) {
+  uint32_t lo = 0, hi = fs->slots_per_sector;
+  while (lo < hi) {
+    uint32_t mid = lo + (hi - lo) / 2;
+    fs->mount_reads++;
+    if (slot_used(fs, sector, mid))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+uint8_t WLFlash_Mount(WLFlash_t *fs, const FlashIf_Ops_t *ops) {
+  memset(fs, 0, sizeof(*fs));
+  fs->ops = ops;
+  fs->slots_per_sector = (ops->sector_size - WLFLASH_HDR_SIZE) /
+                         WLFLASH_SLOT_SIZE;
+
+  uint32_t seq0 = 0, seq1 = 0;
+  uint8_t ok0 = read_header(fs, 0, &seq0);
+  uint8_t ok1 = read_header(fs, 1, &seq1);
+
+  if (!ok0 && !ok1) {
+    // 처음 사용: 섹터 0 포맷
+    if (!format_sector(fs, 0, 1))
+      return 0;
+    fs->active = 0;
+    fs->seq = 1;
+    return 1;
+  }
+
+  if (ok0 && ok1) {
+    // 둘 다 유효: seq 큰 쪽이 현재 (랩어라운드 안전 비교)
+    fs->active = ((int32_t)(seq1 - seq0) > 0) ? 1 : 0;
+    fs->prev_valid = 1;
+  } else {
+    fs->active = ok1 ? 1 : 0;
+  }
+  fs->seq = fs->active ? seq1 : seq0;
+
+  fs->tail = find_tail(fs, fs->active);
+  if (fs->prev_valid) {
+    fs->prev_tail = find_tail(fs, fs->active ^ 1);
+  }
+  return 1;
+}
+
+// 가상 인덱스 0 = 가장 오래된 레코드 (이전 섹터 → 현재 섹터 순)
+static uint8_t slot_sector(const WLFlash_t *fs, uint32_t vidx, uint32_t *off) {
+  uint8_t sector = fs->active;
+  uint32_t idx = vidx;
+  if (fs->prev_valid) {
+    if (vidx < fs->prev_tail) {
+      sector = fs->active ^ 1;
+    } else {
+      idx = vidx - fs->prev_tail;
+    }
+  }
+  *off = slot_offset(idx);
+  return sector;
+}
+
+static uint8_t read_slot(WLFlash_t *fs, uint32_t vidx, WLFlash_Slot_t *slot) {
+  uint32_t off;
+  uint8_t sector = slot_sector(fs, vidx, &off);
+  return fs->ops->read(sector, off, slot, sizeof(*slot)) == 0;
+}
+
+// 종료 기록 도중 전원 차단: 통계나 지속 시간 일부만 있고 dur_crc 없음
+static uint8_t close_torn(const WLFlash_Slot_t *slot) {
+  return slot->st.integral != ERASED32 || slot->st.stats != ERASED32 ||
+         WATERLOG_DUR(slot->rec.packed) != WATERLOG_DUR_ONGOING;
+}
+
+// 끊긴 종료를 마저 기록 (1 → 0 만 되므로 나중에 다시 종료하면 값이 섞임)
+// 못 쓴 칸은 0: 통계 무효, 지속 시간 0 (= 모름)
+static void repair_close(WLFlash_t *fs, uint32_t vidx, WLFlash_Slot_t *slot) {
+  WLFlash_Slot_t fix = *slot;
+  if (fix.st.integral == ERASED32)
+    fix.st.integral = 0;
+  if (fix.st.stats == ERASED32)
+    fix.st.stats = 0;
+  if (WATERLOG_DUR(fix.rec.packed) == WATERLOG_DUR_ONGOING)
+    fix.rec.packed &= KEY_MASK;
+  fix.dur_crc = dur_crc(&fix);
+
+  uint32_t off;
+  uint8_t sector = slot_sector(fs, vidx, &off);
+  uint32_t st_off = off + offsetof(WLFlash_Slot_t, st);
+  uint32_t crc_off = off + offsetof(WLFlash_Slot_t, crc);
+  if (fs->ops->program(sector, st_off, &fix.st, 8) != 0 ||
+      fs->ops->program(sector, off + 4, &fix.rec.packed, 4) != 0 ||
+      fs->ops->program(sector, crc_off, &fix.crc, 4) != 0) {
+    fs->io_errors++; // 못 고치면 진행 중으로 둠
+    return;
+  }
+  fs->repairs++;
+  *slot = fix;
+}
+
+uint32_t WLFlash_Count(const WLFlash_t *fs) {
+  return fs->tail + (fs->prev_valid ? fs->prev_tail : 0);
+}
+
+uint8_t WLFlash_ReadStats(WLFlash_t *fs, uint32_t vidx,
+                          const WaterRecord_t *rec, WaterStats_t *out) {
+  WLFlash_Slot_t slot;
+  if (vidx >= WLFlash_Count(fs) || !read_slot(fs, vidx, &slot))
+    return 0;
+
+  // 복원 때 버린 슬롯이 있으면 RAM 과 위치가 어긋남 → 다른 이벤트면 없음 처리
+  if (slot.crc != slot_crc(&slot.rec) || slot.rec.start != rec->start ||
+      slot.rec.packed != rec->packed)
+    return 0;
+  if (slot.dur_crc == ERASED16 || slot.dur_crc != dur_crc(&slot))
+    return 0;
+
+  *out = slot.st;
+  return 1;
+}
+
+void WLFlash_Replay(WLFlash_t *fs, WaterLog_t *log) {
+  uint32_t total = WLFlash_Count(fs);
+  uint32_t first = (total > WATERLOG_MAX) ? total - WATERLOG_MAX : 0;
+  WLFlash_Slot_t slot;
+
+  log->head = 0;
+  log->count = 0;
+  log->live_state = WATER_ST_OK;
+  fs->last_open = 0;
+
+  for (uint32_t v = first; v < total; v++) {
+    if (!read_slot(fs, v, &slot) || slot.crc != slot_crc(&slot.rec)) {
+      fs->crc_errors++; // 기록 도중 전원 차단 → 버림
+      continue;
+    }
+
+    // 종료 기록이 중간에 끊겼으면 마저 씀
+    if (slot.dur_crc == ERASED16 && close_torn(&slot))
+      repair_close(fs, v, &slot);
+
+    // 종료 기록이 없거나 깨졌으면 진행 중으로 취급
+    if (slot.dur_crc == ERASED16 || slot.dur_crc != dur_crc(&slot)) {
+      slot.rec.packed |= ~KEY_MASK;
+      slot.st.integral = 0; // 통계는 재부팅 후 다시 누적
+      slot.st.stats = 0;
+    }
+
+    // 앞쪽 레코드 통계는 뒤 레코드가 같은 칸을 덮어씀 → 최근 것만 남음
+    log->rec[log->head] = slot.rec;
+    log->stats[log->head % WATERLOG_STATS_MAX] = slot.st;
+    log->head = (log->head + 1) % WATERLOG_MAX;
+    if (log->count < WATERLOG_MAX)
+      log->count++;
+  }
+
+  // ⭐ 마지막 이벤트가 진행 중이면 재부팅 후에도 그 상태에서 이어감
+  if (log->count > 0 && fs->tail > 0) {
+    uint16_t last = (log->head == 0) ? WATERLOG_MAX - 1 : log->head - 1;
+    if (WATERLOG_DUR(log->rec[last].packed) == WATERLOG_DUR_ONGOING) {
+      log->live_state = WATERLOG_STATE(log->rec[last].packed);
+      fs->last_open = 1;
+
+      // 통계 누적은 시작 수위부터 다시. 전원 차단 전까지의 누적분은 플래시에
+      // 없으므로 잃고, last_t = 시작 시각이라 시작 ~ 재부팅 후 첫 샘플 구간
+      // (꺼져 있던 시간 포함)은 첫 live_add 에서 그 샘플 수위로 한꺼번에 적분됨
+      uint8_t lvl = WATERLOG_LEVEL(log->rec[last].packed);
+      log->live.peak = lvl;
+      log->live.trough = lvl;
+      log->live.n = 1;
+      log->live.sum = lvl;
+      log->live.integral = 0;
+      log->live.last_t = log->rec[last].start;
+    }
+  }
+}
+
+uint8_t WLFlash_Service(WLFlash_t *fs) {
+  if (fs->ops == NULL || fs->spare_ready || fs->last_open ||
+      fs->tail < WLFLASH_SPARE_MARK(fs))
+    return 0;
+
+  // 이전 섹터 기록은 여기서 버림 (현재 섹터에 WATERLOG_MAX 이상 남아 있음)
+  uint8_t spare = fs->active ^ 1;
+  if (!sector_blank(fs, spare) && !erase_sector(fs, spare))
+    return 0;
+  fs->prev_valid = 0;
+  fs->prev_tail = 0;
+  fs->spare_ready = 1;
+  return 1;
+}
+
+uint8_t WLFlash_Append(WLFlash_t *fs, const WaterRecord_t *rec) {
+  if (fs->tail >= fs->slots_per_sector) {
+    // 현재 섹터 가득 참 → 다른 섹터에 이어서 기록
+    // ⭐ 보통은 WLFlash_Service 가 미리 지워 둠 → 헤더만 기록
+    //    아니면 여기서 지움 (STM32 128KB 는 1~2초 멈춤)
+    uint8_t next = fs->active ^ 1;
+    uint8_t ok = fs->spare_ready ? write_header(fs, next, fs->seq + 1)
+                                 : format_sector(fs, next, fs->seq + 1);
+    if (!ok)
+      return 0;
+    fs->prev_tail = fs->tail;
+    fs->prev_valid = 1;
+    fs->spare_ready = 0;
+    fs->active = next;
+    fs->seq++;
+    fs->tail = 0;
+  }
+
+  WLFlash_Slot_t slot;
+  slot.rec = *rec;
+  slot.crc = slot_crc(rec);
+  slot.dur_crc = ERASED16;
+
+  // start 를 먼저 기록 → 중간에 끊겨도 tail 탐색에서 사용 중으로 보임
+  // 통계는 지워진 상태로 두고 종료 시 기록
+  uint32_t off = slot_offset(fs->tail);
+  uint32_t crc_off = off + offsetof(WLFlash_Slot_t, crc);
+  uint8_t ok = fs->ops->program(fs->active, off, &slot.rec.start, 4) == 0 &&
+               fs->ops->program(fs->active, off + 4, &slot.rec.packed, 4) == 0 &&
+               fs->ops->program(fs->active, crc_off, &slot.crc, 4) == 0;
+  fs->tail++;
+
+  if (!ok) {
+    fs->io_errors++;
+    fs->last_open = 0;
+    return 0;
+  }
+  fs->appends++;
+  fs->last_open = (WATERLOG_DUR(rec->packed) == WATERLOG_DUR_ONGOING);
+  return 1;
+}
+
+uint8_t WLFlash_CloseLast(WLFlash_t *fs, const WaterRecord_t *rec,
+                          const WaterStats_t *st) {
+  if (!fs->last_open || fs->tail == 0)
+    return 0;
+
+  WLFlash_Slot_t slot;
+  uint32_t off = slot_offset(fs->tail - 1);
+  if (fs->ops->read(fs->active, off, &slot, sizeof(slot)) != 0) {
+    fs->io_errors++;
+    return 0;
+  }
+
+  // 지속 시간 비트만 1 → 0 (진행 중 = 전부 1 이므로 항상 가능)
+  slot.rec.packed &= rec->packed | KEY_MASK;
+  slot.st = *st;
+  slot.dur_crc = dur_crc(&slot);
+
+  // 통계 → 지속 시간 → CRC 순 (CRC 가 마지막이라 중간에 끊기면 진행 중으로 복원)
+  uint32_t crc_off = off + offsetof(WLFlash_Slot_t, crc);
+  uint32_t st_off = off + offsetof(WLFlash_Slot_t, st);
+  uint8_t ok = fs->ops->program(fs->active, st_off, &slot.st, 8) == 0 &&
+               fs->ops->program(fs->active, off + 4, &slot.rec.packed, 4) == 0 &&
+               fs->ops->program(fs->active, crc_off, &slot.crc, 4) == 0;
+  fs->last_open = 0;
+  if (!ok) {
+    fs->io_errors++;
+    return 0;
+  }
+  fs->closes++;
+  return 1;
+}
@@ -1,49 +1,159 @@
 #include "water_state_logger.h"
+#include "water_log_flash.h"
+#include <stdio.h>
 #include <string.h>
 
-static WaterState_t calc_state(uint8_t level, uint8_t th_low, uint8_t th_high) {
-  if (level < th_low)
-    return WATER_ST_LOW;
-  if (level > th_high)
-    return WATER_ST_HIGH;
-  return WATER_ST_OK;
+// ========== 시간 변환 ==========
+#define EPOCH_2000 946684800u // 2000-01-01 00:00:00 UTC
+#define DAYS_PER_4Y 1461u
+
+static const uint16_t days_before_month[12] = {0,   31,  59,  90,  120, 151,
+                                               181, 212, 243, 273, 304, 334};
+
+uint32_t WaterLog_ToEpoch(const RTC_TimeTypeDef *t, const RTC_DateTypeDef *d) {
+  uint32_t y = d->Year; // 2000년부터
+  uint32_t m = (d->Month >= 1 && d->Month <= 12) ? d->Month : 1;
+
+  // 2000년이 윤년이므로 y년 이전 윤년 수 = (y + 3) / 4
+  uint32_t days = y * 365u + (y + 3u) / 4u + days_before_month[m - 1] +
+                  (d->Date ? d->Date - 1u : 0u);
+  if (m > 2 && (y % 4u) == 0)
+    days++;
+
+  return EPOCH_2000 + days * 86400u + t->Hours * 3600u + t->Minutes * 60u +
+         t->Seconds;
+}
+
+void WaterLog_FromEpoch(uint32_t epoch, RTC_TimeTypeDef *t,
+                        RTC_DateTypeDef *d) {
+  uint32_t s = (epoch > EPOCH_2000) ? epoch - EPOCH_2000 : 0;
+  uint32_t days = s / 86400u;
+  uint32_t sec = s % 86400u;
+
+  t->Hours = sec / 3600u;
+  t->Minutes = (sec / 60u) % 60u;
+  t->Seconds = sec % 60u;
+
+  d->WeekDay = ((days + 5u) % 7u) + 1u; // 2000-01-01 토요일, 월=1 ~ 일=7
+
+  uint32_t y = (days / DAYS_PER_4Y) * 4u;
+  uint32_t rem = days % DAYS_PER_4Y;
+  if (rem >= 366u) { // 4년 주기 첫 해가 윤년
+    y += 1u + (rem - 366u) / 365u;
+    rem = (rem - 366u) % 365u;
+  }
+  uint8_t leap = (y % 4u) == 0;
+
+  uint8_t m = 12;
+  while (m > 1) {
+    uint32_t before = days_before_month[m - 1] + ((leap && m > 2) ? 1u : 0u);
+    if (rem >= before) {
+      rem -= before;
+      break;
+    }
+    m--;
+  }
+
+  d->Year = (uint8_t)y;
+  d->Month = m;
+  d->Date = (uint8_t)(rem + 1u);
+}
+
+// ========== 로그 ==========
+// view 0 = 가장 오래된 레코드 (head - count 위치)
+static uint16_t rec_index(const WaterLog_t *log, uint16_t view) {
+  return (uint16_t)(((uint32_t)log->head + WATERLOG_MAX - log->count + view) %
+                    WATERLOG_MAX);
+}
+
+static const WaterRecord_t *rec_at(const WaterLog_t *log, uint16_t view) {
+  return &log->rec[rec_index(log, view)];
+}
+
+// 순서 끊김 수 갱신: 밀려나는 가장 오래된 쌍은 빼고, 새 쌍은 더함
+static void track_order(WaterLog_t *log, uint32_t now) {
+  if (log->count == WATERLOG_MAX &&
+      rec_at(log, 1)->start < rec_at(log, 0)->start)
+    log->breaks--;
+  if (log->count > 0 && now < rec_at(log, log->count - 1)->start)
+    log->breaks++;
 }
 
 static void push_event(WaterLog_t *log, WaterState_t st, uint8_t level,
-                       const RTC_TimeTypeDef *t, const RTC_DateTypeDef *d) {
-  WaterEvent_t *dst = &log->ev[log->head];
-  dst->state = st;
-  dst->level_percent = level;
-  dst->t_start = *t; // 시작 시간
-  dst->d_start = *d; // 시작 날짜
-  dst->ended = 0;    // 아직 종료 안 됨
+                       uint32_t now) {
+  track_order(log, now);
+
+  WaterRecord_t *dst = &log->rec[log->head];
+  dst->start = now;
+  dst->packed = WATERLOG_PACK(WATERLOG_DUR_ONGOING, st, level); // 아직 종료 안 됨
+
+  // 같은 칸을 쓰던 오래된 이벤트 통계는 여기서 버려짐
+  WaterStats_t *sd = &log->stats[log->head % WATERLOG_STATS_MAX];
+  sd->integral = 0;
+  sd->stats = 0;
+
+  // ⭐ 누적 시작 (시작 순간 샘플 포함)
+  log->live.peak = level;
+  log->live.trough = level;
+  log->live.n = 1;
+  log->live.sum = level;
+  log->live.integral = 0;
+  log->live.last_t = now;
+
+  if (log->store)
+    WLFlash_Append(log->store, dst);
 
   log->head = (log->head + 1) % WATERLOG_MAX;
   if (log->count < WATERLOG_MAX)
     log->count++;
 }
 
-// ⭐ 가장 최근 이벤트에 종료 시간 기록
-static void end_current_event(WaterLog_t *log, const RTC_TimeTypeDef *t,
-                              const RTC_DateTypeDef *d) {
+// 진행 중 이벤트에 샘플 하나 반영 (O(1))
+static void live_add(WaterLog_Live_t *lv, uint8_t level, uint32_t now) {
+  if (now > lv->last_t) {
+    uint32_t add = (uint32_t)level * (now - lv->last_t);
+    lv->integral = (lv->integral > UINT32_MAX - add) ? UINT32_MAX
+                                                     : lv->integral + add;
+    lv->last_t = now;
+  }
+  if (level > lv->peak)
+    lv->peak = level;
+  if (level < lv->trough)
+    lv->trough = level;
+  lv->n++;
+  lv->sum += level;
+}
+
+static uint32_t live_stats(const WaterLog_Live_t *lv) {
+  uint8_t mean = lv->n ? (uint8_t)((lv->sum + lv->n / 2) / lv->n) : 0;
+  return WATERLOG_STATS(lv->peak, lv->trough, mean) | WATERLOG_STATS_VALID;
+}
+
+// ⭐ 가장 최근 이벤트에 지속 시간 + 통계 기록
+static void end_current_event(WaterLog_t *log, uint32_t now) {
   if (log->count == 0)
     return; // 로그 없음
 
-  // 가장 최근 이벤트 찾기
-  int last_idx = (log->head - 1);
-  if (last_idx < 0)
-    last_idx += WATERLOG_MAX;
-
-  WaterEvent_t *last = &log->ev[last_idx];
+  // 가장 최근 이벤트
+  uint16_t last_idx = (log->head == 0) ? WATERLOG_MAX - 1 : log->head - 1;
+  WaterRecord_t *last = &log->rec[last_idx];
 
   // 이미 종료된 이벤트면 무시
-  if (last->ended)
+  if (WATERLOG_DUR(last->packed) != WATERLOG_DUR_ONGOING)
     return;
 
-  // 종료 시간 기록
-  last->t_end = *t;
-  last->d_end = *d;
-  last->ended = 1;
+  uint32_t dur = (now > last->start) ? now - last->start : 0;
+  if (dur > WATERLOG_DUR_MAX)
+    dur = WATERLOG_DUR_MAX;
+
+  last->packed = WATERLOG_PACK(dur, WATERLOG_STATE(last->packed),
+                               WATERLOG_LEVEL(last->packed));
+  WaterStats_t *st = &log->stats[last_idx % WATERLOG_STATS_MAX];
+  st->integral = log->live.integral;
+  st->stats = live_stats(&log->live);
+
+  if (log->store)
+    WLFlash_CloseLast(log->store, last, st);
 }
 
 void WaterLog_Init(WaterLog_t *log) {
@@ -51,43 +161,218 @@ void WaterLog_Init(WaterLog_t *log) {
   log->live_state = WATER_ST_OK;
 }
 
-void WaterLog_Update(WaterLog_t *log, uint8_t level_percent, uint8_t th_low,
-                     uint8_t th_high, const RTC_TimeTypeDef *now_t,
+void WaterLog_AttachStore(WaterLog_t *log, struct WLFlash *store) {
+  log->store = store;
+  if (!store)
+    return;
+  WLFlash_Replay(store, log);
+
+  // 되살린 기록에 RTC 가 되돌아간 구간이 있을 수 있음
+  log->breaks = 0;
+  for (uint16_t v = 1; v < log->count; v++) {
+    if (rec_at(log, v)->start < rec_at(log, v - 1)->start)
+      log->breaks++;
+  }
+}
+
+void WaterLog_Update(WaterLog_t *log, WaterState_t new_state,
+                     uint8_t level_percent, const RTC_TimeTypeDef *now_t,
                      const RTC_DateTypeDef *now_d) {
-  WaterState_t new_state = calc_state(level_percent, th_low, th_high);
+  uint32_t now = WaterLog_ToEpoch(now_t, now_d);
+  log->live_now = now;
 
-  // 상태 변화가 없으면 아무 것도 안 함
+  // 상태 변화가 없으면 진행 중 이벤트 통계만 갱신
   if (new_state == log->live_state) {
+    if (new_state != WATER_ST_OK)
+      live_add(&log->live, level_percent, now);
     return;
   }
 
   // OK로 복귀하는 경우 → 이전 이벤트 종료
   if (new_state == WATER_ST_OK) {
-    end_current_event(log, now_t, now_d);
+    end_current_event(log, now);
     log->live_state = WATER_ST_OK;
     return;
   }
 
+  // LOW ↔ HIGH 직행이면 이전 이벤트도 여기서 끝남
+  end_current_event(log, now);
+
   // LOW/HIGH로 진입하는 경우 → 새 이벤트 시작
   log->live_state = new_state;
-  push_event(log, new_state, level_percent, now_t, now_d);
+  push_event(log, new_state, level_percent, now);
 }
 
-uint8_t WaterLog_Count(const WaterLog_t *log) { return log->count; }
+uint16_t WaterLog_Count(const WaterLog_t *log) { return log->count; }
 
-const WaterEvent_t *WaterLog_GetByViewIndex(const WaterLog_t *log,
-                                            uint8_t view_index) {
-  if (log->count == 0)
-    return NULL;
+uint8_t WaterLog_GetByViewIndex(const WaterLog_t *log, uint16_t view_index,
+                                WaterEvent_t *out) {
   if (view_index >= log->count)
-    return NULL;
+    return 0;
+
+  uint16_t idx = rec_index(log, view_index);
+  const WaterRecord_t *r = &log->rec[idx];
+  uint32_t dur = WATERLOG_DUR(r->packed);
+
+  out->state = WATERLOG_STATE(r->packed);
+  out->level_percent = WATERLOG_LEVEL(r->packed);
+  out->start_epoch = r->start;
+  WaterLog_FromEpoch(r->start, &out->t_start, &out->d_start);
+
+  out->ended = (dur != WATERLOG_DUR_ONGOING);
+  uint32_t stats = 0;
+  out->integral = 0;
+  if (out->ended) {
+    out->duration_s = dur;
+    // 최근 WATERLOG_STATS_MAX 개 안이면 통계 표에 있음, 아니면 플래시 슬롯
+    // (RAM 의 마지막 레코드 = 플래시의 마지막 슬롯)
+    if (view_index + WATERLOG_STATS_MAX >= log->count) {
+      const WaterStats_t *st = &log->stats[idx % WATERLOG_STATS_MAX];
+      stats = st->stats;
+      out->integral = st->integral;
+    } else if (log->store) {
+      uint32_t back = (uint32_t)(log->count - view_index);
+      uint32_t total = WLFlash_Count(log->store);
+      WaterStats_t st;
+      if (back <= total &&
+          WLFlash_ReadStats(log->store, total - back, r, &st)) {
+        stats = st.stats;
+        out->integral = st.integral;
+      }
+    }
+    WaterLog_FromEpoch(r->start + dur, &out->t_end, &out->d_end);
+  } else {
+    // 진행 중 (마지막 레코드): 누적기에서 지금까지 값
+    out->duration_s = (log->live_now > r->start) ? log->live_now - r->start : 0;
+    out->integral = log->live.integral;
+    stats = live_stats(&log->live);
+    memset(&out->t_end, 0, sizeof(out->t_end));
+    memset(&out->d_end, 0, sizeof(out->d_end));
+  }
+  out->has_stats = (stats & WATERLOG_STATS_VALID) ? 1 : 0;
+  if (!out->has_stats)
+    out->integral = 0;
+  out->peak_percent = WATERLOG_PEAK(stats);
+  out->trough_percent = WATERLOG_TROUGH(stats);
+  out->mean_percent = WATERLOG_MEAN(stats);
+  return 1;
+}
+
+// ========== 조회 ==========
+uint16_t WaterLog_FindFirstAtOrAfter(const WaterLog_t *log, uint32_t epoch) {
+  if (log->breaks) {
+    // 순서가 끊긴 곳이 있으면 이진 탐색 결과를 믿을 수 없음
+    for (uint16_t v = 0; v < log->count; v++) {
+      if (rec_at(log, v)->start >= epoch)
+        return v;
+    }
+    return log->count;
+  }
 
-  int oldest = (int)log->head - (int)log->count;
-  while (oldest < 0)
-    oldest += WATERLOG_MAX;
+  uint16_t lo = 0, hi = log->count;
+  while (lo < hi) {
+    uint16_t mid = lo + (hi - lo) / 2;
+    if (rec_at(log, mid)->start < epoch)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+static uint8_t match(const WaterRecord_t *r, uint8_t filter) {
+  return (filter >> WATERLOG_STATE(r->packed)) & 1u;
+}
 
-  int idx = oldest + view_index;
-  idx %= WATERLOG_MAX;
+uint16_t WaterLog_FindNext(const WaterLog_t *log, uint16_t from,
+                           uint8_t filter) {
+  for (uint16_t v = from; v < log->count; v++) {
+    if (match(rec_at(log, v), filter))
+      return v;
+  }
+  return WATERLOG_NONE;
+}
+
+uint16_t WaterLog_FindPrev(const WaterLog_t *log, uint16_t from,
+                           uint8_t filter) {
+  if (log->count == 0)
+    return WATERLOG_NONE;
+  if (from >= log->count)
+    from = log->count - 1;
 
-  return &log->ev[idx];
-}
\ No newline at end of file
+  for (int32_t v = from; v >= 0; v--) {
+    if (match(rec_at(log, (uint16_t)v), filter))
+      return (uint16_t)v;
+  }
+  return WATERLOG_NONE;
+}
+
+void WaterLog_Aggregate(const WaterLog_t *log, uint32_t from, uint32_t to,
+                        uint32_t now, WaterLog_Agg_t *out) {
+  memset(out, 0, sizeof(*out));
+
+  // 이벤트는 겹치지 않으므로 from 이전 시작 중에는 바로 앞 하나만 걸칠 수 있음
+  // (순서가 끊겼으면 처음부터 전부, 각 레코드를 따로 판단)
+  uint16_t v = 0;
+  if (!log->breaks) {
+    v = WaterLog_FindFirstAtOrAfter(log, from);
+    if (v > 0)
+      v--;
+  }
+
+  for (; v < log->count; v++) {
+    const WaterRecord_t *r = rec_at(log, v);
+    if (r->start >= to) {
+      if (!log->breaks)
+        break; // 시간 순이면 뒤도 모두 구간 밖
+      continue;
+    }
+
+    uint32_t dur = WATERLOG_DUR(r->packed);
+    uint32_t end = (dur == WATERLOG_DUR_ONGOING) ? now : r->start + dur;
+    if (end <= from)
+      continue;
+
+    uint32_t a = (r->start > from) ? r->start : from;
+    uint32_t b = (end < to) ? end : to;
+    WaterState_t st = WATERLOG_STATE(r->packed);
+    out->count[st]++;
+    out->seconds[st] += (b > a) ? b - a : 0;
+  }
+}
+
+// ========== 내보내기 ==========
+void WaterLog_ExportHeader(void) {
+  printf("start,state,start_level,duration_s,peak,trough,mean,integral_pct_s,"
+         "ended\r\n");
+}
+
+uint16_t WaterLog_ExportCSV(const WaterLog_t *log, uint16_t from,
+                            uint16_t max_lines, const WaterLog_Range_t *range) {
+  WaterEvent_t ev;
+  uint16_t v = from;
+
+  for (; v < log->count && max_lines > 0; v++) {
+    const WaterRecord_t *r = rec_at(log, v);
+    if (r->start >= range->to) {
+      if (!log->breaks)
+        return log->count; // 시간 순이면 뒤도 모두 범위 밖
+      continue;
+    }
+    if (r->start < range->from || !match(r, range->filter))
+      continue;
+
+    max_lines--;
+    WaterLog_GetByViewIndex(log, v, &ev);
+    printf("%lu,%s,%u,%lu,", (unsigned long)ev.start_epoch,
+           (ev.state == WATER_ST_LOW) ? "LOW" : "HIGH", ev.level_percent,
+           (unsigned long)ev.duration_s);
+    if (ev.has_stats) {
+      printf("%u,%u,%u,%lu,%u\r\n", ev.peak_percent, ev.trough_percent,
+             ev.mean_percent, (unsigned long)ev.integral, ev.ended);
+    } else {
+      printf(",,,,%u\r\n", ev.ended); // 통계 없음 → 빈 칸
+    }
+  }
+  return v;
+}
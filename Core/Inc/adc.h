@@ -35,12 +35,41 @@ extern "C" {
 extern ADC_HandleTypeDef hadc1;
 
 /* USER CODE BEGIN Private defines */
+// ADC 스캔 순서 (Rank 1~4)
+#define ADC_CH_JOY_X 0 // PA0 IN0: 조이스틱 X
+#define ADC_CH_LEVEL 1 // PA1 IN1: 수위 센서
+#define ADC_CH_JOY_Y 2 // PA4 IN4: 조이스틱 Y
+#define ADC_CH_TEMP 3  // 내부 온도 센서
+#define ADC_NUM_CH 4
+
+// 오버샘플링 / 데시메이션
+// 1프레임(4채널) = 4 x (480+12)사이클 / 21MHz ≈ 94us
+// 반 버퍼(32프레임) ≈ 3ms마다 콜백, 4개 반 버퍼를 합쳐 ≈ 12ms(83Hz)마다 출력
+// 채널당 128샘플 평균 → 12비트 + 약 3.5비트
+#ifndef ADC_HALF_FRAMES
+#define ADC_HALF_FRAMES 32
+#endif
+#ifndef ADC_DECIMATION
+#define ADC_DECIMATION 4
+#endif
+#define ADC_HIRES_MAX (4095u * 16u) // hires 값 최대 (12비트 << 4)
+
+// 한 출력 주기의 일관된 샘플 프레임
+typedef struct {
+  uint16_t raw[ADC_NUM_CH];   // 평균값, 12비트 스케일 (0~4095)
+  uint16_t hires[ADC_NUM_CH]; // 평균값, 16비트 스케일 (0~ADC_HIRES_MAX)
+  uint32_t seq;               // 출력 번호 (새 프레임 확인용)
+  uint32_t tick;              // 출력 시각 (HAL_GetTick)
+  uint32_t stamp;             // 출력 시각 (Prof_Now 틱, 지연 측정용)
+} ADC_Frame_t;
 
 /* USER CODE END Private defines */
 
 void MX_ADC1_Init(void);
 
 /* USER CODE BEGIN Prototypes */
+HAL_StatusTypeDef ADC_Pipeline_Start(void);
+uint8_t ADC_GetFrame(ADC_Frame_t *frame); // 아직 출력 없으면 0
 
 /* USER CODE END Prototypes */
 
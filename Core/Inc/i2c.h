@@ -35,6 +35,10 @@ extern "C" {
 extern I2C_HandleTypeDef hi2c1;
 
 /* USER CODE BEGIN Private defines */
+// 1: I2C1 Fast-mode(400kHz) 프로파일 사용 (기본 0 = Standard-mode 100kHz)
+#ifndef I2C1_FAST_MODE
+#define I2C1_FAST_MODE 0
+#endif
 
 /* USER CODE END Private defines */
 
@@ -37,6 +37,8 @@ extern TIM_HandleTypeDef htim2;
 extern TIM_HandleTypeDef htim3;
 
 /* USER CODE BEGIN Private defines */
+// TIM2: 1MHz 프리런 카운터 (ARR 65535). CH1 출력 비교로 1ms 틱 인터럽트
+#define TIM2_TICK_US 1000
 
 /* USER CODE END Private defines */
 
@@ -35,12 +35,49 @@ extern "C" {
 extern UART_HandleTypeDef huart2;
 
 /* USER CODE BEGIN Private defines */
+// printf 송신 링 (DMA1 Stream6로 비움), 2의 거듭제곱
+#define UART_TX_RING_SIZE 1024
+
+// 링이 가득 찼을 때 정책
+#define UART_TX_POLICY_DROP 0  // 넘치는 바이트 버림 (메인 루프 지연 없음)
+#define UART_TX_POLICY_BLOCK 1 // 빈 자리 날 때까지 대기 (ISR/인터럽트 금지 중엔 버림)
+#ifndef UART_TX_FULL_POLICY
+#define UART_TX_FULL_POLICY UART_TX_POLICY_DROP
+#endif
+
+typedef struct
+{
+  uint32_t written;    // 링에 들어간 바이트
+  uint32_t dropped;    // 버린 바이트
+  uint32_t blocked;    // BLOCK 정책에서 대기한 횟수
+  uint32_t errors;     // DMA 오류
+  uint16_t depth;      // 현재 대기 바이트
+  uint16_t high_water; // 최대 대기 바이트
+} UART_TxStats_t;
+
+// 수신 원형 DMA 버퍼 (DMA1 Stream5), 2의 거듭제곱
+#define UART_RX_DMA_SIZE 256
+
+typedef struct
+{
+  uint32_t received;  // 수신 바이트
+  uint32_t overflows; // 메인 루프가 한 바퀴 이상 늦어 버린 횟수
+  uint32_t errors;    // 오버런/프레이밍 오류로 수신 재시작
+} UART_RxStats_t;
 
 /* USER CODE END Private defines */
 
 void MX_USART2_UART_Init(void);
 
 /* USER CODE BEGIN Prototypes */
+uint16_t UART_TxWrite(const uint8_t *data, uint16_t len);
+uint16_t UART_TxWriteText(const uint8_t *data, uint16_t len);
+void UART_SetTextMute(uint8_t mute);
+void UART_GetTxStats(UART_TxStats_t *stats);
+void UART_RxStart(void);
+uint16_t UART_RxRead(uint8_t *buf, uint16_t max);
+uint16_t UART_RxDmaPos(void);
+void UART_GetRxStats(UART_RxStats_t *stats);
 
 /* USER CODE END Prototypes */
 
@@ -21,6 +21,21 @@
 #include "adc.h"
 
 /* USER CODE BEGIN 0 */
+#include "prof.h"
+
+// 원형 DMA 버퍼: 앞/뒤 절반을 번갈아 처리 (Half / Complete 콜백)
+#define ADC_DMA_LEN (2 * ADC_HALF_FRAMES * ADC_NUM_CH)
+#define ADC_OUT_SAMPLES (ADC_HALF_FRAMES * ADC_DECIMATION)
+
+static uint16_t adc_dma_buf[ADC_DMA_LEN];
+static uint32_t adc_acc[ADC_NUM_CH]; // 데시메이션 누적
+static uint8_t adc_acc_blocks = 0;
+
+// 출력 프레임 (seqlock: 쓰는 동안 adc_out_lock 홀수)
+// adc_out 은 volatile 이 아니므로 lock 과 프레임 접근 사이에 __DMB()
+// (컴파일러 재배치 + 메모리 순서 모두 막음)
+static ADC_Frame_t adc_out;
+static volatile uint32_t adc_out_lock = 0;
 
 /* USER CODE END 0 */
 
@@ -177,5 +192,77 @@ void HAL_ADC_MspDeInit(ADC_HandleTypeDef* adcHandle)
 }
 
 /* USER CODE BEGIN 1 */
+HAL_StatusTypeDef ADC_Pipeline_Start(void)
+{
+  adc_acc_blocks = 0;
+  for (int ch = 0; ch < ADC_NUM_CH; ch++)
+  {
+    adc_acc[ch] = 0;
+  }
+  return HAL_ADC_Start_DMA(&hadc1, (uint32_t *)adc_dma_buf, ADC_DMA_LEN);
+}
+
+// 반 버퍼 하나 누적, ADC_DECIMATION개 모이면 프레임 출력 (DMA ISR)
+static void ADC_ProcessBlock(const uint16_t *block)
+{
+  for (int f = 0; f < ADC_HALF_FRAMES; f++)
+  {
+    for (int ch = 0; ch < ADC_NUM_CH; ch++)
+    {
+      adc_acc[ch] += block[f * ADC_NUM_CH + ch];
+    }
+  }
+
+  if (++adc_acc_blocks < ADC_DECIMATION)
+  {
+    return;
+  }
+
+  adc_out_lock++; // 홀수: 쓰는 중
+  __DMB();        // 프레임 쓰기가 홀수 표시보다 앞서지 않게
+  for (int ch = 0; ch < ADC_NUM_CH; ch++)
+  {
+    adc_out.raw[ch] = (uint16_t)(adc_acc[ch] / ADC_OUT_SAMPLES);
+    adc_out.hires[ch] = (uint16_t)((adc_acc[ch] * 16u) / ADC_OUT_SAMPLES);
+    adc_acc[ch] = 0;
+  }
+  adc_out.seq++;
+  adc_out.tick = HAL_GetTick();
+  adc_out.stamp = PROF_NOW();
+  __DMB();        // 프레임 쓰기가 모두 끝난 뒤 짝수로
+  adc_out_lock++; // 짝수: 완료
+  adc_acc_blocks = 0;
+}
+
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+  if (hadc->Instance == ADC1)
+  {
+    ADC_ProcessBlock(&adc_dma_buf[0]);
+  }
+}
+
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+  if (hadc->Instance == ADC1)
+  {
+    ADC_ProcessBlock(&adc_dma_buf[ADC_DMA_LEN / 2]);
+  }
+}
+
+// 메인 루프용: 찢어지지 않은 프레임 복사 (ISR이 중간에 갱신하면 다시 읽음)
+uint8_t ADC_GetFrame(ADC_Frame_t *frame)
+{
+  uint32_t lock;
+  do
+  {
+    lock = adc_out_lock;
+    __DMB(); // lock 을 읽은 뒤 복사
+    *frame = adc_out;
+    __DMB(); // 복사를 끝낸 뒤 lock 다시 읽기
+  } while ((lock & 1u) || lock != adc_out_lock);
+
+  return frame->seq != 0;
+}
 
 /* USER CODE END 1 */
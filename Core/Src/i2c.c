@@ -51,6 +51,20 @@ void MX_I2C1_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN I2C1_Init 2 */
+#if I2C1_FAST_MODE
+  // Fast-mode 400kHz, Tlow/Thigh = 2 (PCLK1 42MHz ≥ 4MHz 조건 만족)
+  // - HD44780: E 펄스 폭 ≥ 450ns → 1바이트(22.5us) 동안 E=1 유지, 충분
+  // - HD44780: 명령 실행 37us → 다음 E 스트로브까지 2바이트(45us), 충분
+  //   (Clear 0x01의 1.52ms는 LCD_Init에서만 쓰고 HAL_Delay로 기다림)
+  // - PCF8574: 데이터시트 보증 SCL은 100kHz까지. 400kHz에서 동작 확인된
+  //   백팩 모듈에서만 켤 것
+  hi2c1.Init.ClockSpeed = 400000;
+  hi2c1.Init.DutyCycle = I2C_DUTYCYCLE_2;
+  if (HAL_I2C_Init(&hi2c1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+#endif
 
   /* USER CODE END I2C1_Init 2 */
 
@@ -81,6 +95,11 @@ void HAL_I2C_MspInit(I2C_HandleTypeDef* i2cHandle)
     /* I2C1 clock enable */
     __HAL_RCC_I2C1_CLK_ENABLE();
   /* USER CODE BEGIN I2C1_MspInit 1 */
+    // LCD 비동기 전송 큐 (HAL_I2C_Master_Transmit_IT)
+    HAL_NVIC_SetPriority(I2C1_EV_IRQn, 3, 0);
+    HAL_NVIC_EnableIRQ(I2C1_EV_IRQn);
+    HAL_NVIC_SetPriority(I2C1_ER_IRQn, 3, 0);
+    HAL_NVIC_EnableIRQ(I2C1_ER_IRQn);
 
   /* USER CODE END I2C1_MspInit 1 */
   }
@@ -106,11 +125,22 @@ void HAL_I2C_MspDeInit(I2C_HandleTypeDef* i2cHandle)
     HAL_GPIO_DeInit(GPIOB, GPIO_PIN_9);
 
   /* USER CODE BEGIN I2C1_MspDeInit 1 */
+    HAL_NVIC_DisableIRQ(I2C1_EV_IRQn);
+    HAL_NVIC_DisableIRQ(I2C1_ER_IRQn);
 
   /* USER CODE END I2C1_MspDeInit 1 */
   }
 }
 
 /* USER CODE BEGIN 1 */
+void I2C1_EV_IRQHandler(void)
+{
+  HAL_I2C_EV_IRQHandler(&hi2c1);
+}
+
+void I2C1_ER_IRQHandler(void)
+{
+  HAL_I2C_ER_IRQHandler(&hi2c1);
+}
 
 /* USER CODE END 1 */
@@ -29,6 +29,7 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "ap.h"
+#include "prof.h"
 #include <stdio.h>
 /* USER CODE END Includes */
 
@@ -63,7 +64,11 @@ void SystemClock_Config(void);
 #endif
 
 PUTCHAR_PROTOTYPE {
-  HAL_UART_Transmit(&huart2, (uint8_t *)&ch, 1, 0xFFFF);
+  // ⭐ 링에 넣고 바로 반환 (DMA가 백그라운드 전송, usart.c)
+  uint8_t c = (uint8_t)ch;
+  PROF_START(t0);
+  UART_TxWriteText(&c, 1);
+  PROF_STOP(t0, PROF_Z_PUTCHAR);
   return ch;
 }
 /* USER CODE END PFP */
@@ -173,6 +178,30 @@ void SystemClock_Config(void)
 }
 
 /* USER CODE BEGIN 4 */
+// TIM2 CH1: 1ms 틱. 카운터는 계속 돌리고 비교값만 앞으로 옮긴다
+// (ARR = 65535 이므로 16비트 덧셈 wrap 이 카운터 주기와 일치)
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim)
+{
+  if (htim->Instance == TIM2 && htim->Channel == HAL_TIM_ACTIVE_CHANNEL_1)
+  {
+    uint16_t next = (uint16_t)(__HAL_TIM_GET_COMPARE(htim, TIM_CHANNEL_1) + TIM2_TICK_US);
+    __HAL_TIM_SET_COMPARE(htim, TIM_CHANNEL_1, next);
+
+    PROF_START(t0);
+    Keypad_ScanTick();
+    PROF_STOP(t0, PROF_Z_KEYPAD);
+    Modbus_TickISR();
+  }
+}
+
+// TIM3 CH4 입력 캡처: DHT11 하강 에지
+void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim)
+{
+  if (htim->Instance == TIM3 && htim->Channel == HAL_TIM_ACTIVE_CHANNEL_4)
+  {
+    DHT11_CaptureISR((uint16_t)HAL_TIM_ReadCapturedValue(htim, TIM_CHANNEL_4));
+  }
+}
 
 /* USER CODE END 4 */
 
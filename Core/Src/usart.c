@@ -21,6 +21,25 @@
 #include "usart.h"
 
 /* USER CODE BEGIN 0 */
+// 송신 링: head는 메인 루프(생산자), tail은 DMA 완료 ISR(소비자)만 움직임
+// 인덱스는 자유 증가 uint16, 사용 시 UART_TX_RING_SIZE로 마스킹
+static uint8_t uart_tx_ring[UART_TX_RING_SIZE];
+static volatile uint16_t uart_tx_head = 0;
+static volatile uint16_t uart_tx_tail = 0;
+static volatile uint16_t uart_tx_inflight = 0; // DMA로 나가는 중인 바이트
+static UART_TxStats_t uart_tx_stats;
+static volatile uint8_t uart_text_mute = 0; // 바이너리 프로토콜(Modbus) 사용 중
+
+// 수신: 원형 DMA가 계속 채우고, idle/반/끝 이벤트마다 ISR이 head를 전진
+// head/tail은 누적 바이트 수, (head % UART_RX_DMA_SIZE) == DMA 쓰기 위치
+static uint8_t uart_rx_dma[UART_RX_DMA_SIZE];
+static volatile uint32_t uart_rx_head = 0;
+static uint32_t uart_rx_tail = 0;
+static uint16_t uart_rx_last_pos = 0; // 마지막 이벤트 때의 DMA 위치
+static UART_RxStats_t uart_rx_stats;
+
+DMA_HandleTypeDef hdma_usart2_tx;
+DMA_HandleTypeDef hdma_usart2_rx;
 
 /* USER CODE END 0 */
 
@@ -51,7 +70,7 @@ void MX_USART2_UART_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN USART2_Init 2 */
-
+  UART_RxStart();
   /* USER CODE END USART2_Init 2 */
 
 }
@@ -81,7 +100,51 @@ void HAL_UART_MspInit(UART_HandleTypeDef* uartHandle)
     HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
   /* USER CODE BEGIN USART2_MspInit 1 */
+    /* USART2 DMA Init */
+    /* USART2_TX Init */
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    hdma_usart2_tx.Instance = DMA1_Stream6;
+    hdma_usart2_tx.Init.Channel = DMA_CHANNEL_4;
+    hdma_usart2_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_usart2_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_usart2_tx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_usart2_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_usart2_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_usart2_tx.Init.Mode = DMA_NORMAL;
+    hdma_usart2_tx.Init.Priority = DMA_PRIORITY_LOW;
+    hdma_usart2_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_usart2_tx) != HAL_OK)
+    {
+      Error_Handler();
+    }
+
+    __HAL_LINKDMA(uartHandle,hdmatx,hdma_usart2_tx);
+
+    /* USART2_RX Init */
+    hdma_usart2_rx.Instance = DMA1_Stream5;
+    hdma_usart2_rx.Init.Channel = DMA_CHANNEL_4;
+    hdma_usart2_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_usart2_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_usart2_rx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_usart2_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_usart2_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_usart2_rx.Init.Mode = DMA_CIRCULAR;
+    hdma_usart2_rx.Init.Priority = DMA_PRIORITY_LOW;
+    hdma_usart2_rx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_usart2_rx) != HAL_OK)
+    {
+      Error_Handler();
+    }
+
+    __HAL_LINKDMA(uartHandle,hdmarx,hdma_usart2_rx);
 
+    // ⭐ 로그는 제어보다 급하지 않음: TIM(0), I2C(3)보다 낮게
+    HAL_NVIC_SetPriority(DMA1_Stream6_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Stream6_IRQn);
+    HAL_NVIC_SetPriority(DMA1_Stream5_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Stream5_IRQn);
+    HAL_NVIC_SetPriority(USART2_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(USART2_IRQn);
   /* USER CODE END USART2_MspInit 1 */
   }
 }
@@ -104,11 +167,224 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* uartHandle)
     HAL_GPIO_DeInit(GPIOA, USART_TX_Pin|USART_RX_Pin);
 
   /* USER CODE BEGIN USART2_MspDeInit 1 */
-
+    HAL_DMA_DeInit(uartHandle->hdmatx);
+    HAL_DMA_DeInit(uartHandle->hdmarx);
+    HAL_NVIC_DisableIRQ(DMA1_Stream6_IRQn);
+    HAL_NVIC_DisableIRQ(DMA1_Stream5_IRQn);
+    HAL_NVIC_DisableIRQ(USART2_IRQn);
   /* USER CODE END USART2_MspDeInit 1 */
   }
 }
 
 /* USER CODE BEGIN 1 */
+static inline uint16_t UART_TxDepth(void)
+{
+  return (uint16_t)(uart_tx_head - uart_tx_tail);
+}
+
+// 대기 중인 연속 구간을 DMA로 시작 (메인 루프와 완료 ISR 양쪽에서 호출)
+static void UART_TxKick(void)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  uint16_t depth = UART_TxDepth();
+  if (uart_tx_inflight == 0 && depth > 0)
+  {
+    uint16_t pos = uart_tx_tail & (UART_TX_RING_SIZE - 1);
+    uint16_t len = UART_TX_RING_SIZE - pos; // 버퍼 끝에서 잘림
+    if (len > depth)
+    {
+      len = depth;
+    }
+
+    uart_tx_inflight = len;
+    if (HAL_UART_Transmit_DMA(&huart2, &uart_tx_ring[pos], len) != HAL_OK)
+    {
+      // 아직 바쁘면 다음 Write/완료에서 재시도
+      uart_tx_inflight = 0;
+    }
+  }
+
+  __set_PRIMASK(primask);
+}
+
+// 링에 복사 후 즉시 반환 (DMA가 백그라운드로 전송). 들어간 바이트 수 반환
+uint16_t UART_TxWrite(const uint8_t *data, uint16_t len)
+{
+  uint16_t free = UART_TX_RING_SIZE - UART_TxDepth();
+
+#if UART_TX_FULL_POLICY == UART_TX_POLICY_BLOCK
+  // ISR 안이거나 인터럽트가 막혀 있으면 DMA 완료가 올 수 없으므로 대기 금지
+  if (free < len && len <= UART_TX_RING_SIZE && __get_IPSR() == 0 &&
+      __get_PRIMASK() == 0)
+  {
+    uart_tx_stats.blocked++;
+    UART_TxKick();
+    while ((free = UART_TX_RING_SIZE - UART_TxDepth()) < len)
+    {
+    }
+  }
+#endif
+
+  uint16_t n = (len > free) ? free : len;
+  uint16_t head = uart_tx_head;
+  for (uint16_t i = 0; i < n; i++)
+  {
+    uart_tx_ring[(uint16_t)(head + i) & (UART_TX_RING_SIZE - 1)] = data[i];
+  }
+  uart_tx_head = head + n; // 데이터 기록 후 head 공개
+
+  uart_tx_stats.written += n;
+  uart_tx_stats.dropped += len - n;
+  uint16_t depth = UART_TxDepth();
+  if (depth > uart_tx_stats.high_water)
+  {
+    uart_tx_stats.high_water = depth;
+  }
+
+  UART_TxKick();
+  return n;
+}
+
+// printf 텍스트용. 음소거 중이면 버림 (Modbus RTU 프레임 사이에 끼면 안 됨)
+uint16_t UART_TxWriteText(const uint8_t *data, uint16_t len)
+{
+  if (uart_text_mute)
+  {
+    return 0;
+  }
+  return UART_TxWrite(data, len);
+}
+
+void UART_SetTextMute(uint8_t mute)
+{
+  uart_text_mute = mute;
+}
+
+void UART_GetTxStats(UART_TxStats_t *stats)
+{
+  *stats = uart_tx_stats;
+  stats->depth = UART_TxDepth();
+}
+
+// 한 구간 전송 완료 → tail 전진 후 다음 구간 연쇄 시작
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+  if (huart->Instance != USART2)
+  {
+    return;
+  }
+  uart_tx_tail += uart_tx_inflight;
+  uart_tx_inflight = 0;
+  UART_TxKick();
+}
+
+// ========== 수신 ==========
+// 원형 DMA + idle 라인 감지 시작. 밀린 데이터는 버리고 새 바퀴부터
+void UART_RxStart(void)
+{
+  // DMA는 버퍼 처음부터 다시 쓰므로 head를 다음 바퀴 경계로 맞춤
+  uint32_t head = (uart_rx_head + UART_RX_DMA_SIZE - 1) &
+                  ~(uint32_t)(UART_RX_DMA_SIZE - 1);
+  uart_rx_head = head;
+  uart_rx_tail = head;
+  uart_rx_last_pos = 0;
+
+  // HT 이벤트도 켜둠: 반 바퀴마다 head가 움직여야 한 바퀴 밀림을 감지
+  if (HAL_UARTEx_ReceiveToIdle_DMA(&huart2, uart_rx_dma, UART_RX_DMA_SIZE) !=
+      HAL_OK)
+  {
+    uart_rx_stats.errors++;
+  }
+}
+
+// 메인 루프에서 호출. 대기 없이 가진 만큼만 복사하고 바이트 수 반환
+uint16_t UART_RxRead(uint8_t *buf, uint16_t max)
+{
+  uint32_t head = uart_rx_head;
+  uint32_t avail = head - uart_rx_tail;
+
+  if (avail > UART_RX_DMA_SIZE)
+  {
+    // 한 바퀴 이상 늦음: 덮어쓴 데이터라 통째로 버림
+    uart_rx_stats.overflows++;
+    uart_rx_tail = head;
+    return 0;
+  }
+
+  uint16_t n = (avail > max) ? max : (uint16_t)avail;
+  for (uint16_t i = 0; i < n; i++)
+  {
+    buf[i] = uart_rx_dma[(uart_rx_tail + i) & (UART_RX_DMA_SIZE - 1)];
+  }
+  uart_rx_tail += n;
+  return n;
+}
+
+// 현재 DMA 쓰기 위치 (0 ~ UART_RX_DMA_SIZE-1). 프레임 간격 타이머용
+uint16_t UART_RxDmaPos(void)
+{
+  return (uint16_t)(UART_RX_DMA_SIZE - __HAL_DMA_GET_COUNTER(&hdma_usart2_rx)) &
+         (UART_RX_DMA_SIZE - 1);
+}
+
+void UART_GetRxStats(UART_RxStats_t *stats)
+{
+  *stats = uart_rx_stats;
+}
+
+// idle / 반 바퀴 / 한 바퀴 이벤트. Size = 현재 DMA 쓰기 위치
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+  if (huart->Instance != USART2)
+  {
+    return;
+  }
+  uint16_t delta = (uint16_t)(Size - uart_rx_last_pos);
+  uart_rx_last_pos = (Size >= UART_RX_DMA_SIZE) ? 0 : Size;
+  uart_rx_head += delta;
+  uart_rx_stats.received += delta;
+}
+
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+  if (huart->Instance != USART2)
+  {
+    return;
+  }
+  if (huart->RxState == HAL_UART_STATE_READY)
+  {
+    // 오버런/프레이밍 오류 등으로 HAL이 수신을 멈춤 → 다시 시작
+    uart_rx_stats.errors++;
+    UART_RxStart();
+  }
+  if ((huart->ErrorCode & HAL_UART_ERROR_DMA) && uart_tx_inflight &&
+      huart->gState == HAL_UART_STATE_READY)
+  {
+    // 송신 DMA 중단: 나가던 구간은 버리고 다음 구간부터 재시작
+    uart_tx_stats.errors++;
+    uart_tx_stats.dropped += uart_tx_inflight;
+    uart_tx_tail += uart_tx_inflight;
+    uart_tx_inflight = 0;
+    UART_TxKick();
+  }
+}
+
+// ⭐ stm32f4xx_it.c 대신 여기서 처리
+void DMA1_Stream6_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_usart2_tx);
+}
+
+void DMA1_Stream5_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_usart2_rx);
+}
+
+void USART2_IRQHandler(void)
+{
+  HAL_UART_IRQHandler(&huart2);
+}
 
 /* USER CODE END 1 */
@@ -0,0 +1,5 @@
+#ifndef DMA_H_SIM_
+#define DMA_H_SIM_
+#include "main.h"
+void MX_DMA_Init(void);
+#endif
@@ -0,0 +1,6 @@
+#ifndef RTC_H_SIM_
+#define RTC_H_SIM_
+#include "main.h"
+extern RTC_HandleTypeDef hrtc;
+void MX_RTC_Init(void);
+#endif
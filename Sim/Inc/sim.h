@@ -0,0 +1,128 @@
+#ifndef SIM_H_
+#define SIM_H_
+
+#include "stm32f4xx_hal.h"
+#include <stdint.h>
+
+// ========== 호스트 시뮬레이터 ==========
+// 펌웨어(App + Core)를 그대로 링크하고 HAL 만 가상으로 바꿈
+// - 시간은 가상: __WFI / HAL_Delay 에서 다음 1ms 경계로 → 실제보다 훨씬 빠름
+// - 1ms 마다: 틱 훅 → SysTick / DWT → TIM2 CH1 / TIM3 → ADC DMA → UART / I2C
+//   완료 → 보드 (DHT11 캡처, CCR 트레이스)
+// - DWT->CYCCNT 도 가상 시간 기준 (Prof_Now, PROF_DWT)
+// - 코드 실행 비용은 모델 (sim_cost.c): PROF 구간 / ISR 마다 정한 사이클만큼
+//   가상 시간을 진행 (sim_prof.h) → 태스크가 ms 경계를 넘고 지터가 생김
+
+#define SIM_CORE_CLOCK_HZ 84000000u // HSI 16MHz / 16 * 336 / 4
+#define SIM_ADC_FRAME_US 94u        // 4채널 1프레임 (adc.h 주석)
+#define SIM_UART_BYTES_PER_S 11520u // 115200 8N1
+#define SIM_I2C_BYTES_PER_S 11111u  // 100kHz, 바이트당 9비트
+#define SIM_COST_ISR_CYCLES 400u    // DMA / I2C 완료 ISR 하나 (HAL 콜백 포함)
+
+typedef void (*Sim_TickHook_t)(uint32_t now_ms);
+typedef void (*Sim_EndHook_t)(void);
+
+// 매 1ms 인터럽트 전에 호출 (스크립트 입력)
+void Sim_SetTickHook(Sim_TickHook_t fn);
+
+// end_ms 가 되면 end 훅 호출 후 exit(Sim_ExitCode())
+void Sim_SetEnd(uint32_t end_ms, Sim_EndHook_t fn);
+void Sim_SetExitCode(int code);
+
+uint32_t Sim_NowMs(void);
+
+// 1 이면 DWT->CYCCNT = 호스트 실제 시간을 코어 클럭 사이클로 환산 (Prof 구간을
+// 호스트에서 재는 단위 벤치용). 0 = 가상 시간 (기본)
+void Sim_DwtHostClock(uint8_t on);
+
+// 코드 실행 비용: 가상 시간을 cycles 만큼 진행 (ms 경계를 넘으면 틱/ISR 실행)
+void Sim_Charge(uint32_t cycles);
+
+// ADC 채널 값 (0~4095), 다음 DMA 반 버퍼부터 반영
+void Sim_SetAdc(uint8_t ch, uint16_t value);
+
+// UART 로 나간 바이트를 stdout 으로 (기본 꺼짐)
+void Sim_SetUartEcho(uint8_t on);
+
+// UART 로 나간 바이트를 함수로도 넘김 (pty 등, DMA 완료 시점). NULL 이면 끔
+typedef void (*Sim_UartSink_t)(const uint8_t *data, uint16_t len);
+void Sim_SetUartSink(Sim_UartSink_t fn);
+
+// UART 수신: 115200bps 속도로 DMA 버퍼에 흘려넣음 (idle/반/한 바퀴 이벤트)
+void Sim_UartInject(const uint8_t *data, uint16_t len);
+
+// UART 로 나간 최근 출력 (expect uart 용). Sim_UartTxMark 이후만
+const char *Sim_UartTxText(void);
+void Sim_UartTxMark(uint32_t consumed);
+
+// ========== LCD (PCF8574 + HD44780 디코더, sim_lcd.c) ==========
+#define SIM_LCD_ROWS 2
+#define SIM_LCD_COLS 16
+
+void Sim_LcdReset(void);
+void Sim_LcdFeed(const uint8_t *data, uint16_t len); // I2C 완료 시 HAL 이 호출
+const char *Sim_LcdLine(uint8_t row);                // 16칸 + NUL
+uint32_t Sim_LcdWrites(void);
+uint32_t Sim_LcdBytes(void); // I2C 로 받은 누적 바이트
+// 지난 호출 이후 받은 바이트를 out 에 (최대 cap) 복사하고 비움 → 받은 수
+uint16_t Sim_LcdTrace(uint8_t *out, uint16_t cap);
+
+// ========== 보드 (키패드, 핀, DHT11, 트레이스, sim_board.c) ==========
+// 키패드 4x4: 눌린 키의 행이 LOW 로 스캔될 때 열 핀이 LOW
+void Sim_KeySet(char key, uint8_t down);
+
+// 입력 핀 (조이스틱 버튼 PB0 등). port: 'A'~'C', 'H'
+void Sim_SetPin(char port, uint8_t pin, uint8_t level);
+
+// DHT11 응답 (present=0 이면 무응답 → 펌웨어 타임아웃 경로)
+void Sim_SetDht(uint8_t present, uint8_t temp_c, uint8_t hum_pct);
+
+// 출력 핀 / TIM3 CCR 변화를 CSV 로 (t_ms,signal,value). NULL 이면 끔
+void Sim_TraceOpen(const char *path);
+uint32_t Sim_GateMoves(void); // TIM3 CCR1/CCR2 가 바뀐 횟수
+
+// ========== 로그 플래시 (섹터 6/7, sim_flash.c) ==========
+// path 파일에 두 섹터를 저장 (없으면 0xFF 로 만듦). NULL 이면 RAM 만
+// 같은 파일로 다시 열기 = 전원 재투입 (전원 차단 주입도 해제)
+int Sim_FlashOpen(const char *path);
+
+// 지금부터 nth 번째 program 호출에서 keep_words 워드만 쓰고 전원 차단
+// (그 뒤 program / erase 는 모두 실패)
+void Sim_FlashTear(uint32_t nth_program, uint32_t keep_words);
+uint8_t Sim_FlashPoweredOff(void);
+
+typedef struct {
+  uint32_t reads;
+  uint32_t read_bytes;
+  uint32_t programs;
+  uint32_t program_words;
+  uint32_t erases;
+} Sim_FlashStats_t;
+
+void Sim_FlashGetStats(Sim_FlashStats_t *out);
+void Sim_FlashResetStats(void);
+
+// ========== 스크립트 (sim_script.c) ==========
+// 명령: level <pct> [ramp_ms] | adc <ch> <raw> | key <chars> |
+//       joy up|down|left|right | click | pin <port><n> <0|1> | uart <text> |
+//       mb <hex bytes> | dht <temp> <hum> | dht off | print lcd | end |
+//       expect lcd <row> <text> | expect gate <1|2> open|closed|<deg> |
+//       expect uart <text> | expect mb <hex bytes>
+// mb: Modbus RTU 프레임 (CRC 는 뒤에 자동으로 붙임)
+int Sim_ScriptLoad(const char *path);
+int Sim_ScriptExec(const char *text); // 지금 바로 한 줄
+void Sim_ScriptTick(uint32_t now_ms);
+uint32_t Sim_ScriptEnd(void); // 'end' 시각, 없으면 0
+uint32_t Sim_ScriptFailures(void);
+uint32_t Sim_ScriptExpects(void);
+
+// sim_hal.c → sim_board.c
+void Sim_BoardGpioChanged(GPIO_TypeDef *port, uint32_t old_odr,
+                          uint32_t new_odr);
+void Sim_BoardDhtArm(TIM_HandleTypeDef *h); // NULL = 캡처 중지
+void Sim_BoardTick(uint32_t now_ms);
+
+// 펌웨어 진입점 (main.c 를 -Dmain=fw_main 으로 빌드)
+int fw_main(void);
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef SIM_PRINTF_H_
+#define SIM_PRINTF_H_
+
+// 펌웨어 소스에만 -include 로 붙임
+// 호스트 printf 는 stdout 으로 바로 가므로, 타깃처럼 __io_putchar → UART 링을
+// 거치게 돌려놓음 (TX 링 넘침/음소거/Modbus 전환까지 그대로 재현)
+#include <stdio.h>
+
+int sim_printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+#define printf sim_printf
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef SIM_PROF_H_
+#define SIM_PROF_H_
+
+// 펌웨어 소스에만 -include 로 붙임 (sim_printf.h 와 같은 방식)
+// 호스트에서는 코드가 시간을 쓰지 않아 지터가 늘 0 으로 나오므로,
+// PROF_STOP 마다 구간별로 정해 둔 실행 비용을 가상 시간에 더함 (sim_cost.c)
+#include "prof.h"
+
+#if PROF_ENABLE
+void Sim_ProfCharge(uint8_t zone);
+
+#undef PROF_STOP
+#define PROF_STOP(v, zone)                                                     \
+  (Sim_ProfCharge(zone), Prof_Record((zone), Prof_Now() - (v)))
+#endif
+
+#endif
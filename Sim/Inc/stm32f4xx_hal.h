@@ -0,0 +1,314 @@
+#ifndef STM32F4XX_HAL_H_SIM_
+#define STM32F4XX_HAL_H_SIM_
+
+// ========== 호스트 시뮬레이터용 HAL 선언 ==========
+// 펌웨어가 실제로 쓰는 타입/매크로/함수만. 구현은 Sim/Src/sim_hal.c
+// 레지스터는 전역 구조체 (GPIOA_s, TIM3_s ...) → 테스트가 직접 들여다봄
+#include <stdint.h>
+#include <stddef.h>
+typedef enum { HAL_OK=0, HAL_ERROR, HAL_BUSY, HAL_TIMEOUT } HAL_StatusTypeDef;
+typedef enum { RESET=0, SET=1 } FlagStatus;
+typedef enum { DISABLE=0, ENABLE=1 } FunctionalState;
+typedef enum { GPIO_PIN_RESET=0, GPIO_PIN_SET } GPIO_PinState;
+typedef struct { volatile uint32_t MODER, IDR, ODR; } GPIO_TypeDef;
+extern GPIO_TypeDef GPIOA_s, GPIOB_s, GPIOC_s, GPIOH_s;
+#define GPIOA (&GPIOA_s)
+#define GPIOB (&GPIOB_s)
+#define GPIOC (&GPIOC_s)
+#define GPIOH (&GPIOH_s)
+typedef struct { uint32_t Pin, Mode, Pull, Speed, Alternate; } GPIO_InitTypeDef;
+#define GPIO_PIN_0 0x0001
+#define GPIO_PIN_1 0x0002
+#define GPIO_PIN_2 0x0004
+#define GPIO_PIN_3 0x0008
+#define GPIO_PIN_4 0x0010
+#define GPIO_PIN_5 0x0020
+#define GPIO_PIN_6 0x0040
+#define GPIO_PIN_7 0x0080
+#define GPIO_PIN_8 0x0100
+#define GPIO_PIN_9 0x0200
+#define GPIO_PIN_10 0x0400
+#define GPIO_PIN_11 0x0800
+#define GPIO_PIN_12 0x1000
+#define GPIO_PIN_13 0x2000
+#define GPIO_PIN_14 0x4000
+#define GPIO_PIN_15 0x8000
+#define GPIO_MODE_INPUT 0
+#define GPIO_MODE_OUTPUT_PP 1
+#define GPIO_MODE_OUTPUT_OD 0x11
+#define GPIO_MODE_AF_PP 2
+#define GPIO_MODE_AF_OD 0x12
+#define GPIO_MODE_ANALOG 3
+#define GPIO_NOPULL 0
+#define GPIO_PULLUP 1
+#define GPIO_PULLDOWN 2
+#define GPIO_SPEED_FREQ_LOW 0
+#define GPIO_SPEED_FREQ_VERY_HIGH 3
+#define GPIO_AF2_TIM3 2
+#define GPIO_AF4_I2C1 4
+#define GPIO_AF7_USART2 7
+void HAL_GPIO_Init(GPIO_TypeDef *, GPIO_InitTypeDef *);
+void HAL_GPIO_DeInit(GPIO_TypeDef *, uint32_t);
+void HAL_GPIO_WritePin(GPIO_TypeDef *, uint16_t, GPIO_PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *, uint16_t);
+void HAL_GPIO_TogglePin(GPIO_TypeDef *, uint16_t);
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t);
+HAL_StatusTypeDef HAL_Init(void);
+#define __HAL_RCC_GPIOA_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_GPIOC_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_GPIOH_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_DMA1_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_DMA2_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_TIM2_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_TIM3_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_TIM2_CLK_DISABLE() do{}while(0)
+#define __HAL_RCC_TIM3_CLK_DISABLE() do{}while(0)
+#define __HAL_RCC_I2C1_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_I2C1_CLK_DISABLE() do{}while(0)
+#define __HAL_RCC_USART2_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_USART2_CLK_DISABLE() do{}while(0)
+#define __HAL_RCC_ADC1_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_DMA1_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_DMA2_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_ADC1_CLK_DISABLE() do{}while(0)
+/* NVIC */
+typedef enum { TIM2_IRQn=28, TIM3_IRQn=29, I2C1_EV_IRQn=31, I2C1_ER_IRQn=32, USART2_IRQn=38,
+  DMA1_Stream5_IRQn=16, DMA1_Stream6_IRQn=17, DMA2_Stream0_IRQn=56 } IRQn_Type;
+void HAL_NVIC_SetPriority(IRQn_Type, uint32_t, uint32_t);
+void HAL_NVIC_EnableIRQ(IRQn_Type);
+void HAL_NVIC_DisableIRQ(IRQn_Type);
+uint32_t __get_PRIMASK(void);
+uint32_t __get_IPSR(void);
+void __set_PRIMASK(uint32_t);
+void __disable_irq(void);
+void __enable_irq(void);
+void __WFI(void);
+void __DSB(void);
+void __DMB(void);
+void __NOP(void);
+/* DMA */
+typedef struct { uint32_t Channel, Direction, PeriphInc, MemInc, PeriphDataAlignment, MemDataAlignment, Mode, Priority, FIFOMode; } DMA_InitTypeDef;
+typedef struct { volatile uint32_t CR, NDTR; } DMA_Stream_TypeDef;
+typedef struct __DMA_HandleTypeDef { DMA_Stream_TypeDef *Instance; DMA_InitTypeDef Init; void *Parent; } DMA_HandleTypeDef;
+extern DMA_Stream_TypeDef DMA2_Stream0_s, DMA1_Stream5_s, DMA1_Stream6_s;
+#define DMA2_Stream0 (&DMA2_Stream0_s)
+#define DMA1_Stream5 (&DMA1_Stream5_s)
+#define DMA1_Stream6 (&DMA1_Stream6_s)
+#define DMA_CHANNEL_0 0
+#define DMA_CHANNEL_4 4
+#define DMA_PERIPH_TO_MEMORY 0
+#define DMA_MEMORY_TO_PERIPH 1
+#define DMA_PINC_DISABLE 0
+#define DMA_MINC_ENABLE 1
+#define DMA_PDATAALIGN_BYTE 0
+#define DMA_MDATAALIGN_BYTE 0
+#define DMA_PDATAALIGN_HALFWORD 1
+#define DMA_MDATAALIGN_HALFWORD 1
+#define DMA_NORMAL 0
+#define DMA_CIRCULAR 1
+#define DMA_PRIORITY_LOW 0
+#define DMA_PRIORITY_MEDIUM 1
+#define DMA_FIFOMODE_DISABLE 0
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *);
+HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef *);
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *);
+#define __HAL_DMA_GET_COUNTER(h) ((h)->Instance->NDTR)
+#define __HAL_DMA_DISABLE_IT(h, it) do{(void)(h);}while(0)
+#define DMA_IT_HT 0
+#define __HAL_LINKDMA(h, f, d) do{ (h)->f = &(d); (d).Parent = (h);}while(0)
+/* I2C */
+typedef struct { uint32_t ClockSpeed, DutyCycle, OwnAddress1, AddressingMode, DualAddressMode, OwnAddress2, GeneralCallMode, NoStretchMode; } I2C_InitTypeDef;
+typedef struct { uint32_t dummy; } I2C_TypeDef;
+extern I2C_TypeDef I2C1_s;
+#define I2C1 (&I2C1_s)
+typedef struct __I2C_HandleTypeDef { I2C_TypeDef *Instance; I2C_InitTypeDef Init; uint32_t ErrorCode; } I2C_HandleTypeDef;
+#define I2C_DUTYCYCLE_2 0
+#define I2C_ADDRESSINGMODE_7BIT 0
+#define I2C_DUALADDRESS_DISABLE 0
+#define I2C_GENERALCALL_DISABLE 0
+#define I2C_NOSTRETCH_DISABLE 0
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *, uint16_t, uint8_t *, uint16_t, uint32_t);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *, uint16_t, uint8_t *, uint16_t);
+void HAL_I2C_EV_IRQHandler(I2C_HandleTypeDef *);
+void HAL_I2C_ER_IRQHandler(I2C_HandleTypeDef *);
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *);
+/* TIM */
+typedef struct { uint32_t Prescaler, CounterMode, Period, ClockDivision, AutoReloadPreload, RepetitionCounter; } TIM_Base_InitTypeDef;
+typedef struct { volatile uint32_t CNT, ARR, CCR1, CCR2, CCR3, CCR4, DIER, SR, CCER; } TIM_TypeDef;
+extern TIM_TypeDef TIM2_s, TIM3_s;
+#define TIM2 (&TIM2_s)
+#define TIM3 (&TIM3_s)
+typedef enum { HAL_TIM_ACTIVE_CHANNEL_1=1, HAL_TIM_ACTIVE_CHANNEL_2=2, HAL_TIM_ACTIVE_CHANNEL_3=4, HAL_TIM_ACTIVE_CHANNEL_4=8, HAL_TIM_ACTIVE_CHANNEL_CLEARED=0 } HAL_TIM_ActiveChannel;
+typedef struct { TIM_TypeDef *Instance; TIM_Base_InitTypeDef Init; HAL_TIM_ActiveChannel Channel; } TIM_HandleTypeDef;
+typedef struct { uint32_t ClockSource; } TIM_ClockConfigTypeDef;
+typedef struct { uint32_t MasterOutputTrigger, MasterSlaveMode; } TIM_MasterConfigTypeDef;
+typedef struct { uint32_t OCMode, Pulse, OCPolarity, OCFastMode; } TIM_OC_InitTypeDef;
+typedef struct { uint32_t ICPolarity, ICSelection, ICPrescaler, ICFilter; } TIM_IC_InitTypeDef;
+#define TIM_CHANNEL_1 0x0
+#define TIM_CHANNEL_2 0x4
+#define TIM_CHANNEL_3 0x8
+#define TIM_CHANNEL_4 0xC
+#define TIM_COUNTERMODE_UP 0
+#define TIM_CLOCKDIVISION_DIV1 0
+#define TIM_AUTORELOAD_PRELOAD_DISABLE 0
+#define TIM_AUTORELOAD_PRELOAD_ENABLE 1
+#define TIM_CLOCKSOURCE_INTERNAL 0
+#define TIM_TRGO_RESET 0
+#define TIM_MASTERSLAVEMODE_DISABLE 0
+#define TIM_OCMODE_PWM1 0x60
+#define TIM_OCMODE_TIMING 0
+#define TIM_OCPOLARITY_HIGH 0
+#define TIM_OCFAST_DISABLE 0
+#define TIM_ICPOLARITY_FALLING 2
+#define TIM_ICSELECTION_DIRECTTI 1
+#define TIM_ICPSC_DIV1 0
+#define TIM_IT_CC1 2
+#define TIM_IT_CC2 4
+#define TIM_IT_CC4 16
+#define TIM_IT_UPDATE 1
+#define TIM_FLAG_CC4 16
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *);
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *);
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef *, TIM_ClockConfigTypeDef *);
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *, TIM_MasterConfigTypeDef *);
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *);
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *, TIM_OC_InitTypeDef *, uint32_t);
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *, uint32_t);
+HAL_StatusTypeDef HAL_TIM_OC_ConfigChannel(TIM_HandleTypeDef *, TIM_OC_InitTypeDef *, uint32_t);
+HAL_StatusTypeDef HAL_TIM_OC_Start_IT(TIM_HandleTypeDef *, uint32_t);
+HAL_StatusTypeDef HAL_TIM_IC_ConfigChannel(TIM_HandleTypeDef *, TIM_IC_InitTypeDef *, uint32_t);
+HAL_StatusTypeDef HAL_TIM_IC_Start_IT(TIM_HandleTypeDef *, uint32_t);
+HAL_StatusTypeDef HAL_TIM_IC_Stop_IT(TIM_HandleTypeDef *, uint32_t);
+void HAL_TIM_IRQHandler(TIM_HandleTypeDef *);
+void HAL_TIM_MspPostInit(TIM_HandleTypeDef *);
+#define __HAL_TIM_SET_COMPARE(h, ch, v) (*(&(h)->Instance->CCR1 + ((ch) >> 2)) = (v))
+#define __HAL_TIM_GET_COMPARE(h, ch) (*(&(h)->Instance->CCR1 + ((ch) >> 2)))
+#define __HAL_TIM_SET_COUNTER(h, v) ((h)->Instance->CNT = (v))
+#define __HAL_TIM_GET_COUNTER(h) ((h)->Instance->CNT)
+#define __HAL_TIM_ENABLE_IT(h, it) ((h)->Instance->DIER |= (it))
+#define __HAL_TIM_DISABLE_IT(h, it) ((h)->Instance->DIER &= ~(it))
+#define __HAL_TIM_CLEAR_FLAG(h, f) ((h)->Instance->SR &= ~(f))
+#define HAL_TIM_ReadCapturedValue(h, ch) __HAL_TIM_GET_COMPARE(h, ch)
+/* ADC */
+typedef struct { uint32_t ClockPrescaler, Resolution, ScanConvMode, ContinuousConvMode, DiscontinuousConvMode, ExternalTrigConvEdge, ExternalTrigConv, DataAlign, NbrOfConversion, DMAContinuousRequests, EOCSelection; } ADC_InitTypeDef;
+typedef struct { uint32_t dummy; } ADC_TypeDef;
+extern ADC_TypeDef ADC1_s;
+#define ADC1 (&ADC1_s)
+typedef struct { ADC_TypeDef *Instance; ADC_InitTypeDef Init; DMA_HandleTypeDef *DMA_Handle; } ADC_HandleTypeDef;
+typedef struct { uint32_t Channel, Rank, SamplingTime; } ADC_ChannelConfTypeDef;
+#define ADC_CLOCK_SYNC_PCLK_DIV4 0
+#define ADC_RESOLUTION_12B 0
+#define ADC_EXTERNALTRIGCONVEDGE_NONE 0
+#define ADC_SOFTWARE_START 0
+#define ADC_DATAALIGN_RIGHT 0
+#define ADC_EOC_SEQ_CONV 0
+#define ADC_CHANNEL_0 0
+#define ADC_CHANNEL_1 1
+#define ADC_CHANNEL_4 4
+#define ADC_CHANNEL_TEMPSENSOR 16
+#define ADC_SAMPLETIME_480CYCLES 7
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *);
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *, ADC_ChannelConfTypeDef *);
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *, uint32_t *, uint32_t);
+/* UART */
+typedef struct { uint32_t BaudRate, WordLength, StopBits, Parity, Mode, HwFlowCtl, OverSampling; } UART_InitTypeDef;
+typedef struct { uint32_t dummy; } USART_TypeDef;
+extern USART_TypeDef USART2_s;
+#define USART2 (&USART2_s)
+typedef struct __UART_HandleTypeDef { USART_TypeDef *Instance; UART_InitTypeDef Init; DMA_HandleTypeDef *hdmatx, *hdmarx; uint32_t ErrorCode; volatile uint32_t gState, RxState; } UART_HandleTypeDef;
+#define HAL_UART_STATE_READY 0x20U
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *, uint16_t);
+#define UART_WORDLENGTH_8B 0
+#define UART_STOPBITS_1 0
+#define UART_PARITY_NONE 0
+#define UART_MODE_TX_RX 0
+#define UART_HWCONTROL_NONE 0
+#define UART_OVERSAMPLING_16 0
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *, uint8_t *, uint16_t, uint32_t);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *, uint8_t *, uint16_t);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *, uint8_t *, uint16_t);
+void HAL_UART_IRQHandler(UART_HandleTypeDef *);
+#define HAL_UART_ERROR_NONE 0x0U
+#define HAL_UART_ERROR_PE 0x1U
+#define HAL_UART_ERROR_NE 0x2U
+#define HAL_UART_ERROR_FE 0x4U
+#define HAL_UART_ERROR_ORE 0x8U
+#define HAL_UART_ERROR_DMA 0x10U
+#define DMA_PRIORITY_HIGH 2
+/* RTC */
+typedef struct { uint8_t Hours, Minutes, Seconds; } RTC_TimeTypeDef;
+typedef struct { uint8_t WeekDay, Month, Date, Year; } RTC_DateTypeDef;
+typedef struct { uint32_t dummy; } RTC_HandleTypeDef;
+#define RTC_FORMAT_BIN 0
+HAL_StatusTypeDef HAL_RTC_SetTime(RTC_HandleTypeDef *, RTC_TimeTypeDef *, uint32_t);
+HAL_StatusTypeDef HAL_RTC_SetDate(RTC_HandleTypeDef *, RTC_DateTypeDef *, uint32_t);
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *, RTC_TimeTypeDef *, uint32_t);
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *, RTC_DateTypeDef *, uint32_t);
+#define RTC_BKP_DR0 0u
+#define RTC_BKP_DR1 1u
+uint32_t HAL_RTCEx_BKUPRead(RTC_HandleTypeDef *, uint32_t);
+void HAL_RTCEx_BKUPWrite(RTC_HandleTypeDef *, uint32_t, uint32_t);
+/* RCC / PWR */
+typedef struct { uint32_t OscillatorType, HSIState, HSICalibrationValue, LSIState; struct { uint32_t PLLState, PLLSource, PLLM, PLLN, PLLP, PLLQ; } PLL; } RCC_OscInitTypeDef;
+typedef struct { uint32_t ClockType, SYSCLKSource, AHBCLKDivider, APB1CLKDivider, APB2CLKDivider; } RCC_ClkInitTypeDef;
+#define RCC_OSCILLATORTYPE_HSI 1
+#define RCC_OSCILLATORTYPE_LSI 2
+#define RCC_HSI_ON 1
+#define RCC_HSICALIBRATION_DEFAULT 16
+#define RCC_LSI_ON 1
+#define RCC_PLL_ON 1
+#define RCC_PLLSOURCE_HSI 0
+#define RCC_PLLP_DIV4 4
+#define RCC_CLOCKTYPE_HCLK 1
+#define RCC_CLOCKTYPE_SYSCLK 2
+#define RCC_CLOCKTYPE_PCLK1 4
+#define RCC_CLOCKTYPE_PCLK2 8
+#define RCC_SYSCLKSOURCE_PLLCLK 2
+#define RCC_SYSCLK_DIV1 0
+#define RCC_HCLK_DIV1 0
+#define RCC_HCLK_DIV2 1
+#define FLASH_LATENCY_2 2
+#define PWR_REGULATOR_VOLTAGE_SCALE1 1
+#define __HAL_RCC_PWR_CLK_ENABLE() do{}while(0)
+#define __HAL_PWR_VOLTAGESCALING_CONFIG(x) do{}while(0)
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *);
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *, uint32_t);
+uint32_t HAL_RCC_GetHCLKFreq(void);
+/* FLASH */
+typedef struct { uint32_t TypeErase, Banks, Sector, NbSectors, VoltageRange; } FLASH_EraseInitTypeDef;
+#define FLASH_TYPEERASE_SECTORS 0
+#define FLASH_VOLTAGE_RANGE_3 2
+#define FLASH_TYPEPROGRAM_WORD 2
+#define FLASH_SECTOR_6 6
+#define FLASH_SECTOR_7 7
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t, uint32_t, uint64_t);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *, uint32_t *);
+/* Core debug / DWT */
+typedef struct { volatile uint32_t CTRL, CYCCNT; } DWT_Type;
+typedef struct { volatile uint32_t DEMCR; } CoreDebug_Type;
+extern DWT_Type DWT_s; extern CoreDebug_Type CoreDebug_s;
+DWT_Type *Sim_Dwt(void); /* 호스트 시계 모드면 읽을 때 CYCCNT 갱신 */
+#define DWT (Sim_Dwt())
+#define CoreDebug (&CoreDebug_s)
+#define CoreDebug_DEMCR_TRCENA_Msk (1u<<24)
+#define DWT_CTRL_CYCCNTENA_Msk 1u
+extern uint32_t SystemCoreClock;
+/* 콜백 / MSP (펌웨어 Core/App 쪽에서 정의) */
+void HAL_ADC_MspInit(ADC_HandleTypeDef *);
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *);
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *);
+void HAL_I2C_MspInit(I2C_HandleTypeDef *);
+void HAL_TIM_Base_MspInit(TIM_HandleTypeDef *);
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *);
+void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *);
+void HAL_UART_MspInit(UART_HandleTypeDef *);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *);
+#endif
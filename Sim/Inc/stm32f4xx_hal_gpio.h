@@ -0,0 +1,4 @@
+#ifndef STM32F4XX_HAL_GPIO_H_SIM_
+#define STM32F4XX_HAL_GPIO_H_SIM_
+#include "stm32f4xx_hal.h"
+#endif
@@ -0,0 +1,189 @@
+#include "sim.h"
+#include "main.h"
+#include <stdio.h>
+
+// ========== 키패드 4x4 (keypad.c 의 배선 표를 그대로 사용) ==========
+extern GPIO_TypeDef *ROW_Ports[];
+extern uint16_t ROW_Pins[];
+extern GPIO_TypeDef *COL_Ports[];
+extern uint16_t COL_Pins[];
+extern char keys[4][4];
+
+static uint8_t key_down[4][4];
+static uint8_t keys_held = 0; // 0 이면 열은 계속 HIGH → 행 스캔 때 계산 생략
+
+// 열 입력 = 풀업, 눌린 키의 행이 LOW 면 그 열도 LOW
+static void keypad_update_cols(void) {
+  for (uint8_t c = 0; c < 4; c++) {
+    uint8_t low = 0;
+    for (uint8_t r = 0; r < 4; r++) {
+      if (key_down[r][c] && !(ROW_Ports[r]->ODR & ROW_Pins[r]))
+        low = 1;
+    }
+    if (low)
+      COL_Ports[c]->IDR &= ~(uint32_t)COL_Pins[c];
+    else
+      COL_Ports[c]->IDR |= COL_Pins[c];
+  }
+}
+
+void Sim_KeySet(char key, uint8_t down) {
+  keys_held = 0;
+  for (uint8_t r = 0; r < 4; r++) {
+    for (uint8_t c = 0; c < 4; c++) {
+      if (keys[r][c] == key)
+        key_down[r][c] = down ? 1 : 0;
+      keys_held += key_down[r][c];
+    }
+  }
+  keypad_update_cols();
+}
+
+static uint32_t keypad_row_mask(GPIO_TypeDef *port) {
+  uint32_t mask = 0;
+  for (uint8_t r = 0; r < 4; r++) {
+    if (ROW_Ports[r] == port)
+      mask |= ROW_Pins[r];
+  }
+  return mask;
+}
+
+// ========== 입력 핀 ==========
+static GPIO_TypeDef *port_of(char port) {
+  switch (port) {
+  case 'A':
+    return GPIOA;
+  case 'B':
+    return GPIOB;
+  case 'C':
+    return GPIOC;
+  case 'H':
+    return GPIOH;
+  default:
+    return NULL;
+  }
+}
+
+static char name_of(GPIO_TypeDef *port) {
+  if (port == GPIOA)
+    return 'A';
+  if (port == GPIOB)
+    return 'B';
+  if (port == GPIOC)
+    return 'C';
+  return 'H';
+}
+
+void Sim_SetPin(char port, uint8_t pin, uint8_t level) {
+  GPIO_TypeDef *p = port_of(port);
+  if (p == NULL || pin > 15)
+    return;
+  if (level)
+    p->IDR |= (1u << pin);
+  else
+    p->IDR &= ~(1u << pin);
+}
+
+// ========== 트레이스 (CSV) ==========
+// 키패드 행은 1ms 마다 바뀌므로 뺌 (키 입력은 펌웨어 printf 로 보임)
+static FILE *trace = NULL;
+static uint32_t trace_ccr[2];
+static uint32_t gate_moves = 0;
+
+void Sim_TraceOpen(const char *path) {
+  if (trace != NULL)
+    fclose(trace);
+  trace = (path != NULL) ? fopen(path, "w") : NULL;
+  if (path != NULL && trace == NULL) {
+    perror(path);
+    return;
+  }
+  if (trace != NULL)
+    fprintf(trace, "t_ms,signal,value\n");
+}
+
+uint32_t Sim_GateMoves(void) { return gate_moves; }
+
+void Sim_BoardGpioChanged(GPIO_TypeDef *port, uint32_t old_odr,
+                          uint32_t new_odr) {
+  uint32_t diff = old_odr ^ new_odr;
+  uint32_t rows = diff & keypad_row_mask(port);
+
+  if (rows != 0) {
+    if (keys_held)
+      keypad_update_cols();
+    diff &= ~rows;
+  }
+  if (diff == 0 || trace == NULL)
+    return;
+
+  for (uint8_t pin = 0; pin < 16; pin++) {
+    uint32_t bit = 1u << pin;
+    if (diff & bit)
+      fprintf(trace, "%lu,P%c%u,%u\n", (unsigned long)Sim_NowMs(),
+              name_of(port), pin, (new_odr & bit) ? 1u : 0u);
+  }
+}
+
+// 서보 펄스 폭 (us). gate_write 는 ISR 밖에서도 쓰므로 1ms 마다 비교
+static void ccr_tick(uint32_t now_ms) {
+  const uint32_t ccr[2] = {TIM3->CCR1, TIM3->CCR2};
+  for (uint8_t i = 0; i < 2; i++) {
+    if (ccr[i] == trace_ccr[i])
+      continue;
+    trace_ccr[i] = ccr[i];
+    gate_moves++;
+    if (trace != NULL)
+      fprintf(trace, "%lu,TIM3.CCR%u,%lu\n", (unsigned long)now_ms, i + 1u,
+              (unsigned long)ccr[i]);
+  }
+}
+
+// ========== DHT11 (TIM3 CH4 하강 에지 캡처) ==========
+// 캡처를 켠 다음 틱에 42개 에지를 한 번에 넣음 (dht11.c 주석의 타이밍)
+//   F0 → F1: 160us (응답), 비트: 0 = 77us, 1 = 120us
+static TIM_HandleTypeDef *dht_tim = NULL;
+static uint8_t dht_present = 1;
+static uint8_t dht_temp = 24;
+static uint8_t dht_hum = 45;
+
+void Sim_SetDht(uint8_t present, uint8_t temp_c, uint8_t hum_pct) {
+  dht_present = present;
+  dht_temp = temp_c;
+  dht_hum = hum_pct;
+}
+
+void Sim_BoardDhtArm(TIM_HandleTypeDef *h) { dht_tim = h; }
+
+static void dht_capture(TIM_HandleTypeDef *h, uint32_t *t, uint32_t delta) {
+  uint32_t period = h->Instance->ARR + 1u;
+  *t = (*t + delta) % period;
+  h->Instance->CCR4 = *t;
+  h->Channel = HAL_TIM_ACTIVE_CHANNEL_4;
+  HAL_TIM_IC_CaptureCallback(h);
+  h->Channel = HAL_TIM_ACTIVE_CHANNEL_CLEARED;
+}
+
+static void dht_tick(void) {
+  TIM_HandleTypeDef *h = dht_tim;
+  if (h == NULL || !dht_present)
+    return;
+  dht_tim = NULL;
+
+  const uint8_t data[5] = {dht_hum, 0, dht_temp, 0,
+                           (uint8_t)(dht_hum + dht_temp)};
+  uint32_t t = h->Instance->CNT;
+
+  dht_capture(h, &t, 30);  // F0: 라인 해제 후 20~40us 뒤 응답 LOW
+  dht_capture(h, &t, 160); // F1
+  for (uint8_t bit = 0; bit < 40; bit++) {
+    uint8_t one = (data[bit / 8] >> (7 - (bit % 8))) & 1u;
+    dht_capture(h, &t, one ? 120u : 77u);
+  }
+}
+
+// ISR 문맥 (sim_step 안)
+void Sim_BoardTick(uint32_t now_ms) {
+  dht_tick();
+  ccr_tick(now_ms);
+}
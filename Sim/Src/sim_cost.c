@@ -0,0 +1,55 @@
+#include "prof.h"
+#include "sim.h"
+#include <string.h>
+
+// ========== 코드 실행 비용 모델 (sim_prof.h) ==========
+// PROF_STOP 마다 그 구간의 대략적인 타깃 사이클 (84MHz) 을 가상 시간에 더함
+// 태스크 구간은 안쪽 구간 (putchar, lcd 등) 비용이 이미 더해진 뒤 자기 몫만
+// 값은 타깃 perf 표 크기 정도의 추정치 (정밀 재현이 아니라 지터/경계 넘김용)
+// PROF_ENABLE 0 이면 PROF_STOP 이 없으므로 모델도 없음 (ISR 비용만 남음)
+#if PROF_ENABLE
+
+typedef struct {
+  const char *name;
+  uint32_t cycles;
+} Sim_Cost_t;
+
+static const Sim_Cost_t costs[] = {
+    {"keypad", 600},   // TIM2 1ms ISR: 행 하나 스캔 + 디바운스
+    {"lcd", 3000},     // 프레임 비교 + 니블 스트림 큐
+    {"putchar", 120},  // 한 글자 링 버퍼 쓰기
+    {"median", 150},   {"iir", 40},       {"movavg", 60},
+    {"level", 2500},   {"ctrl", 4000},    {"log", 8000},
+    {"rtc", 1500},     {"dht", 400},      {"dht_st", 300},
+    {"timer", 300},    {"ui", 12000},     {"export", 500},
+    {"tlm", 6000},     {"console", 800},  {"modbus", 200},
+    {"flash", 1000},
+};
+
+#define SIM_COST_DEFAULT 1000u // 표에 없는 구간
+
+// 구간 번호 → 비용 (이름이 바뀌면 다시 찾음: Sched_Init 뒤 재등록)
+static const char *cached_name[PROF_ZONE_COUNT];
+static uint32_t cached_cycles[PROF_ZONE_COUNT];
+
+static uint32_t zone_cost(uint8_t zone) {
+  const Prof_Stats_t *s = Prof_Get(zone);
+  const char *name = (s != NULL) ? s->name : NULL;
+  if (zone >= PROF_ZONE_COUNT)
+    return SIM_COST_DEFAULT;
+  if (name != cached_name[zone] || cached_cycles[zone] == 0) {
+    cached_name[zone] = name;
+    cached_cycles[zone] = SIM_COST_DEFAULT;
+    for (uint32_t i = 0; name && i < sizeof(costs) / sizeof(costs[0]); i++) {
+      if (strcmp(costs[i].name, name) == 0) {
+        cached_cycles[zone] = costs[i].cycles;
+        break;
+      }
+    }
+  }
+  return cached_cycles[zone];
+}
+
+void Sim_ProfCharge(uint8_t zone) { Sim_Charge(zone_cost(zone)); }
+
+#endif // PROF_ENABLE
@@ -0,0 +1,131 @@
+#include "flash_if.h"
+#include "sim.h"
+#include <stdio.h>
+#include <string.h>
+
+// ========== 로그 섹터 2개 (NOR 규칙 그대로, 파일 백업) ==========
+// App/Src/flash_if.c 대신 링크 (0x08040000 을 직접 읽을 수 없으므로)
+// program 은 1 → 0 만 (AND), erase 는 0xFF 로
+// Sim_FlashOpen 으로 파일을 붙이면 바뀐 범위를 바로 파일에 씀
+// → 같은 파일로 다시 실행 = 전원을 껐다 켠 것
+
+static uint8_t sectors[2][FLASH_IF_SECTOR_SIZE];
+static uint8_t erased_once = 0;
+static FILE *backing = NULL;
+
+// 전원 차단 주입: tear_at 번째 program 에서 keep_words 워드만 쓰고 꺼짐
+static uint32_t tear_at = 0; // 0 = 끔
+static uint32_t tear_keep = 0;
+static uint8_t powered_off = 0;
+
+static Sim_FlashStats_t stats;
+
+static void sim_flash_boot(void) {
+  if (!erased_once) {
+    memset(sectors, 0xFF, sizeof(sectors)); // 공장 출하 상태
+    erased_once = 1;
+  }
+}
+
+static void write_through(uint8_t sector, uint32_t offset, uint32_t len) {
+  if (backing == NULL)
+    return;
+  fseek(backing, (long)sector * FLASH_IF_SECTOR_SIZE + (long)offset, SEEK_SET);
+  fwrite(&sectors[sector][offset], 1, len, backing);
+  fflush(backing);
+}
+
+int Sim_FlashOpen(const char *path) {
+  if (backing != NULL)
+    fclose(backing);
+  backing = NULL;
+  tear_at = 0;
+  powered_off = 0;
+  memset(sectors, 0xFF, sizeof(sectors));
+  erased_once = 1;
+  if (path == NULL)
+    return 0;
+
+  backing = fopen(path, "r+b");
+  if (backing != NULL) {
+    size_t n = fread(sectors, 1, sizeof(sectors), backing);
+    if (n == sizeof(sectors))
+      return 0;
+    fclose(backing); // 크기가 다르면 새로 만듦
+  }
+  backing = fopen(path, "w+b");
+  if (backing == NULL) {
+    perror(path);
+    return -1;
+  }
+  memset(sectors, 0xFF, sizeof(sectors));
+  fwrite(sectors, 1, sizeof(sectors), backing);
+  fflush(backing);
+  return 0;
+}
+
+void Sim_FlashTear(uint32_t nth_program, uint32_t keep_words) {
+  tear_at = nth_program;
+  tear_keep = keep_words;
+  powered_off = 0;
+}
+
+uint8_t Sim_FlashPoweredOff(void) { return powered_off; }
+
+void Sim_FlashGetStats(Sim_FlashStats_t *out) { *out = stats; }
+
+void Sim_FlashResetStats(void) { memset(&stats, 0, sizeof(stats)); }
+
+static int SimFlash_Read(uint8_t sector, uint32_t offset, void *buf,
+                         uint32_t len) {
+  if (sector > 1 || offset + len > FLASH_IF_SECTOR_SIZE)
+    return -1;
+  sim_flash_boot();
+  stats.reads++;
+  stats.read_bytes += len;
+  memcpy(buf, &sectors[sector][offset], len);
+  return 0;
+}
+
+static int SimFlash_Program(uint8_t sector, uint32_t offset, const void *data,
+                            uint32_t len) {
+  if (sector > 1 || (offset & 3u) || (len & 3u) ||
+      offset + len > FLASH_IF_SECTOR_SIZE)
+    return -1;
+  if (powered_off)
+    return -1;
+  sim_flash_boot();
+
+  // 워드 단위로 기록 (STM32 FLASH_TYPEPROGRAM_WORD 와 같음)
+  uint32_t words = len / 4u;
+  if (tear_at != 0 && --tear_at == 0) {
+    if (tear_keep < words)
+      words = tear_keep;
+    powered_off = 1;
+  }
+
+  const uint8_t *src = (const uint8_t *)data;
+  for (uint32_t i = 0; i < words * 4u; i++)
+    sectors[sector][offset + i] &= src[i];
+  write_through(sector, offset, words * 4u);
+  stats.programs++;
+  stats.program_words += words;
+  return powered_off ? -1 : 0;
+}
+
+static int SimFlash_Erase(uint8_t sector) {
+  if (sector > 1 || powered_off)
+    return -1;
+  sim_flash_boot();
+  memset(sectors[sector], 0xFF, FLASH_IF_SECTOR_SIZE);
+  write_through(sector, 0, FLASH_IF_SECTOR_SIZE);
+  stats.erases++;
+  return 0;
+}
+
+const FlashIf_Ops_t flash_if_stm32 = {
+    .sector_size = FLASH_IF_SECTOR_SIZE,
+    .read = SimFlash_Read,
+    .program = SimFlash_Program,
+    .erase = SimFlash_Erase,
+};
@@ -0,0 +1,665 @@
+#include "sim.h"
+#include "adc.h"
+#include "main.h"
+#include "rtc.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ========== 레지스터 / 핸들 ==========
+// 입력 핀은 풀업 기본 (키패드 열, 조이스틱 버튼 = 안 눌림)
+GPIO_TypeDef GPIOA_s = {.IDR = 0xFFFF};
+GPIO_TypeDef GPIOB_s = {.IDR = 0xFFFF};
+GPIO_TypeDef GPIOC_s = {.IDR = 0xFFFF};
+GPIO_TypeDef GPIOH_s = {.IDR = 0xFFFF};
+TIM_TypeDef TIM2_s, TIM3_s;
+ADC_TypeDef ADC1_s;
+I2C_TypeDef I2C1_s;
+USART_TypeDef USART2_s;
+DMA_Stream_TypeDef DMA2_Stream0_s, DMA1_Stream5_s, DMA1_Stream6_s;
+DWT_Type DWT_s;
+CoreDebug_Type CoreDebug_s;
+uint32_t SystemCoreClock = SIM_CORE_CLOCK_HZ;
+RTC_HandleTypeDef hrtc;
+
+// ========== 가상 시간 ==========
+static uint32_t sim_ms = 0;
+static uint32_t sim_primask = 0;
+static uint32_t sim_ipsr = 0;
+
+static Sim_TickHook_t tick_hook = NULL;
+static Sim_EndHook_t end_hook = NULL;
+static uint32_t end_ms = 0;
+static int exit_code = 0;
+
+void Sim_SetTickHook(Sim_TickHook_t fn) { tick_hook = fn; }
+
+void Sim_SetEnd(uint32_t ms, Sim_EndHook_t fn) {
+  end_ms = ms;
+  end_hook = fn;
+}
+
+void Sim_SetExitCode(int code) { exit_code = code; }
+
+uint32_t Sim_NowMs(void) { return sim_ms; }
+
+// ========== ADC (원형 DMA, 반 버퍼마다 콜백) ==========
+static ADC_HandleTypeDef *adc_h = NULL;
+static uint16_t *adc_buf = NULL;
+static uint32_t adc_len = 0;
+static uint32_t adc_half_us = 0;
+static uint32_t adc_acc_us = 0;
+static uint8_t adc_next_half = 0;
+static uint16_t adc_value[ADC_NUM_CH] = {2048, 0, 2048, 943}; // 조이스틱 중앙, 25°C
+
+void Sim_SetAdc(uint8_t ch, uint16_t value) {
+  if (ch < ADC_NUM_CH)
+    adc_value[ch] = (value > 4095) ? 4095 : value;
+}
+
+static void adc_tick(void) {
+  if (adc_h == NULL)
+    return;
+  adc_acc_us += 1000;
+  while (adc_acc_us >= adc_half_us) {
+    adc_acc_us -= adc_half_us;
+    uint16_t *half = &adc_buf[adc_next_half ? adc_len / 2 : 0];
+    for (uint32_t i = 0; i < adc_len / 2; i++)
+      half[i] = adc_value[i % ADC_NUM_CH];
+
+    if (adc_next_half)
+      HAL_ADC_ConvCpltCallback(adc_h);
+    else
+      HAL_ADC_ConvHalfCpltCallback(adc_h);
+    Sim_Charge(SIM_COST_ISR_CYCLES);
+    adc_next_half = !adc_next_half;
+  }
+}
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *h) {
+  HAL_ADC_MspInit(h);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *h,
+                                        ADC_ChannelConfTypeDef *c) {
+  (void)h;
+  (void)c;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *h, uint32_t *buf,
+                                    uint32_t len) {
+  adc_h = h;
+  adc_buf = (uint16_t *)buf;
+  adc_len = len;
+  adc_half_us = (len / 2 / ADC_NUM_CH) * SIM_ADC_FRAME_US;
+  adc_acc_us = 0;
+  adc_next_half = 0;
+  return HAL_OK;
+}
+
+// ========== 바이트 전송 (UART DMA / I2C IT 공용, 속도만 다름) ==========
+typedef struct {
+  uint32_t bytes_per_s;
+  const uint8_t *data;
+  uint16_t len;
+  uint32_t credit; // 1/1000 바이트 단위
+} Sim_Xfer_t;
+
+static uint8_t xfer_start(Sim_Xfer_t *x, const uint8_t *data, uint16_t len) {
+  if (x->data != NULL)
+    return 0;
+  x->data = data;
+  x->len = len;
+  x->credit = 0;
+  return 1;
+}
+
+// 이번 1ms 안에 끝나면 1
+static uint8_t xfer_tick(Sim_Xfer_t *x) {
+  if (x->data == NULL)
+    return 0;
+  x->credit += x->bytes_per_s;
+  return x->credit >= (uint32_t)x->len * 1000u;
+}
+
+// ========== UART2 ==========
+static Sim_Xfer_t uart_tx = {.bytes_per_s = SIM_UART_BYTES_PER_S};
+static UART_HandleTypeDef *uart_h = NULL;
+static uint8_t uart_echo = 0;
+static Sim_UartSink_t uart_sink = NULL;
+static uint8_t *uart_rx_buf = NULL;
+static uint16_t uart_rx_size = 0;
+
+void Sim_SetUartEcho(uint8_t on) { uart_echo = on; }
+void Sim_SetUartSink(Sim_UartSink_t fn) { uart_sink = fn; }
+
+// 보낸 출력 (expect uart). 넘치면 앞쪽 절반을 버림
+#define UART_TEXT_SIZE 8192u
+static char uart_text[UART_TEXT_SIZE + 1];
+static uint32_t uart_text_len = 0;
+
+static void uart_text_append(const uint8_t *data, uint16_t len) {
+  for (uint16_t i = 0; i < len; i++) {
+    if (uart_text_len == UART_TEXT_SIZE) {
+      memmove(uart_text, uart_text + UART_TEXT_SIZE / 2, UART_TEXT_SIZE / 2);
+      uart_text_len = UART_TEXT_SIZE / 2;
+    }
+    uart_text[uart_text_len++] = (data[i] != '\0') ? (char)data[i] : ' ';
+  }
+  uart_text[uart_text_len] = '\0';
+}
+
+const char *Sim_UartTxText(void) { return uart_text; }
+
+void Sim_UartTxMark(uint32_t consumed) {
+  if (consumed > uart_text_len)
+    consumed = uart_text_len;
+  memmove(uart_text, uart_text + consumed, uart_text_len - consumed);
+  uart_text_len -= consumed;
+  uart_text[uart_text_len] = '\0';
+}
+
+// 수신 대기열 → DMA 버퍼 (1ms 에 최대 11바이트)
+#define UART_RXQ_SIZE 4096u
+static uint8_t uart_rxq[UART_RXQ_SIZE];
+static uint32_t uart_rxq_head = 0, uart_rxq_tail = 0;
+static uint32_t uart_rx_credit = 0;
+static uint16_t uart_rx_event_pos = 0; // 마지막 이벤트 때 위치
+
+void Sim_UartInject(const uint8_t *data, uint16_t len) {
+  for (uint16_t i = 0; i < len; i++) {
+    if (uart_rxq_head - uart_rxq_tail >= UART_RXQ_SIZE)
+      return; // 넘침: 나머지 버림
+    uart_rxq[uart_rxq_head++ % UART_RXQ_SIZE] = data[i];
+  }
+}
+
+static void uart_rx_event(uint16_t size) {
+  uart_rx_event_pos = (size >= uart_rx_size) ? 0 : size;
+  HAL_UARTEx_RxEventCallback(uart_h, size);
+  Sim_Charge(SIM_COST_ISR_CYCLES);
+}
+
+// 실제 HAL 과 같이: 반 바퀴 / 한 바퀴 / 수신 멈춤(idle) 에서 콜백
+static void uart_rx_tick(void) {
+  if (uart_rx_buf == NULL || uart_h == NULL)
+    return;
+  if (uart_rxq_head == uart_rxq_tail) {
+    uart_rx_credit = 0;
+    return;
+  }
+
+  DMA_Stream_TypeDef *dma = uart_h->hdmarx->Instance;
+  uint16_t pos = (uint16_t)(uart_rx_size - dma->NDTR);
+  uart_rx_credit += SIM_UART_BYTES_PER_S;
+
+  while (uart_rxq_head != uart_rxq_tail && uart_rx_credit >= 1000u) {
+    uart_rx_credit -= 1000u;
+    uart_rx_buf[pos++] = uart_rxq[uart_rxq_tail++ % UART_RXQ_SIZE];
+    dma->NDTR = (pos == uart_rx_size) ? uart_rx_size : uart_rx_size - pos;
+    if (pos == uart_rx_size / 2) {
+      uart_rx_event(pos);
+    } else if (pos == uart_rx_size) {
+      uart_rx_event(pos);
+      pos = 0;
+    }
+  }
+
+  if (uart_rxq_head == uart_rxq_tail && pos != uart_rx_event_pos)
+    uart_rx_event(pos); // idle 라인
+}
+
+static void uart_tick(void) {
+  uart_rx_tick();
+  if (!xfer_tick(&uart_tx))
+    return;
+  uart_text_append(uart_tx.data, uart_tx.len);
+  if (uart_echo) {
+    fwrite(uart_tx.data, 1, uart_tx.len, stdout);
+    fflush(stdout);
+  }
+  if (uart_sink != NULL)
+    uart_sink(uart_tx.data, uart_tx.len);
+  uart_tx.data = NULL;
+  uart_h->gState = HAL_UART_STATE_READY;
+  HAL_UART_TxCpltCallback(uart_h);
+  Sim_Charge(SIM_COST_ISR_CYCLES);
+}
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *h) {
+  HAL_UART_MspInit(h);
+  h->gState = HAL_UART_STATE_READY;
+  h->RxState = HAL_UART_STATE_READY;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *h, uint8_t *data,
+                                        uint16_t len) {
+  if (!xfer_start(&uart_tx, data, len))
+    return HAL_BUSY;
+  uart_h = h;
+  h->gState = 0;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *h,
+                                               uint8_t *buf, uint16_t size) {
+  uart_h = h;
+  uart_rx_buf = buf;
+  uart_rx_size = size;
+  uart_rx_event_pos = 0;
+  h->hdmarx->Instance->NDTR = size;
+  h->RxState = 0;
+  return HAL_OK;
+}
+
+void HAL_UART_IRQHandler(UART_HandleTypeDef *h) { (void)h; }
+
+// ========== I2C1 (LCD) ==========
+static Sim_Xfer_t i2c_tx = {.bytes_per_s = SIM_I2C_BYTES_PER_S};
+static I2C_HandleTypeDef *i2c_h = NULL;
+
+static void i2c_tick(void) {
+  if (!xfer_tick(&i2c_tx))
+    return;
+  Sim_LcdFeed(i2c_tx.data, (uint16_t)(i2c_tx.len - 1)); // 주소 바이트 제외
+  i2c_tx.data = NULL;
+  HAL_I2C_MasterTxCpltCallback(i2c_h);
+  Sim_Charge(SIM_COST_ISR_CYCLES);
+}
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *h) {
+  HAL_I2C_MspInit(h);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *h,
+                                             uint16_t addr, uint8_t *data,
+                                             uint16_t len) {
+  (void)addr;
+  // 주소 바이트 포함
+  if (!xfer_start(&i2c_tx, data, (uint16_t)(len + 1)))
+    return HAL_BUSY;
+  i2c_h = h;
+  return HAL_OK;
+}
+
+void HAL_I2C_EV_IRQHandler(I2C_HandleTypeDef *h) { (void)h; }
+void HAL_I2C_ER_IRQHandler(I2C_HandleTypeDef *h) { (void)h; }
+
+// ========== TIM ==========
+static TIM_HandleTypeDef *tim2_oc = NULL; // 1ms 틱 (CH1 비교 일치)
+
+// 자동 재장전 값으로 감음 (HAL_TIM_Base_Init 에서 ARR 설정)
+static void tim_count(TIM_TypeDef *tim, uint32_t us) {
+  tim->CNT = (tim->CNT + us) % (tim->ARR + 1u);
+}
+
+static void tim_tick(void) {
+  tim_count(TIM2, 1000); // 1MHz 카운터
+  tim_count(TIM3, 1000);
+  if (tim2_oc != NULL) {
+    tim2_oc->Channel = HAL_TIM_ACTIVE_CHANNEL_1;
+    HAL_TIM_OC_DelayElapsedCallback(tim2_oc);
+    tim2_oc->Channel = HAL_TIM_ACTIVE_CHANNEL_CLEARED;
+  }
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *h) {
+  h->Instance->ARR = h->Init.Period;
+  HAL_TIM_Base_MspInit(h);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *h) {
+  (void)h;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef *h,
+                                            TIM_ClockConfigTypeDef *c) {
+  (void)h;
+  (void)c;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef
+HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *h,
+                                      TIM_MasterConfigTypeDef *c) {
+  (void)h;
+  (void)c;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *h) {
+  (void)h;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *h,
+                                            TIM_OC_InitTypeDef *c,
+                                            uint32_t ch) {
+  __HAL_TIM_SET_COMPARE(h, ch, c->Pulse);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *h, uint32_t ch) {
+  (void)h;
+  (void)ch;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_OC_ConfigChannel(TIM_HandleTypeDef *h,
+                                           TIM_OC_InitTypeDef *c,
+                                           uint32_t ch) {
+  __HAL_TIM_SET_COMPARE(h, ch, c->Pulse);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_OC_Start_IT(TIM_HandleTypeDef *h, uint32_t ch) {
+  if (h->Instance == TIM2 && ch == TIM_CHANNEL_1)
+    tim2_oc = h;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_IC_ConfigChannel(TIM_HandleTypeDef *h,
+                                           TIM_IC_InitTypeDef *c,
+                                           uint32_t ch) {
+  (void)h;
+  (void)c;
+  (void)ch;
+  return HAL_OK;
+}
+
+// TIM3 CH4 = DHT11 (sim_board.c 가 다음 틱에 에지를 넣음)
+HAL_StatusTypeDef HAL_TIM_IC_Start_IT(TIM_HandleTypeDef *h, uint32_t ch) {
+  if (h->Instance == TIM3 && ch == TIM_CHANNEL_4)
+    Sim_BoardDhtArm(h);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_IC_Stop_IT(TIM_HandleTypeDef *h, uint32_t ch) {
+  if (h->Instance == TIM3 && ch == TIM_CHANNEL_4)
+    Sim_BoardDhtArm(NULL);
+  return HAL_OK;
+}
+
+void HAL_TIM_IRQHandler(TIM_HandleTypeDef *h) { (void)h; }
+
+// ========== RTC (설정 시각 + 가상 경과 시간) ==========
+static RTC_TimeTypeDef rtc_time;
+static RTC_DateTypeDef rtc_date = {.WeekDay = 1, .Month = 1, .Date = 1};
+static uint32_t rtc_set_ms = 0;
+
+static uint8_t days_in_month(uint8_t month, uint8_t year) {
+  static const uint8_t days[12] = {31, 28, 31, 30, 31, 30,
+                                   31, 31, 30, 31, 30, 31};
+  if (month == 2 && (year % 4) == 0)
+    return 29;
+  return days[(month - 1) % 12];
+}
+
+// 설정 시각에 경과 초를 더해 확정 (Get 할 때마다 기준을 다시 잡음)
+static void rtc_advance(void) {
+  uint32_t elapsed = (sim_ms - rtc_set_ms) / 1000;
+  rtc_set_ms += elapsed * 1000;
+
+  uint32_t s = rtc_time.Hours * 3600u + rtc_time.Minutes * 60u +
+               rtc_time.Seconds + elapsed;
+  uint32_t days = s / 86400u;
+  s %= 86400u;
+  rtc_time.Hours = (uint8_t)(s / 3600u);
+  rtc_time.Minutes = (uint8_t)((s / 60u) % 60u);
+  rtc_time.Seconds = (uint8_t)(s % 60u);
+
+  while (days--) {
+    rtc_date.WeekDay = (uint8_t)(rtc_date.WeekDay % 7 + 1);
+    if (++rtc_date.Date > days_in_month(rtc_date.Month, rtc_date.Year)) {
+      rtc_date.Date = 1;
+      if (++rtc_date.Month > 12) {
+        rtc_date.Month = 1;
+        rtc_date.Year++;
+      }
+    }
+  }
+}
+
+HAL_StatusTypeDef HAL_RTC_SetTime(RTC_HandleTypeDef *h, RTC_TimeTypeDef *t,
+                                  uint32_t fmt) {
+  (void)h;
+  (void)fmt;
+  rtc_advance();
+  rtc_time = *t;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_SetDate(RTC_HandleTypeDef *h, RTC_DateTypeDef *d,
+                                  uint32_t fmt) {
+  (void)h;
+  (void)fmt;
+  rtc_advance();
+  rtc_date = *d;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *h, RTC_TimeTypeDef *t,
+                                  uint32_t fmt) {
+  (void)h;
+  (void)fmt;
+  rtc_advance();
+  *t = rtc_time;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *h, RTC_DateTypeDef *d,
+                                  uint32_t fmt) {
+  (void)h;
+  (void)fmt;
+  rtc_advance();
+  *d = rtc_date;
+  return HAL_OK;
+}
+
+// 백업 레지스터 20개 (VBAT 영역). 프로세스 시작 = 백업 전지 없이 첫 전원
+static uint32_t rtc_bkp[20];
+
+uint32_t HAL_RTCEx_BKUPRead(RTC_HandleTypeDef *h, uint32_t reg) {
+  (void)h;
+  return (reg < 20) ? rtc_bkp[reg] : 0;
+}
+
+void HAL_RTCEx_BKUPWrite(RTC_HandleTypeDef *h, uint32_t reg, uint32_t data) {
+  (void)h;
+  if (reg < 20)
+    rtc_bkp[reg] = data;
+}
+
+void MX_RTC_Init(void) {}
+
+// ========== DWT CYCCNT ==========
+// 기본: 가상 시간 (1ms 마다 SystemCoreClock / 1000 씩)
+// 호스트 시계 모드: 실제 경과 시간을 코어 클럭 사이클로 환산 (단위 벤치용)
+static uint8_t dwt_host = 0;
+
+void Sim_DwtHostClock(uint8_t on) { dwt_host = on; }
+
+DWT_Type *Sim_Dwt(void) {
+  if (dwt_host) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t ns = (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+    DWT_s.CYCCNT = (uint32_t)(ns * (SystemCoreClock / 1000000u) / 1000u);
+  }
+  return &DWT_s;
+}
+
+// ========== 실행 비용 (가상 시간) ==========
+// 펌웨어 코드는 호스트에서 시간을 쓰지 않으므로, 구간 / ISR 마다 정해 둔
+// 사이클만큼 CYCCNT 를 직접 진행. ms 경계를 넘으면 그 자리에서 틱 (ISR 포함)
+// → 긴 태스크 도중 1ms 인터럽트가 끼어들고, 뒤 태스크는 그만큼 늦게 시작
+static uint32_t cyc_in_ms = 0; // 이번 ms 안에서 이미 쓴 사이클
+static uint8_t charging = 0;
+
+static void sim_tick(void);
+
+void Sim_Charge(uint32_t cycles) {
+  if (dwt_host)
+    return;
+  DWT_s.CYCCNT += cycles;
+  cyc_in_ms += cycles;
+  if (charging)
+    return; // 틱 안의 ISR 비용: 바깥 루프가 이어서 처리
+  charging = 1;
+  while (cyc_in_ms >= SystemCoreClock / 1000u) {
+    cyc_in_ms -= SystemCoreClock / 1000u;
+    sim_tick();
+  }
+  charging = 0;
+}
+
+// ========== 1ms 진행 ==========
+// __WFI / HAL_Delay: 다음 ms 경계까지 쉬고 틱
+static void sim_step(void) {
+  DWT_s.CYCCNT += SystemCoreClock / 1000u - cyc_in_ms;
+  cyc_in_ms = 0;
+  charging = 1;
+  sim_tick();
+  charging = 0;
+  Sim_Charge(0); // 틱 안의 ISR 만으로 1ms 를 넘긴 경우
+}
+
+static void sim_tick(void) {
+  sim_ms++;
+
+  if (tick_hook != NULL)
+    tick_hook(sim_ms);
+
+  // 이 안은 ISR 문맥 (__get_IPSR != 0)
+  sim_ipsr = 1;
+  tim_tick();
+  adc_tick();
+  uart_tick();
+  i2c_tick();
+  Sim_BoardTick(sim_ms);
+  sim_ipsr = 0;
+
+  if (end_hook != NULL && sim_ms >= end_ms) {
+    Sim_EndHook_t fn = end_hook;
+    end_hook = NULL;
+    fn();
+    fflush(stdout);
+    exit(exit_code);
+  }
+}
+
+uint32_t HAL_GetTick(void) { return sim_ms; }
+
+void HAL_Delay(uint32_t ms) {
+  // HAL 과 같이 최소 1틱 더 기다림
+  for (uint32_t i = 0; i <= ms; i++)
+    sim_step();
+}
+
+void __WFI(void) { sim_step(); }
+
+HAL_StatusTypeDef HAL_Init(void) {
+  Sim_LcdReset();
+  return HAL_OK;
+}
+
+// ========== 코어 / 나머지 (할 일 없음) ==========
+uint32_t __get_PRIMASK(void) { return sim_primask; }
+uint32_t __get_IPSR(void) { return sim_ipsr; }
+void __set_PRIMASK(uint32_t v) { sim_primask = v; }
+void __disable_irq(void) { sim_primask = 1; }
+void __enable_irq(void) { sim_primask = 0; }
+void __DSB(void) {}
+// 다른 파일의 함수 호출이라 컴파일러 재배치도 막힘 (ISR 은 같은 스레드)
+void __DMB(void) { __asm__ volatile("" ::: "memory"); }
+void __NOP(void) {}
+
+void HAL_NVIC_SetPriority(IRQn_Type irq, uint32_t pre, uint32_t sub) {
+  (void)irq;
+  (void)pre;
+  (void)sub;
+}
+void HAL_NVIC_EnableIRQ(IRQn_Type irq) { (void)irq; }
+void HAL_NVIC_DisableIRQ(IRQn_Type irq) { (void)irq; }
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *c) {
+  (void)c;
+  return HAL_OK;
+}
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *c, uint32_t lat) {
+  (void)c;
+  (void)lat;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *h) {
+  (void)h;
+  return HAL_OK;
+}
+HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef *h) {
+  (void)h;
+  return HAL_OK;
+}
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *h) { (void)h; }
+void MX_DMA_Init(void) {}
+
+void HAL_GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init) {
+  (void)port;
+  (void)init;
+}
+void HAL_GPIO_DeInit(GPIO_TypeDef *port, uint32_t pin) {
+  (void)port;
+  (void)pin;
+}
+
+static void gpio_write(GPIO_TypeDef *port, uint32_t odr) {
+  uint32_t old = port->ODR;
+  port->ODR = odr;
+  if (old != odr)
+    Sim_BoardGpioChanged(port, old, odr);
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState st) {
+  if (st == GPIO_PIN_SET)
+    gpio_write(port, port->ODR | pin);
+  else
+    gpio_write(port, port->ODR & ~(uint32_t)pin);
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin) {
+  return (port->IDR & pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *port, uint16_t pin) {
+  gpio_write(port, port->ODR ^ pin);
+}
+
+// ========== 치명 오류 / printf ==========
+// main.c 는 -DError_Handler=fw_Error_Handler 로 빌드 (무한 루프 대신 종료)
+void Error_Handler(void) {
+  fprintf(stderr, "[SIM] Error_Handler at %lu ms\n", (unsigned long)sim_ms);
+  exit(2);
+}
+
+int __io_putchar(int ch);
+
+int sim_printf(const char *fmt, ...) {
+  char buf[256];
+  va_list ap;
+  va_start(ap, fmt);
+  int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+
+  int len = (n < (int)sizeof(buf)) ? n : (int)sizeof(buf) - 1;
+  for (int i = 0; i < len; i++)
+    __io_putchar((uint8_t)buf[i]);
+  return n;
+}
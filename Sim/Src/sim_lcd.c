@@ -0,0 +1,127 @@
+#include "sim.h"
+#include <string.h>
+
+// ========== PCF8574 → HD44780 (4비트) 디코더 ==========
+// PCF8574 한 바이트: P0=RS, P1=RW, P2=EN, P3=백라이트, P4~P7=D4~D7
+// EN 하강 에지에서 니블 래치. 전원 직후는 8비트 모드 (0x33, 0x32 매직 시퀀스)
+
+#define PCF_RS 0x01
+#define PCF_EN 0x04
+#define PCF_BL 0x08
+
+#define DDRAM_SIZE 0x68 // 0x00~0x27 (1행), 0x40~0x67 (2행)
+#define TRACE_SIZE 256  // 마지막 Sim_LcdTrace 이후 받은 PCF8574 바이트
+
+static struct {
+  uint8_t ddram[DDRAM_SIZE];
+  uint8_t addr;
+  uint8_t mode8;     // 1 = 8비트 인터페이스 (초기 상태)
+  uint8_t have_high; // 4비트: 상위 니블 받음
+  uint8_t high;
+  uint8_t last_pins;
+  uint8_t display_on;
+  uint8_t backlight;
+  uint32_t writes; // 데이터 바이트 수
+  uint32_t commands;
+  uint32_t bytes; // I2C 로 받은 PCF8574 바이트 수 (주소 바이트 제외)
+  uint8_t trace[TRACE_SIZE];
+  uint16_t trace_len; // TRACE_SIZE 를 넘으면 뒤는 버리고 수만 셈
+  char line[SIM_LCD_ROWS][SIM_LCD_COLS + 1];
+} lcd;
+
+void Sim_LcdReset(void) {
+  memset(&lcd, 0, sizeof(lcd));
+  memset(lcd.ddram, ' ', sizeof(lcd.ddram));
+  lcd.mode8 = 1;
+}
+
+static void addr_step(void) {
+  lcd.addr++;
+  if (lcd.addr == 0x28)
+    lcd.addr = 0x40;
+  else if (lcd.addr >= DDRAM_SIZE)
+    lcd.addr = 0x00;
+}
+
+static void exec(uint8_t rs, uint8_t v) {
+  if (rs) {
+    if (lcd.addr < DDRAM_SIZE)
+      lcd.ddram[lcd.addr] = v;
+    addr_step();
+    lcd.writes++;
+    return;
+  }
+
+  lcd.commands++;
+  if (v & 0x80) {
+    lcd.addr = v & 0x7F; // Set DDRAM address
+  } else if (v & 0x20) {
+    lcd.mode8 = (v & 0x10) ? 1 : 0; // Function set: DL
+    lcd.have_high = 0;
+  } else if (v & 0x08) {
+    lcd.display_on = (v & 0x04) ? 1 : 0;
+  } else if (v & 0x02) {
+    lcd.addr = 0; // Return home
+  } else if (v & 0x01) {
+    memset(lcd.ddram, ' ', sizeof(lcd.ddram)); // Clear
+    lcd.addr = 0;
+  }
+}
+
+static void latch(uint8_t pins) {
+  uint8_t rs = pins & PCF_RS;
+  uint8_t nib = pins & 0xF0;
+
+  if (lcd.mode8) {
+    exec(rs, nib); // D0~D3 는 배선 안 됨 → 0
+    return;
+  }
+  if (!lcd.have_high) {
+    lcd.high = nib;
+    lcd.have_high = 1;
+  } else {
+    lcd.have_high = 0;
+    exec(rs, (uint8_t)(lcd.high | (nib >> 4)));
+  }
+}
+
+void Sim_LcdFeed(const uint8_t *data, uint16_t len) {
+  for (uint16_t i = 0; i < len; i++) {
+    uint8_t pins = data[i];
+    if (lcd.trace_len < TRACE_SIZE)
+      lcd.trace[lcd.trace_len] = pins;
+    if (lcd.trace_len < UINT16_MAX)
+      lcd.trace_len++;
+    lcd.bytes++;
+    if ((lcd.last_pins & PCF_EN) && !(pins & PCF_EN))
+      latch(lcd.last_pins);
+    lcd.backlight = (pins & PCF_BL) ? 1 : 0;
+    lcd.last_pins = pins;
+  }
+}
+
+const char *Sim_LcdLine(uint8_t row) {
+  if (row >= SIM_LCD_ROWS)
+    return "";
+  const uint8_t base = row ? 0x40 : 0x00;
+  for (uint8_t c = 0; c < SIM_LCD_COLS; c++) {
+    uint8_t ch = lcd.ddram[base + c];
+    lcd.line[row][c] = (ch >= 0x20 && ch < 0x7F) ? (char)ch : '?';
+  }
+  lcd.line[row][SIM_LCD_COLS] = '\0';
+  return lcd.line[row];
+}
+
+uint32_t Sim_LcdWrites(void) { return lcd.writes; }
+
+uint32_t Sim_LcdBytes(void) { return lcd.bytes; }
+
+uint16_t Sim_LcdTrace(uint8_t *out, uint16_t cap) {
+  uint16_t n = lcd.trace_len;
+  uint16_t copy = n < TRACE_SIZE ? n : TRACE_SIZE;
+  if (copy > cap)
+    copy = cap;
+  memcpy(out, lcd.trace, copy);
+  lcd.trace_len = 0;
+  return n;
+}
@@ -0,0 +1,385 @@
+#define _GNU_SOURCE // posix_openpt, ptsname
+#include "adc.h"
+#include "latency.h"
+#include "modbus_map.h"
+#include "sim.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+// ========== 호스트 시뮬레이터 진입점 ==========
+// 기본: 지연 회귀 / -s: 스크립트 회귀 / -i: 실시간 대화형 (sim.h 참고) /
+// -p: Modbus RTU pty
+
+// ========== 시나리오: 감지 → 구동 지연 회귀 ==========
+// 수위를 0% → 60% → 0% 삼각파로 (기본 임계값 10/40% 를 양방향으로 통과)
+// 자동 모드에서 상태가 바뀔 때마다 ADC 프레임 → 결정 → TIM3 CCR 지연을 잼
+// 제어 주기 지터는 실행 비용 모델 (sim_cost.c) 로 생김: ISR 부하 + 앞 태스크
+// 종료 코드: 0 = 예산 안, 1 = e2e 또는 지터 p99 초과, 측정 없음
+
+extern uint8_t dam_auto_mode; // ap.c
+extern uint8_t is_logged_in;  // ap.c
+
+#define LEVEL_PERIOD_MS 40000u
+#define LEVEL_PEAK_PCT 60u
+
+static uint32_t budget_us = 60000; // 제어 주기 50ms + 수위 태스크 5ms + 여유
+// 제어 태스크 시작 지터: 앞서 잡은 태스크 하나 (ui ~150us) + ISR 몇 개
+static uint32_t jitter_budget_us = 200;
+static struct timespec wall_start;
+
+static uint8_t use_script = 0;
+static uint8_t interactive = 0;
+static uint8_t use_pty = 0;
+static uint8_t show_lcd = 0;
+
+static void level_script(uint32_t now_ms) {
+  uint32_t phase = now_ms % LEVEL_PERIOD_MS;
+  uint32_t half = LEVEL_PERIOD_MS / 2;
+  uint32_t pct_x100 = (phase < half)
+                          ? phase * LEVEL_PEAK_PCT * 100u / half
+                          : (LEVEL_PERIOD_MS - phase) * LEVEL_PEAK_PCT * 100u /
+                                half;
+  Sim_SetAdc(ADC_CH_LEVEL, (uint16_t)(pct_x100 * 4095u / 10000u));
+
+  if (now_ms == 1)
+    dam_auto_mode = 1; // apInit 뒤 첫 틱 (로그인 없이 자동 모드)
+}
+
+static double wall_seconds(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)(now.tv_sec - wall_start.tv_sec) +
+         (double)(now.tv_nsec - wall_start.tv_nsec) / 1e9;
+}
+
+static void report_speed(void) {
+  double wall = wall_seconds();
+  double virt = Sim_NowMs() / 1000.0;
+  printf("[SIM] %.0f s virtual in %.2f s wall (x%.0f), LCD %lu chars, "
+         "gate moves %lu\n",
+         virt, wall, wall > 0 ? virt / wall : 0.0,
+         (unsigned long)Sim_LcdWrites(), (unsigned long)Sim_GateMoves());
+}
+
+static void report(void) {
+#if PROF_ENABLE
+  static const char *const names[LAT_S_COUNT] = {"age", "jitter", "decide",
+                                                 "actuate", "e2e"};
+  report_speed();
+  printf("series     count    p50    p99    max  max_all (us)\n");
+
+  uint32_t tpu = Prof_TicksPerUs();
+  Lat_Summary_t e2e = {0}, jitter = {0};
+  for (uint8_t s = 0; s < LAT_S_COUNT; s++) {
+    Lat_Summary_t sum;
+    Lat_Summary((Lat_Series_t)s, &sum);
+    if (s == LAT_S_END_TO_END)
+      e2e = sum;
+    if (s == LAT_S_JITTER)
+      jitter = sum;
+    printf("%-8s %7lu %6lu %6lu %6lu %8lu\n", names[s],
+           (unsigned long)sum.count, (unsigned long)(sum.p50 / tpu),
+           (unsigned long)(sum.p99 / tpu), (unsigned long)(sum.max / tpu),
+           (unsigned long)(sum.max_all / tpu));
+  }
+
+  uint8_t pass = e2e.count > 0 && e2e.p99 / tpu <= budget_us;
+  printf("e2e p99 %lu us, budget %lu us: %s\n",
+         (unsigned long)(e2e.p99 / tpu), (unsigned long)budget_us,
+         pass ? "PASS" : "FAIL");
+
+  // 지터가 전부 0 이면 비용 모델이 빠진 것 (실행 시간 0 인 시뮬레이터)
+  uint8_t jpass = jitter.count > 0 && jitter.max_all > 0 &&
+                  jitter.p99 / tpu <= jitter_budget_us;
+  printf("jitter p99 %lu us (max %lu), budget %lu us: %s\n",
+         (unsigned long)(jitter.p99 / tpu),
+         (unsigned long)(jitter.max_all / tpu),
+         (unsigned long)jitter_budget_us, jpass ? "PASS" : "FAIL");
+  Sim_SetExitCode((pass && jpass) ? 0 : 1);
+#else
+  report_speed();
+  printf("latency: not measured (PROF_ENABLE=0)\n");
+  Sim_SetExitCode(0);
+#endif
+}
+
+// ========== 시나리오: 스크립트 (-s) ==========
+// 종료 코드: 0 = expect 모두 통과, 1 = 실패 있음
+static void script_report(void) {
+  report_speed();
+  uint32_t failed = Sim_ScriptFailures();
+  printf("[SIM] script: %lu expects, %lu failed: %s\n",
+         (unsigned long)Sim_ScriptExpects(), (unsigned long)failed,
+         failed ? "FAIL" : "PASS");
+  Sim_SetExitCode(failed ? 1 : 0);
+}
+
+// ========== 대화형 (-i) ==========
+// 가상 시간을 실제 시간에 맞추고 stdin 을 UART 수신으로
+// '!' 로 시작하는 줄은 스크립트 명령 (예: !key 1234#, !joy up, !click)
+static char line_buf[160];
+static uint16_t line_len = 0;
+
+// 가상 시간이 실제 시간보다 앞서면 기다림 (10ms 마다)
+static void pace(uint32_t now_ms) {
+  double ahead = now_ms / 1000.0 - wall_seconds();
+  if (ahead > 0) {
+    struct timespec ts = {(time_t)ahead, (long)((ahead - (time_t)ahead) * 1e9)};
+    nanosleep(&ts, NULL);
+  }
+}
+
+static void interactive_tick(uint32_t now_ms) {
+  if (now_ms % 10 != 0)
+    return;
+  pace(now_ms);
+
+  char buf[64];
+  ssize_t n = read(STDIN_FILENO, buf, sizeof(buf));
+  for (ssize_t i = 0; i < n; i++) {
+    if (buf[i] != '\n' && line_len < sizeof(line_buf) - 1) {
+      line_buf[line_len++] = buf[i];
+      continue;
+    }
+    line_buf[line_len] = '\0';
+    if (line_buf[0] == '!') {
+      Sim_ScriptExec(line_buf + 1);
+    } else {
+      line_buf[line_len++] = '\r';
+      Sim_UartInject((const uint8_t *)line_buf, line_len);
+    }
+    line_len = 0;
+  }
+}
+
+// ========== Modbus pty (-p) ==========
+// pty 하나가 USART2 선: 로컬 마스터가 출력된 경로로 접속
+// (예: mbpoll -m rtu -a 1 -b 115200 -t 3 -r 1 -c 6 /dev/pts/N)
+// 펌웨어 경로 그대로: 키패드 로그인 → 콘솔 'modbus' → 수신 DMA → TIM2 1ms 틱
+// (MB_TimerTick 3.5문자 간격) → Task_Modbus → 송신 DMA → pty
+// 연결은 전환 안내 문구가 다 나간 뒤부터. holding 5 = 0 이면 pty 가 콘솔이 됨
+#define PTY_SWITCH_MS 100
+
+typedef enum { PTY_LOGIN = 0, PTY_SWITCH, PTY_SERVE } Pty_State_t;
+
+static int pty_fd = -1;
+static uint8_t pty_state = PTY_LOGIN;
+static uint32_t pty_switch_at = 0;
+
+// 요청 주입 → 응답 송신 완료 (가상 시간: 수신 + 프레임 간격 + 처리 + 송신)
+// DWT 를 직접 읽음 (PROF_ENABLE 0 빌드에도 있는 가상 사이클 카운터)
+#define PTY_TICKS_PER_US (SIM_CORE_CLOCK_HZ / 1000000u)
+static uint8_t pty_waiting = 0;
+static uint32_t pty_req_at = 0;
+static uint32_t pty_responses = 0;
+static uint64_t pty_turn_sum = 0;
+static uint32_t pty_turn_max = 0;
+
+static int pty_open(void) {
+  int fd = posix_openpt(O_RDWR | O_NOCTTY);
+  if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0) {
+    perror("pty");
+    return -1;
+  }
+  struct termios tio;
+  tcgetattr(fd, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(fd, TCSANOW, &tio);
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  printf("[SIM] modbus pty: %s (slave %u, 115200 8N1)\n", ptsname(fd),
+         MODBUS_SLAVE_ADDR);
+  fflush(stdout);
+  return fd;
+}
+
+static void pty_sink(const uint8_t *data, uint16_t len) {
+  if (pty_state != PTY_SERVE)
+    return;
+  ssize_t w = write(pty_fd, data, len);
+  (void)w; // 마스터가 없으면 버림
+
+  if (pty_waiting) {
+    // 응답은 보통 DMA 한 번 (링 끝에서 나뉘면 첫 덩어리까지)
+    uint32_t us = (DWT->CYCCNT - pty_req_at) / PTY_TICKS_PER_US;
+    pty_waiting = 0;
+    pty_responses++;
+    pty_turn_sum += us;
+    if (us > pty_turn_max)
+      pty_turn_max = us;
+  }
+}
+
+static void pty_tick(uint32_t now_ms) {
+  switch (pty_state) {
+  case PTY_LOGIN:
+    // 콘솔 설정 명령은 키패드 로그인 뒤에만 (apInit 의 안내 화면 이후)
+    if (now_ms == 500 && !is_logged_in)
+      Sim_ScriptExec("key 1234#");
+    if (is_logged_in && now_ms > 500) {
+      Sim_UartInject((const uint8_t *)"modbus\r", 7);
+      pty_switch_at = now_ms;
+      pty_state = PTY_SWITCH;
+    }
+    break;
+  case PTY_SWITCH:
+    if (uart_proto == UART_PROTO_MODBUS &&
+        now_ms - pty_switch_at >= PTY_SWITCH_MS) {
+      pty_state = PTY_SERVE;
+      printf("[SIM] modbus: serving\n");
+      fflush(stdout);
+    }
+    break;
+  case PTY_SERVE: {
+    uint8_t buf[64];
+    ssize_t n = read(pty_fd, buf, sizeof(buf));
+    if (n > 0) {
+      if (!pty_waiting) {
+        pty_waiting = 1;
+        pty_req_at = DWT->CYCCNT;
+      }
+      Sim_UartInject(buf, (uint16_t)n);
+    }
+    break;
+  }
+  }
+  if (now_ms % 10 == 0)
+    pace(now_ms);
+}
+
+static void pty_report(void) {
+  report_speed();
+  printf("[SIM] modbus: %lu responses, turnaround avg %lu us, max %lu us\n",
+         (unsigned long)pty_responses,
+         (unsigned long)(pty_responses ? pty_turn_sum / pty_responses : 0),
+         (unsigned long)pty_turn_max);
+  Sim_SetExitCode(0);
+}
+
+// LCD 가 바뀌면 출력 (-l)
+static void lcd_tick(uint32_t now_ms) {
+  static char shown[SIM_LCD_ROWS][SIM_LCD_COLS + 1];
+  if (now_ms % 20 != 0)
+    return;
+  uint8_t changed = 0;
+  for (uint8_t r = 0; r < SIM_LCD_ROWS; r++) {
+    const char *line = Sim_LcdLine(r);
+    if (strcmp(line, shown[r]) != 0) {
+      memcpy(shown[r], line, sizeof(shown[r]));
+      changed = 1;
+    }
+  }
+  if (changed)
+    printf("[LCD %7lu] |%s|%s|\n", (unsigned long)now_ms, shown[0], shown[1]);
+}
+
+static void tick(uint32_t now_ms) {
+  if (use_pty)
+    pty_tick(now_ms);
+  else if (use_script)
+    Sim_ScriptTick(now_ms);
+  else if (!interactive)
+    level_script(now_ms);
+  if (interactive || use_pty)
+    Sim_ScriptTick(now_ms); // '!' / 로그인 키 입력 대기열
+  if (interactive)
+    interactive_tick(now_ms);
+  if (show_lcd)
+    lcd_tick(now_ms);
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "usage: %s [-t seconds] [-b budget_ms] [-j jitter_us] [-s script] "
+          "[-g trace.csv] [-f flash.bin] [-v] [-l] [-i | -p]\n"
+          "  (none)  level triangle, latency report, exit 1 over budget\n"
+          "  -b, -j  e2e p99 budget (ms), control jitter p99 budget (us)\n"
+          "  -s      run a script (Sim/scripts), exit 1 if an expect fails\n"
+          "  -g      CSV trace of output pins and TIM3 CCR1/CCR2\n"
+          "  -f      keep the log flash sectors in a file (rerun = reboot)\n"
+          "  -v      echo UART output, -l print LCD changes\n"
+          "  -i      real time, stdin -> UART ('!cmd' = script command)\n"
+          "  -p      real time, Modbus RTU on a pty (path printed at start)\n",
+          prog);
+}
+
+int main(int argc, char **argv) {
+  uint32_t seconds = 600;
+  uint8_t seconds_set = 0;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "t:b:j:s:g:f:vlip")) != -1) {
+    switch (opt) {
+    case 't':
+      seconds = (uint32_t)strtoul(optarg, NULL, 10);
+      seconds_set = 1;
+      break;
+    case 'b':
+      budget_us = (uint32_t)strtoul(optarg, NULL, 10) * 1000u;
+      break;
+    case 'j':
+      jitter_budget_us = (uint32_t)strtoul(optarg, NULL, 10);
+      break;
+    case 's':
+      if (Sim_ScriptLoad(optarg) != 0)
+        return 2;
+      use_script = 1;
+      break;
+    case 'g':
+      Sim_TraceOpen(optarg);
+      break;
+    case 'f':
+      if (Sim_FlashOpen(optarg) != 0)
+        return 2;
+      break;
+    case 'v':
+      Sim_SetUartEcho(1);
+      break;
+    case 'l':
+      show_lcd = 1;
+      break;
+    case 'i':
+      interactive = 1;
+      break;
+    case 'p':
+      use_pty = 1;
+      break;
+    default:
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  uint32_t end_ms = seconds * 1000u;
+  Sim_EndHook_t end_fn = report;
+  if (use_script) {
+    end_fn = script_report;
+    if (!seconds_set && Sim_ScriptEnd() != 0)
+      end_ms = Sim_ScriptEnd();
+  }
+  if (interactive) {
+    Sim_SetUartEcho(1);
+    fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+    if (!seconds_set)
+      end_ms = UINT32_MAX;
+  }
+
+  if (use_pty) {
+    pty_fd = pty_open();
+    if (pty_fd < 0)
+      return 2;
+    Sim_SetUartSink(pty_sink);
+    end_fn = pty_report;
+    if (!seconds_set)
+      end_ms = UINT32_MAX;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &wall_start);
+  Sim_SetTickHook(tick);
+  Sim_SetEnd(end_ms, end_fn);
+  return fw_main(); // apMain 은 돌아오지 않음 → Sim_SetEnd 에서 종료
+}
@@ -0,0 +1,452 @@
+#include "sim.h"
+#include "adc.h"
+#include "crc16.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ========== 시나리오 스크립트 ==========
+// 한 줄 = "<시각> <명령> [인자]", '#' 로 시작하는 줄은 주석
+//   시각: 1500 (절대 ms), 2s, 1h (절대), +200 / +1s (앞 줄 기준)
+// 입력 (키, 조이스틱) 은 순서대로 이어서 누름 → 앞 입력이 끝난 뒤 시작
+
+#define SCRIPT_LINE_MAX 160
+#define INPUT_QUEUE_SIZE 512u // 2의 거듭제곱
+#define KEY_HOLD_MS 60        // 디바운스 20ms + Task_UI 20ms 주기보다 길게
+#define JOY_HOLD_MS 100       // ADC 평균 필터가 따라오는 시간 포함
+
+typedef struct {
+  uint32_t at;
+  uint16_t line;
+  char text[SCRIPT_LINE_MAX];
+} Step_t;
+
+typedef enum {
+  IN_KEY = 0, // arg = 키, level = 눌림
+  IN_ADC,     // arg = 채널, value = 원시값
+  IN_PIN,     // arg = 포트, value = 핀 번호, level = 레벨
+} Input_Kind_t;
+
+typedef struct {
+  uint32_t at;
+  uint8_t kind;
+  char arg;
+  uint8_t level;
+  uint16_t value;
+} Input_t;
+
+static Step_t *steps = NULL;
+static uint32_t step_count = 0;
+static uint32_t step_next = 0;
+static uint32_t end_ms = 0; // 0 = 'end' 없음
+static uint32_t failures = 0;
+static uint32_t expects = 0;
+
+static Input_t inputs[INPUT_QUEUE_SIZE];
+static uint32_t input_head = 0, input_tail = 0;
+static uint32_t input_free_at = 0; // 이어서 누를 수 있는 시각
+
+// 수위 램프 (level <pct> <ms>)
+static struct {
+  uint8_t active;
+  uint32_t t0, dur;
+  uint16_t from, to, now;
+} ramp;
+
+// ========== 입력 대기열 ==========
+static void input_push(uint32_t at, uint8_t kind, char arg, uint8_t level,
+                       uint16_t value) {
+  if (input_head - input_tail >= INPUT_QUEUE_SIZE) {
+    printf("[SIM] input queue full, dropped\n");
+    return;
+  }
+  Input_t *in = &inputs[input_head++ & (INPUT_QUEUE_SIZE - 1)];
+  in->at = at;
+  in->kind = kind;
+  in->arg = arg;
+  in->level = level;
+  in->value = value;
+}
+
+static uint32_t input_start(uint32_t now) {
+  return (input_free_at > now) ? input_free_at : now;
+}
+
+static void input_tap_key(uint32_t now, char key) {
+  uint32_t t = input_start(now);
+  input_push(t, IN_KEY, key, 1, 0);
+  input_push(t + KEY_HOLD_MS, IN_KEY, key, 0, 0);
+  input_free_at = t + 2 * KEY_HOLD_MS;
+}
+
+static void input_joy(uint32_t now, uint8_t ch, uint16_t value) {
+  uint32_t t = input_start(now);
+  input_push(t, IN_ADC, (char)ch, 0, value);
+  input_push(t + JOY_HOLD_MS, IN_ADC, (char)ch, 0, 2048);
+  input_free_at = t + 2 * JOY_HOLD_MS;
+}
+
+static void input_click(uint32_t now) {
+  uint32_t t = input_start(now);
+  input_push(t, IN_PIN, 'B', 0, 0); // JOW_SW = PB0, LOW = 눌림
+  input_push(t + KEY_HOLD_MS, IN_PIN, 'B', 1, 0);
+  input_free_at = t + 2 * KEY_HOLD_MS;
+}
+
+static void input_tick(uint32_t now) {
+  while (input_tail != input_head) {
+    Input_t *in = &inputs[input_tail & (INPUT_QUEUE_SIZE - 1)];
+    if ((int32_t)(now - in->at) < 0)
+      break;
+    switch (in->kind) {
+    case IN_KEY:
+      Sim_KeySet(in->arg, in->level);
+      break;
+    case IN_ADC:
+      Sim_SetAdc((uint8_t)in->arg, in->value);
+      break;
+    case IN_PIN:
+      Sim_SetPin(in->arg, (uint8_t)in->value, in->level);
+      break;
+    }
+    input_tail++;
+  }
+}
+
+static uint16_t pct_to_raw(uint32_t pct) {
+  return (uint16_t)(((pct > 100 ? 100 : pct) * 4095u + 50u) / 100u);
+}
+
+static void ramp_tick(uint32_t now) {
+  if (!ramp.active)
+    return;
+  uint32_t t = now - ramp.t0;
+  if (t >= ramp.dur) {
+    ramp.now = ramp.to;
+    ramp.active = 0;
+  } else {
+    ramp.now = (uint16_t)((int32_t)ramp.from +
+                          ((int32_t)ramp.to - (int32_t)ramp.from) *
+                              (int32_t)t / (int32_t)ramp.dur);
+  }
+  Sim_SetAdc(ADC_CH_LEVEL, ramp.now);
+}
+
+// ========== 명령 ==========
+// "\r" "\n" "\t" "\\" "\xHH" 를 바이트로
+static uint16_t unescape(const char *src, uint8_t *out, uint16_t max) {
+  uint16_t n = 0;
+  while (*src && n < max) {
+    char c = *src++;
+    if (c == '\\' && *src == 'x' && isxdigit((unsigned char)src[1]) &&
+        isxdigit((unsigned char)src[2])) {
+      char hex[3] = {src[1], src[2], '\0'};
+      c = (char)strtoul(hex, NULL, 16);
+      src += 3;
+    } else if (c == '\\' && *src) {
+      char e = *src++;
+      c = (e == 'r') ? '\r' : (e == 'n') ? '\n' : (e == 't') ? '\t' : e;
+    }
+    out[n++] = (uint8_t)c;
+  }
+  return n;
+}
+
+// "01 03 00 00 00 02" → 바이트 + CRC (Modbus RTU 프레임). 형식이 틀리면 0
+static uint16_t mb_frame(const char *src, uint8_t *out, uint16_t max) {
+  uint16_t n = 0;
+  char *end;
+  while (n + 2 < max) {
+    unsigned long v = strtoul(src, &end, 16);
+    if (end == src)
+      break;
+    if (v > 0xFF)
+      return 0;
+    out[n++] = (uint8_t)v;
+    src = end;
+  }
+  while (isspace((unsigned char)*src))
+    src++;
+  if (n == 0 || *src != '\0')
+    return 0;
+  uint16_t crc = CRC16_ModbusUpdate(CRC16_MODBUS_INIT, out, n);
+  out[n++] = (uint8_t)crc;
+  out[n++] = (uint8_t)(crc >> 8);
+  return n;
+}
+
+static void rtrim(char *s) {
+  size_t n = strlen(s);
+  while (n > 0 && isspace((unsigned char)s[n - 1]))
+    s[--n] = '\0';
+}
+
+static void fail(uint16_t line, const char *what, const char *want,
+                 const char *got) {
+  failures++;
+  printf("[SIM] %lu ms, line %u: expect %s \"%s\", got \"%s\"\n",
+         (unsigned long)Sim_NowMs(), line, what, want, got);
+}
+
+static void print_lcd(void) {
+  printf("[LCD] +----------------+\n");
+  for (uint8_t r = 0; r < SIM_LCD_ROWS; r++)
+    printf("[LCD] |%s|\n", Sim_LcdLine(r));
+  printf("[LCD] +----------------+\n");
+}
+
+static int cmd_expect(uint16_t line, char *args) {
+  char what[16];
+  int used = 0;
+  if (sscanf(args, "%15s %n", what, &used) != 1)
+    return -1;
+  char *rest = args + used;
+  expects++;
+
+  if (strcmp(what, "lcd") == 0) {
+    unsigned row;
+    if (sscanf(rest, "%u %n", &row, &used) != 1 || row >= SIM_LCD_ROWS)
+      return -1;
+    char want[SIM_LCD_COLS + 1];
+    char got[SIM_LCD_COLS + 1];
+    snprintf(want, sizeof(want), "%s", rest + used);
+    snprintf(got, sizeof(got), "%s", Sim_LcdLine((uint8_t)row));
+    rtrim(want);
+    rtrim(got);
+    if (strcmp(want, got) != 0)
+      fail(line, "lcd", want, got);
+    return 0;
+  }
+
+  if (strcmp(what, "gate") == 0) {
+    unsigned gate;
+    char state[16];
+    if (sscanf(rest, "%u %15s", &gate, state) != 2 || gate < 1 || gate > 2)
+      return -1;
+    uint32_t ccr = (gate == 1) ? TIM3->CCR1 : TIM3->CCR2;
+    unsigned angle = (ccr >= 1000) ? (unsigned)((ccr - 1000) * 90 / 1000) : 0;
+    unsigned want = (strcmp(state, "open") == 0)     ? 90
+                    : (strcmp(state, "closed") == 0) ? 0
+                                                     : (unsigned)atoi(state);
+    if (angle != want) {
+      char w[8], g[8];
+      snprintf(w, sizeof(w), "%u", want);
+      snprintf(g, sizeof(g), "%u", angle);
+      fail(line, "gate angle", w, g);
+    }
+    return 0;
+  }
+
+  if (strcmp(what, "uart") == 0) {
+    // 마지막으로 맞춘 곳 이후에 나왔는지 (맞으면 거기까지 소비)
+    uint8_t want[SCRIPT_LINE_MAX];
+    uint16_t n = unescape(rest, want, sizeof(want) - 1);
+    want[n] = '\0';
+    const char *text = Sim_UartTxText();
+    const char *hit = strstr(text, (const char *)want);
+    if (hit == NULL)
+      fail(line, "uart", (const char *)want, "(not seen)");
+    else
+      Sim_UartTxMark((uint32_t)(hit - text) + n);
+    return 0;
+  }
+
+  if (strcmp(what, "mb") == 0) {
+    // 응답 프레임 (CRC 는 자동). 출력 기록은 0x00 을 ' ' 로 바꿔 두므로 맞춤
+    uint8_t want[SCRIPT_LINE_MAX];
+    uint16_t n = mb_frame(rest, want, sizeof(want) - 1);
+    if (n == 0)
+      return -1;
+    for (uint16_t i = 0; i < n; i++) {
+      if (want[i] == 0)
+        want[i] = ' ';
+    }
+    want[n] = '\0';
+    const char *text = Sim_UartTxText();
+    const char *hit = strstr(text, (const char *)want);
+    if (hit == NULL)
+      fail(line, "mb", rest, "(not seen)");
+    else
+      Sim_UartTxMark((uint32_t)(hit - text) + n);
+    return 0;
+  }
+  return -1;
+}
+
+static int exec(uint16_t line, char *text, uint32_t now) {
+  char cmd[16];
+  int used = 0;
+  if (sscanf(text, "%15s %n", cmd, &used) != 1)
+    return 0; // 빈 줄
+  char *args = text + used;
+  unsigned a, b;
+
+  if (strcmp(cmd, "level") == 0) {
+    a = 0;
+    b = 0;
+    if (sscanf(args, "%u %u", &a, &b) < 1)
+      return -1;
+    ramp.from = ramp.now;
+    ramp.to = pct_to_raw(a);
+    ramp.t0 = now;
+    ramp.dur = b;
+    ramp.active = 1;
+    ramp_tick(now);
+  } else if (strcmp(cmd, "adc") == 0) {
+    if (sscanf(args, "%u %u", &a, &b) != 2 || a >= ADC_NUM_CH)
+      return -1;
+    Sim_SetAdc((uint8_t)a, (uint16_t)b);
+  } else if (strcmp(cmd, "key") == 0) {
+    rtrim(args);
+    for (const char *k = args; *k; k++) {
+      if (!isspace((unsigned char)*k))
+        input_tap_key(now, *k);
+    }
+  } else if (strcmp(cmd, "joy") == 0) {
+    rtrim(args);
+    if (strcmp(args, "up") == 0)
+      input_joy(now, ADC_CH_JOY_Y, 0);
+    else if (strcmp(args, "down") == 0)
+      input_joy(now, ADC_CH_JOY_Y, 4095);
+    else if (strcmp(args, "left") == 0)
+      input_joy(now, ADC_CH_JOY_X, 0);
+    else if (strcmp(args, "right") == 0)
+      input_joy(now, ADC_CH_JOY_X, 4095);
+    else
+      return -1;
+  } else if (strcmp(cmd, "click") == 0) {
+    input_click(now);
+  } else if (strcmp(cmd, "pin") == 0) {
+    char port;
+    if (sscanf(args, " %c%u %u", &port, &a, &b) != 3)
+      return -1;
+    Sim_SetPin((char)toupper((unsigned char)port), (uint8_t)a, (uint8_t)b);
+  } else if (strcmp(cmd, "uart") == 0) {
+    uint8_t buf[SCRIPT_LINE_MAX];
+    Sim_UartInject(buf, unescape(args, buf, sizeof(buf)));
+  } else if (strcmp(cmd, "mb") == 0) {
+    uint8_t buf[SCRIPT_LINE_MAX];
+    uint16_t n = mb_frame(args, buf, sizeof(buf));
+    if (n == 0)
+      return -1;
+    Sim_UartInject(buf, n);
+  } else if (strcmp(cmd, "dht") == 0) {
+    if (strncmp(args, "off", 3) == 0)
+      Sim_SetDht(0, 0, 0);
+    else if (sscanf(args, "%u %u", &a, &b) == 2)
+      Sim_SetDht(1, (uint8_t)a, (uint8_t)b);
+    else
+      return -1;
+  } else if (strcmp(cmd, "expect") == 0) {
+    return cmd_expect(line, args);
+  } else if (strcmp(cmd, "print") == 0) {
+    print_lcd();
+  } else if (strcmp(cmd, "end") == 0) {
+    // Sim_ScriptEnd 에서 처리
+  } else {
+    return -1;
+  }
+  return 0;
+}
+
+// ========== 불러오기 / 진행 ==========
+static int parse_time(const char *tok, uint32_t prev, uint32_t *out) {
+  uint8_t rel = (*tok == '+');
+  char *end;
+  unsigned long v = strtoul(tok + rel, &end, 10);
+  if (end == tok + rel)
+    return -1;
+  if (strncmp(end, "ms", 2) == 0) {
+    end += 2;
+  } else if (*end == 's') {
+    v *= 1000u;
+    end++;
+  } else if (*end == 'h') {
+    v *= 3600000u;
+    end++;
+  }
+  if (*end != '\0')
+    return -1;
+  *out = rel ? prev + (uint32_t)v : (uint32_t)v;
+  return 0;
+}
+
+int Sim_ScriptLoad(const char *path) {
+  FILE *f = fopen(path, "r");
+  if (f == NULL) {
+    perror(path);
+    return -1;
+  }
+
+  char buf[SCRIPT_LINE_MAX];
+  uint32_t prev = 0;
+  uint16_t line = 0;
+  int err = 0;
+
+  while (fgets(buf, sizeof(buf), f) != NULL) {
+    line++;
+    // 'key 1234#' 처럼 인자 안의 '#' 은 남김: 줄 맨 앞의 '#' 만 주석
+    char *p = buf;
+    while (isspace((unsigned char)*p))
+      p++;
+    if (*p == '#' || *p == '\0')
+      continue;
+    rtrim(p);
+
+    char tok[24];
+    int used = 0;
+    uint32_t at;
+    if (sscanf(p, "%23s %n", tok, &used) != 1 ||
+        parse_time(tok, prev, &at) != 0 || at < prev) {
+      fprintf(stderr, "%s:%u: bad time '%s'\n", path, line, p);
+      err = -1;
+      continue;
+    }
+    prev = at;
+
+    Step_t *grown = realloc(steps, (step_count + 1) * sizeof(Step_t));
+    if (grown == NULL) {
+      err = -1;
+      break;
+    }
+    steps = grown;
+    Step_t *st = &steps[step_count++];
+    st->at = at;
+    st->line = line;
+    snprintf(st->text, sizeof(st->text), "%s", p + used);
+
+    if (strncmp(st->text, "end", 3) == 0 && end_ms == 0)
+      end_ms = at;
+  }
+  fclose(f);
+  return err;
+}
+
+uint32_t Sim_ScriptEnd(void) { return end_ms; }
+
+// 한 줄 바로 실행 (대화형 모드의 '!' 줄)
+int Sim_ScriptExec(const char *text) {
+  char buf[SCRIPT_LINE_MAX];
+  snprintf(buf, sizeof(buf), "%s", text);
+  rtrim(buf);
+  int r = exec(0, buf, Sim_NowMs());
+  if (r != 0)
+    printf("[SIM] bad command: %s\n", buf);
+  return r;
+}
+
+void Sim_ScriptTick(uint32_t now) {
+  while (step_next < step_count && steps[step_next].at <= now) {
+    Step_t *st = &steps[step_next++];
+    if (exec(st->line, st->text, now) != 0) {
+      failures++;
+      printf("[SIM] line %u: bad command: %s\n", st->line, st->text);
+    }
+  }
+  ramp_tick(now);
+  input_tick(now);
+}
+
+uint32_t Sim_ScriptFailures(void) { return failures; }
+uint32_t Sim_ScriptExpects(void) { return expects; }
@@ -0,0 +1,49 @@
+#ifndef SIM_TEST_H_
+#define SIM_TEST_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+// ========== 호스트 단위 테스트 (build/sim_tests) ==========
+// 펌웨어 모듈을 가상 HAL 과 함께 링크해서 직접 호출 (sim_main.c 대신)
+// CHECK 실패는 세고 계속 진행, 끝에 하나라도 있으면 종료 코드 1
+// 측정값은 "  [bench] ..." 줄로 (-b 면 반복을 늘림)
+
+extern uint32_t test_checks;
+extern uint32_t test_failures;
+extern uint8_t test_bench;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    test_checks++;                                                             \
+    if (!(cond)) {                                                             \
+      test_failures++;                                                         \
+      printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                 \
+    }                                                                          \
+  } while (0)
+
+#define CHECK_EQ(a, b)                                                         \
+  do {                                                                         \
+    long long a_ = (long long)(a), b_ = (long long)(b);                        \
+    test_checks++;                                                             \
+    if (a_ != b_) {                                                            \
+      test_failures++;                                                         \
+      printf("  FAIL %s:%d: %s == %s (%lld != %lld)\n", __FILE__, __LINE__,    \
+             #a, #b, a_, b_);                                                  \
+    }                                                                          \
+  } while (0)
+
+// 벽시계 (ns, 처리량 측정용)
+uint64_t Test_NowNs(void);
+
+// 테스트 파일마다 하나씩 (test_main.c 의 표에 등록)
+void Test_WaterLog(void);
+void Test_WaterLogFlash(void);
+void Test_SampleStore(void);
+void Test_Classifier(void);
+void Test_Filter(void);
+void Test_Lcd(void);
+void Test_Modbus(void);
+void Test_Scheduler(void);
+
+#endif
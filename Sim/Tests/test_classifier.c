@@ -0,0 +1,86 @@
+#include "sim_test.h"
+#include "water_classifier.h"
+#include <stdio.h>
+
+// ========== 수위 판정: 잡음 트레이스 재생, 상태 전환 수 비교 ==========
+// 12ms 프레임 (수위 필터 출력 주기), 기본 임계값 10 / 40%, 잡음 ±2%
+// 실제 변화는 3번 (OK → HIGH → OK → LOW), 나머지는 임계값 근처 떨림
+
+#define FRAME_MS 12u
+#define TH_LOW 10u
+#define TH_HIGH 40u
+#define NOISE 2
+
+typedef struct {
+  uint32_t until_s; // 이 구간 끝 (초)
+  uint8_t center;   // 중심 수위 %
+} Segment_t;
+
+static const Segment_t trace[] = {
+    {300, 40},  // HIGH 임계값 위아래로 떨림 → OK 유지
+    {360, 60},  // 실제 상승 → HIGH
+    {660, 38},  // 히스테리시스 안에서 떨림 → HIGH 유지
+    {720, 20},  // 실제 하강 → OK
+    {1020, 10}, // LOW 임계값 위아래로 떨림 → OK 유지
+    {1080, 3},  // 실제 하강 → LOW
+};
+
+#define EXPECTED_CHANGES 3u
+
+static uint32_t rng = 777u;
+static int32_t noise(void) {
+  rng = rng * 1103515245u + 12345u;
+  return (int32_t)((rng >> 16) % (2 * NOISE + 1)) - NOISE;
+}
+
+// 분류기 없이 임계값만 비교 (이전 코드)
+static WaterState_t bare(uint8_t level) {
+  if (level < TH_LOW)
+    return WATER_ST_LOW;
+  if (level > TH_HIGH)
+    return WATER_ST_HIGH;
+  return WATER_ST_OK;
+}
+
+void Test_Classifier(void) {
+  WaterClassifier_t cls;
+  WaterCls_Init(&cls, WATER_CLS_DEFAULT_HYST, WATER_CLS_DEFAULT_DWELL_MS);
+
+  WaterState_t bare_st = WATER_ST_OK, cls_st = WATER_ST_OK;
+  uint32_t bare_changes = 0, cls_changes = 0;
+  WaterState_t seen[EXPECTED_CHANGES + 1];
+  uint32_t now = 0;
+
+  for (uint32_t s = 0; s < sizeof(trace) / sizeof(trace[0]); s++) {
+    for (; now < trace[s].until_s * 1000u; now += FRAME_MS) {
+      int32_t lv = (int32_t)trace[s].center + noise();
+      uint8_t level = (uint8_t)((lv < 0) ? 0 : lv);
+
+      WaterState_t b = bare(level);
+      if (b != bare_st) {
+        bare_changes++;
+        bare_st = b;
+      }
+      WaterState_t c = WaterCls_Update(&cls, level, TH_LOW, TH_HIGH, now);
+      if (c != cls_st) {
+        if (cls_changes < EXPECTED_CHANGES)
+          seen[cls_changes] = c;
+        cls_changes++;
+        cls_st = c;
+      }
+    }
+  }
+
+  printf("  [bench] %lu frames: %lu transitions bare, %lu with classifier "
+         "(%lu candidates rejected)\n",
+         (unsigned long)(now / FRAME_MS), (unsigned long)bare_changes,
+         (unsigned long)cls_changes, (unsigned long)cls.rejected);
+  CHECK_EQ(cls_changes, EXPECTED_CHANGES);
+  CHECK_EQ(cls.changes, EXPECTED_CHANGES);
+  CHECK(bare_changes > 1000);
+  if (cls_changes == EXPECTED_CHANGES) {
+    CHECK_EQ(seen[0], WATER_ST_HIGH);
+    CHECK_EQ(seen[1], WATER_ST_OK);
+    CHECK_EQ(seen[2], WATER_ST_LOW);
+  }
+}
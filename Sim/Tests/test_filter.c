@@ -0,0 +1,70 @@
+#include "prof.h"
+#include "sim.h"
+#include "sim_test.h"
+#include "water_level_filter.h"
+#include <stdio.h>
+
+// ========== 수위 필터 단계별 샘플당 사이클 (PROF 구간) ==========
+// ap.c 와 같은 체인: median 5 → IIR 1/8 → 이동평균 8
+// DWT 를 호스트 시계 (84MHz 환산) 로 바꿔 구간마다 잼 → 호스트 기준 참고값,
+// 타깃 실제 값은 콘솔 perf 의 같은 구간 (WLF_PROF_STAGES=1 로 빌드했을 때)
+
+#if PROF_ENABLE
+static const uint8_t zones[] = {PROF_Z_WLF_MEDIAN, PROF_Z_WLF_IIR,
+                                PROF_Z_WLF_MOVAVG};
+#endif
+
+static uint32_t rng = 777u;
+static uint16_t adc_sample(uint32_t i) {
+  rng = rng * 1103515245u + 12345u;
+  uint16_t v = (uint16_t)(32768u + (i / 64u) % 4096u); // 느린 추세
+  if ((rng >> 16) % 50u == 0)
+    return (uint16_t)(v + 6000u); // 가끔 튀는 값 (median 이 잡음)
+  return (uint16_t)(v + (rng >> 24));
+}
+
+void Test_Filter(void) {
+  uint32_t n = test_bench ? 2000000u : 200000u;
+  WaterLevelFilter_t f;
+
+  WLF_Init(&f);
+  CHECK(WLF_AddStage(&f, WLF_STAGE_MEDIAN, 5));
+  CHECK(WLF_AddStage(&f, WLF_STAGE_IIR, 3));
+  CHECK(WLF_AddStage(&f, WLF_STAGE_MOVAVG, 8));
+
+#if PROF_ENABLE
+  Prof_Init(); // 구간 이름
+  Sim_DwtHostClock(1);
+
+  // 빈 구간 (시계 두 번 읽기) 비용 → 단계 값에서 뺌
+  uint64_t empty = 0;
+  for (uint32_t i = 0; i < 1000u; i++) {
+    uint32_t a = PROF_NOW();
+    empty += PROF_NOW() - a;
+  }
+  double overhead = (double)empty / 1000.0;
+#endif
+
+  uint32_t sink = 0;
+  for (uint32_t i = 0; i < n; i++)
+    sink += WLF_Process(&f, adc_sample(i));
+  CHECK(sink != 0);
+
+#if PROF_ENABLE // 측정 없는 빌드는 필터 동작만 확인
+  Sim_DwtHostClock(0);
+
+  for (uint8_t z = 0; z < sizeof(zones); z++) {
+    const Prof_Stats_t *s = Prof_Get(zones[z]);
+    CHECK_EQ(s->count, n);
+    if (s->count == 0)
+      continue;
+    double mean = (double)s->sum / s->count - overhead;
+    if (mean < 0)
+      mean = 0;
+    printf("  [bench] %-7s %5.1f cycles/sample (%.0f ns host, 84MHz-equiv)\n",
+           s->name, mean, mean * 1000.0 / Prof_TicksPerUs());
+  }
+  printf("  [bench] clock read overhead %.1f cycles (subtracted)\n", overhead);
+  Prof_Reset();
+#endif
+}
@@ -0,0 +1,99 @@
+#include "i2c-lcd.h"
+#include "sim.h"
+#include "sim_test.h"
+#include <string.h>
+
+// ========== LCD_Flush: 프레임마다 I2C 바이트 수 ==========
+// sim_lcd.c 가 받은 PCF8574 바이트를 그대로 비교 (주소 바이트 제외)
+// 글자/명령 1개 = 니블 2개 x (EN=1, EN=0) = 4바이트
+
+#define BL LCD_BACKLIGHT
+
+static uint8_t got[256];
+
+// 큐가 빌 때까지 가상 시간 진행 → 이번 Flush 가 보낸 바이트 수
+static uint16_t flush(void) {
+  LCD_TxStats_t st;
+  LCD_Flush();
+  for (uint32_t ms = 0; ms < 100u; ms++) {
+    LCD_GetTxStats(&st);
+    if (st.depth == 0)
+      break;
+    __WFI();
+  }
+  LCD_GetTxStats(&st);
+  CHECK_EQ(st.depth, 0);
+  return Sim_LcdTrace(got, sizeof(got));
+}
+
+// i2c-lcd.c 의 LCD_PackByte 와 같은 인코딩 (독립적으로 다시 적음)
+static uint16_t pack(uint8_t *dst, uint8_t v, uint8_t rs) {
+  uint8_t hi = v & 0xF0, lo = (uint8_t)(v << 4);
+  dst[0] = hi | rs | En | BL;
+  dst[1] = hi | rs | BL;
+  dst[2] = lo | rs | En | BL;
+  dst[3] = lo | rs | BL;
+  return 4;
+}
+
+static void frame(const char *l0, const char *l1) {
+  LCD_PrintLine(0, l0);
+  LCD_PrintLine(1, l1);
+}
+
+void Test_Lcd(void) {
+  uint8_t want[64];
+  uint16_t n;
+
+  HAL_Init();
+  MX_I2C1_Init();
+  LCD_Init();
+  flush();
+
+  // 첫 프레임: 공백이 아닌 칸만 (Clear 직후 glass = 공백, 주소 0)
+  // 0행: 구간 3개 "Level" "42%" "OK", 첫 구간은 주소 0 이라 커서 생략
+  // 1행: 공백 한 칸은 이어 써서 구간 1개 (커서 + 13글자)
+  frame("Level  42%  OK", "T:24.0C H:45%");
+  CHECK_EQ(flush(), (2 * 4 + 10 * 4) + (4 + 13 * 4));
+  CHECK(strcmp(Sim_LcdLine(0), "Level  42%  OK  ") == 0);
+  CHECK(strcmp(Sim_LcdLine(1), "T:24.0C H:45%   ") == 0);
+
+  // 같은 프레임 다시 → 0바이트
+  uint32_t bytes = Sim_LcdBytes();
+  frame("Level  42%  OK", "T:24.0C H:45%");
+  CHECK_EQ(flush(), 0);
+  CHECK_EQ(Sim_LcdBytes(), bytes);
+
+  // 한 글자 → 커서 이동 + 글자 (8바이트) 그대로
+  frame("Level  43%  OK", "T:24.0C H:45%");
+  n = pack(want, LCD_SETDDRAM_ADDR | 0x08, 0);
+  n += pack(&want[n], '3', Rs);
+  CHECK_EQ(flush(), n);
+  CHECK(memcmp(got, want, n) == 0);
+  CHECK(strcmp(Sim_LcdLine(0), "Level  43%  OK  ") == 0);
+
+  // 바로 다음 칸 → DDRAM 주소가 이미 거기라 커서 명령 생략 (4바이트)
+  frame("Level  43!  OK", "T:24.0C H:45%");
+  n = pack(want, '!', Rs);
+  CHECK_EQ(flush(), n);
+  CHECK(memcmp(got, want, n) == 0);
+
+  // 한 칸 건너 두 글자 → 가운데 칸도 다시 써서 한 구간 (커서 1 + 3글자)
+  frame("Level  53?  OK", "T:24.0C H:45%");
+  n = pack(want, LCD_SETDDRAM_ADDR | 0x07, 0);
+  n += pack(&want[n], '5', Rs);
+  n += pack(&want[n], '3', Rs);
+  n += pack(&want[n], '?', Rs);
+  CHECK_EQ(flush(), n);
+  CHECK(memcmp(got, want, n) == 0);
+
+  // 멀리 떨어진 두 글자 → 구간 2개 (각각 커서 + 1글자)
+  frame("Level  53?  OK", "T:25.0C H:46%");
+  n = pack(want, LCD_SETDDRAM_ADDR | 0x43, 0);
+  n += pack(&want[n], '5', Rs);
+  n += pack(&want[n], LCD_SETDDRAM_ADDR | 0x4B, 0);
+  n += pack(&want[n], '6', Rs);
+  CHECK_EQ(flush(), n);
+  CHECK(memcmp(got, want, n) == 0);
+  CHECK(strcmp(Sim_LcdLine(1), "T:25.0C H:46%   ") == 0);
+}
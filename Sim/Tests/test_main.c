@@ -0,0 +1,69 @@
+#include "sim_test.h"
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// ========== 단위 테스트 진입점 ==========
+// usage: sim_tests [-b] [이름...]   (이름 없으면 전부)
+
+uint32_t test_checks = 0;
+uint32_t test_failures = 0;
+uint8_t test_bench = 0;
+
+typedef struct {
+  const char *name;
+  void (*fn)(void);
+} Test_t;
+
+static const Test_t tests[] = {
+    {"log", Test_WaterLog},
+    {"flash", Test_WaterLogFlash},
+    {"sstore", Test_SampleStore},
+    {"classifier", Test_Classifier},
+    {"filter", Test_Filter},
+    {"lcd", Test_Lcd},
+    {"modbus", Test_Modbus},
+    {"sched", Test_Scheduler},
+};
+
+#define TEST_COUNT (sizeof(tests) / sizeof(tests[0]))
+
+uint64_t Test_NowNs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint8_t selected(int argc, char **argv, const char *name) {
+  if (optind >= argc)
+    return 1;
+  for (int i = optind; i < argc; i++) {
+    if (strcmp(argv[i], name) == 0)
+      return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  int opt;
+  while ((opt = getopt(argc, argv, "b")) != -1) {
+    if (opt != 'b') {
+      fprintf(stderr, "usage: %s [-b] [name...]\n", argv[0]);
+      return 2;
+    }
+    test_bench = 1;
+  }
+
+  for (uint32_t i = 0; i < TEST_COUNT; i++) {
+    if (!selected(argc, argv, tests[i].name))
+      continue;
+    uint32_t before = test_failures;
+    printf("== %s\n", tests[i].name);
+    tests[i].fn();
+    printf("   %s\n", (test_failures == before) ? "ok" : "FAILED");
+  }
+
+  printf("[TEST] %lu checks, %lu failed: %s\n", (unsigned long)test_checks,
+         (unsigned long)test_failures, test_failures ? "FAIL" : "PASS");
+  return test_failures ? 1 : 0;
+}
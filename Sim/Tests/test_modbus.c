@@ -0,0 +1,180 @@
+#include "crc16.h"
+#include "gate_actuator.h"
+#include "modbus_map.h"
+#include "modbus_slave.h"
+#include "sim_test.h"
+#include "tim.h"
+#include <string.h>
+
+// ========== Modbus: 펌웨어 레지스터 표 (modbus_map.c) 그대로 ==========
+// 값은 ap.c 전역 변수, 게이트는 gate_actuator.c
+
+extern uint8_t dam_auto_mode;
+extern uint8_t threshold_high;
+extern uint8_t threshold_low;
+extern uint8_t water_level;
+
+static MB_Slave_t mb;
+
+static void reset(uint8_t auto_on) {
+  MB_MapInit(&mb);
+  Gate_Init();
+  threshold_low = 10;
+  threshold_high = 40;
+  dam_auto_mode = auto_on;
+}
+
+static uint16_t frame_crc(uint8_t *req, uint16_t n) {
+  uint16_t crc = CRC16_ModbusUpdate(CRC16_MODBUS_INIT, req, n);
+  req[n++] = (uint8_t)crc;
+  req[n++] = (uint8_t)(crc >> 8);
+  return n;
+}
+
+// FC16 (count 1 이면 FC06) → 예외 코드 (0 = 정상 응답)
+static uint8_t write(uint16_t start, const uint16_t *v, uint8_t count) {
+  uint8_t req[MB_ADU_MAX], resp[MB_ADU_MAX];
+  uint16_t n = 0;
+
+  req[n++] = MODBUS_SLAVE_ADDR;
+  req[n++] = (count == 1) ? 0x06 : 0x10;
+  req[n++] = (uint8_t)(start >> 8);
+  req[n++] = (uint8_t)start;
+  if (count > 1) {
+    req[n++] = 0;
+    req[n++] = count;
+    req[n++] = (uint8_t)(count * 2);
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    req[n++] = (uint8_t)(v[i] >> 8);
+    req[n++] = (uint8_t)v[i];
+  }
+  n = frame_crc(req, n);
+
+  uint16_t len = MB_Process(&mb, req, n, resp);
+  CHECK(len >= 5);
+  return (resp[1] & 0x80) ? resp[2] : MB_EX_NONE;
+}
+
+static uint16_t read_input(uint16_t addr) {
+  uint8_t req[8], resp[MB_ADU_MAX];
+  uint16_t n = 0;
+  req[n++] = MODBUS_SLAVE_ADDR;
+  req[n++] = 0x04;
+  req[n++] = (uint8_t)(addr >> 8);
+  req[n++] = (uint8_t)addr;
+  req[n++] = 0;
+  req[n++] = 1;
+  n = frame_crc(req, n);
+  CHECK_EQ(MB_Process(&mb, req, n, resp), 7);
+  return (uint16_t)((resp[3] << 8) | resp[4]);
+}
+
+static void check_untouched(void) {
+  CHECK_EQ(threshold_low, 10);
+  CHECK_EQ(threshold_high, 40);
+  CHECK_EQ(Gate_GetAngle(GATE_1), GATE_ANGLE_CLOSED);
+  CHECK_EQ(Gate_GetAngle(GATE_2), GATE_ANGLE_CLOSED);
+}
+
+// 1ms 틱마다 DMA 위치: 바뀌는 동안은 수신 중, MB_T35_TICKS 동안 그대로면 끝
+static void test_frame_timer(void) {
+  MB_FrameTimer_t t;
+  MB_TimerReset(&t, 100);
+  MB_TimerTick(&t, 100);
+  MB_TimerTick(&t, 100);
+  CHECK_EQ(t.frame_ready, 0); // 수신 없이 조용함 → 프레임 아님
+
+  MB_TimerTick(&t, 111); // 11바이트/ms
+  MB_TimerTick(&t, 116);
+  CHECK_EQ(t.frame_ready, 0);
+  MB_TimerTick(&t, 116);
+  CHECK_EQ(t.frame_ready, 0); // 1ms 무음은 문자 사이 틈일 수 있음
+  MB_TimerTick(&t, 116);
+  CHECK_EQ(t.frame_ready, 1);
+
+  // 다음 프레임 (DMA 버퍼 한 바퀴)
+  t.frame_ready = 0;
+  MB_TimerTick(&t, 3);
+  for (uint8_t i = 0; i < MB_T35_TICKS; i++)
+    MB_TimerTick(&t, 3);
+  CHECK_EQ(t.frame_ready, 1);
+}
+
+static void bench(void) {
+  uint8_t req[8] = {MODBUS_SLAVE_ADDR, 0x04, 0, 0, 0, MB_IN_COUNT};
+  uint8_t resp[MB_ADU_MAX];
+  uint16_t n = frame_crc(req, 6);
+  uint32_t iters = test_bench ? 2000000u : 200000u;
+  uint32_t sink = 0;
+
+  reset(0);
+  uint64_t t0 = Test_NowNs();
+  for (uint32_t i = 0; i < iters; i++)
+    sink += MB_Process(&mb, req, n, resp);
+  uint64_t t1 = Test_NowNs();
+  CHECK_EQ(sink, (uint32_t)iters * (5u + 2u * MB_IN_COUNT));
+  printf("  [bench] read %u input regs: %.0f ns/request (host, MB_Process)\n",
+         MB_IN_COUNT, (double)(t1 - t0) / iters);
+}
+
+void Test_Modbus(void) {
+  MX_TIM3_Init(); // 게이트 서보 CCR
+
+  // 읽기는 살아 있는 변수에서 바로
+  reset(0);
+  water_level = 37;
+  CHECK_EQ(read_input(MB_IN_LEVEL), 37);
+
+  // auto 켜진 채 임계값 + 게이트 → 게이트가 거부되면 임계값도 그대로
+  reset(1);
+  const uint16_t all[] = {5, 45, 1, 90};
+  CHECK_EQ(write(MB_HR_TH_LOW, all, 4), MB_EX_DEVICE_FAILURE);
+  check_untouched();
+  CHECK_EQ(dam_auto_mode, 1);
+
+  // FC06 도 같은 경로
+  const uint16_t open[] = {90};
+  CHECK_EQ(write(MB_HR_GATE1, open, 1), MB_EX_DEVICE_FAILURE);
+  check_untouched();
+
+  // 교차 조건 실패 (low >= high) → 게이트도 안 움직임
+  reset(0);
+  const uint16_t bad[] = {45, 40, 0, 90};
+  CHECK_EQ(write(MB_HR_TH_LOW, bad, 4), MB_EX_ILLEGAL_VALUE);
+  check_untouched();
+
+  // 같은 요청에서 auto 를 끄면 게이트 허용 (반영된 값으로 확인)
+  reset(1);
+  const uint16_t manual[] = {0, 90};
+  CHECK_EQ(write(MB_HR_AUTO, manual, 2), MB_EX_NONE);
+  CHECK_EQ(dam_auto_mode, 0);
+  CHECK_EQ(Gate_GetAngle(GATE_1), 90);
+  Gate_Stats_t st;
+  Gate_GetStats(GATE_1, &st);
+  CHECK_EQ(st.moves, 1);
+
+  // 게이트 마모 input 레지스터 = Refresh 시점 스냅샷
+  CHECK_EQ(read_input(MB_IN_GATE1_MOVES_LO), 0);
+  MB_MapRefresh();
+  CHECK_EQ(read_input(MB_IN_GATE1_MOVES_LO), 1);
+  CHECK_EQ(read_input(MB_IN_GATE1_MOVES_HI), 0);
+  CHECK_EQ(read_input(MB_IN_GATE2_MOVES_LO), 0);
+
+  // 반대로 auto 를 켜면서 게이트 → 거부, auto 도 그대로
+  reset(0);
+  const uint16_t back[] = {1, 90};
+  CHECK_EQ(write(MB_HR_AUTO, back, 2), MB_EX_DEVICE_FAILURE);
+  CHECK_EQ(dam_auto_mode, 0);
+  check_untouched();
+
+  // holding 5 = 0 → 응답 뒤 콘솔 복귀 요청 (한 번만)
+  reset(0);
+  const uint16_t console[] = {UART_PROTO_CONSOLE};
+  CHECK_EQ(write(MB_HR_PROTO, console, 1), MB_EX_NONE);
+  CHECK_EQ(MB_MapTakeExit(), 1);
+  CHECK_EQ(MB_MapTakeExit(), 0);
+
+  test_frame_timer();
+  bench();
+}
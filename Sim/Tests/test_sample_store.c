@@ -0,0 +1,175 @@
+#include "sample_store.h"
+#include "sim_test.h"
+#include <stdio.h>
+#include <string.h>
+
+// ========== 1초 샘플 압축 저장: 왕복 / 블록 경계 탐색 / 밀려난 뒤 / 압축률 ==========
+// 현실적인 트레이스: 수위는 느린 추세 + 가끔 1% 흔들림, 습도는 분 단위,
+// 온도는 몇 분마다 0.1도, 가끔 샘플 빠짐 (태스크 지연) 과 DHT 실패
+
+#define T0 1769594400u // 2026-01-28 10:00:00
+#define MAX_SAMPLES 200000u
+
+static SStore_t st;
+static uint32_t ref_t[MAX_SAMPLES];
+static HistSample_t ref_s[MAX_SAMPLES];
+static uint32_t ref_n;
+
+static uint32_t rng = 12345u;
+static uint32_t rnd(uint32_t n) {
+  rng = rng * 1103515245u + 12345u;
+  return (rng >> 16) % n;
+}
+
+static void make_trace(uint32_t n) {
+  uint32_t t = T0;
+  int32_t level_x100 = 3000; // 30.00%
+  int32_t slope = 1;         // 0.01%/s
+  HistSample_t s = {30, 45, 240};
+
+  for (ref_n = 0; ref_n < n; ref_n++) {
+    if (rnd(600) == 0)
+      slope = (int32_t)rnd(7) - 3; // 10분에 한 번쯤 추세 바뀜
+    level_x100 += slope;
+    if (level_x100 < 500 || level_x100 > 9500)
+      slope = -slope;
+    s.level = (uint8_t)(level_x100 / 100);
+    if (rnd(20) == 0)
+      s.level += (uint8_t)rnd(2); // ADC 잡음이 반올림 경계를 넘음
+
+    if (rnd(60) == 0)
+      s.humidity = (uint8_t)(40 + rnd(15));
+    if (rnd(200) == 0)
+      s.temp_x10 += (int16_t)rnd(3) - 1;
+    HistSample_t out = s;
+    if (rnd(2000) == 0)
+      out.humidity = HIST_ENV_INVALID;
+
+    t += (rnd(500) == 0) ? 2 + rnd(4) : 1; // 가끔 몇 초 빠짐
+    ref_t[ref_n] = t;
+    ref_s[ref_n] = out;
+  }
+}
+
+static uint8_t same(const HistSample_t *a, const HistSample_t *b) {
+  return a->level == b->level && a->humidity == b->humidity &&
+         a->temp_x10 == b->temp_x10;
+}
+
+// epoch 이하 마지막 참조 샘플 (없으면 -1)
+static int32_t ref_find(uint32_t epoch) {
+  int32_t lo = 0, hi = (int32_t)ref_n;
+  while (lo < hi) {
+    int32_t mid = lo + (hi - lo) / 2;
+    if (ref_t[mid] <= epoch)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo - 1;
+}
+
+static const SStore_Block_t *block(uint16_t logical) {
+  uint16_t oldest = (st.head + SSTORE_NUM_BLOCKS + 1 - st.count) %
+                    SSTORE_NUM_BLOCKS;
+  return &st.blk[(oldest + logical) % SSTORE_NUM_BLOCKS];
+}
+
+static void check_find(uint32_t epoch) {
+  uint32_t t;
+  HistSample_t s;
+  int32_t i = ref_find(epoch);
+  uint8_t found = SStore_Find(&st, epoch, &t, &s);
+
+  if (i < 0 || ref_t[i] < block(0)->t0) {
+    CHECK(!found); // 밀려난 구간 / 첫 샘플 이전
+    return;
+  }
+  CHECK(found);
+  CHECK_EQ(t, ref_t[i]);
+  CHECK(same(&s, &ref_s[i]));
+}
+
+// 남아 있는 구간 전체를 처음부터 읽어 참조와 비교
+static void check_roundtrip(void) {
+  SStore_Iter_t it;
+  uint32_t t;
+  HistSample_t s;
+  int32_t i = ref_find(block(0)->t0);
+  uint32_t bad = 0;
+
+  CHECK(i >= 0);
+  SStore_IterBegin(&st, 0, &it);
+  while (SStore_IterNext(&it, &t, &s)) {
+    if (i >= (int32_t)ref_n || t != ref_t[i] || !same(&s, &ref_s[i]))
+      bad++;
+    i++;
+  }
+  CHECK_EQ(bad, 0);
+  CHECK_EQ(i, ref_n); // 마지막 (아직 플러시 안 된 연속 구간 포함) 까지
+}
+
+static void check_edges(void) {
+  for (uint16_t b = 0; b < st.count; b++) {
+    uint32_t t0 = block(b)->t0;
+    check_find(t0 - 1); // 앞 블록의 마지막 샘플 (첫 블록이면 없음)
+    check_find(t0);
+    check_find(t0 + 1);
+  }
+  check_find(ref_t[ref_n - 1]);
+  check_find(ref_t[ref_n - 1] + 100); // 마지막 이후 → 마지막
+  for (uint32_t i = 1; i < ref_n; i++) {
+    if (ref_t[i] - ref_t[i - 1] > 1) {
+      check_find(ref_t[i] - 1); // 빠진 초 → 직전 샘플
+      break;
+    }
+  }
+}
+
+static void fill(uint32_t n) {
+  SStore_Init(&st);
+  for (uint32_t i = 0; i < n; i++)
+    SStore_Append(&st, ref_t[i], &ref_s[i]);
+}
+
+void Test_SampleStore(void) {
+  uint32_t n = test_bench ? MAX_SAMPLES : 100000u;
+  make_trace(n);
+
+  // 밀려나기 전: 전부 남아 있음
+  ref_n = 2000;
+  fill(ref_n);
+  CHECK_EQ(st.evicted, 0);
+  check_roundtrip();
+  check_edges();
+
+  // 블록이 여러 번 밀려난 뒤
+  ref_n = n;
+  uint64_t t0 = Test_NowNs();
+  fill(ref_n);
+  uint64_t t1 = Test_NowNs();
+  CHECK(st.evicted > 0);
+  check_roundtrip();
+  check_edges();
+  check_find(block(0)->t0 - 1); // 밀려난 구간 → 없음
+
+  // 복호 시간: 남은 구간 전부 읽기
+  SStore_Iter_t it;
+  uint32_t t, kept = 0;
+  HistSample_t s;
+  uint64_t t2 = Test_NowNs();
+  SStore_IterBegin(&st, 0, &it);
+  while (SStore_IterNext(&it, &t, &s))
+    kept++;
+  uint64_t t3 = Test_NowNs();
+
+  uint32_t ratio = SStore_RatioX100(&st);
+  printf("  [bench] %lu samples kept (%lu s span) in %lu bytes, "
+         "ratio %lu.%02lux\n",
+         (unsigned long)kept, (unsigned long)(ref_t[ref_n - 1] - block(0)->t0),
+         (unsigned long)SStore_BytesUsed(&st), (unsigned long)(ratio / 100),
+         (unsigned long)(ratio % 100));
+  printf("  [bench] encode %.1f ns/sample, decode %.1f ns/sample (host)\n",
+         (double)(t1 - t0) / n, (double)(t3 - t2) / kept);
+  CHECK(ratio >= 1000); // 1초 8바이트 원본 대비 10배 이상 (이 트레이스 약 30배)
+}
@@ -0,0 +1,85 @@
+#include "scheduler.h"
+#include "sim.h"
+#include "sim_test.h"
+
+// ========== 스케줄러: 위상 격자 유지 / 한 주기 이상 늦은 슬롯만 overrun ==========
+// 태스크 안에서 __WFI() 로 가상 시간을 태워 실행 시간을 흉내 냄
+
+#define PERIOD 10u
+#define MAX_RUNS 16
+
+static uint32_t burn_ms[MAX_RUNS]; // n 번째 실행의 실행 시간
+static uint32_t starts[MAX_RUNS];
+static uint8_t runs;
+
+static void task(void) {
+  if (runs >= MAX_RUNS)
+    return;
+  starts[runs] = HAL_GetTick();
+  for (uint32_t i = 0; i < burn_ms[runs]; i++)
+    __WFI();
+  runs++;
+}
+
+// t0 부터 until 까지 디스패치 → 태스크 번호
+static int8_t run(uint32_t until) {
+  Sched_Init();
+  runs = 0;
+  int8_t id = Sched_Add("t", task, PERIOD, 0, SCHED_PRIO_NORMAL);
+  uint32_t end = HAL_GetTick() + until;
+  while (!SCHED_EXPIRED(HAL_GetTick(), end))
+    Sched_Dispatch();
+  return id;
+}
+
+void Test_Scheduler(void) {
+  uint32_t t0;
+
+  // 1.5 주기 실행: 다음 슬롯은 0.5 주기 늦게라도 실행, 그 다음은 격자 위
+  for (uint8_t i = 0; i < MAX_RUNS; i++)
+    burn_ms[i] = 0;
+  burn_ms[0] = 15;
+  t0 = HAL_GetTick();
+  const Sched_Task_t *t = Sched_Get((uint8_t)run(45));
+  CHECK_EQ(starts[0] - t0, 0);
+  CHECK_EQ(starts[1] - t0, 15);
+  CHECK_EQ(starts[2] - t0, 20);
+  CHECK_EQ(starts[3] - t0, 30);
+  CHECK_EQ(t->overruns, 0);
+  CHECK_EQ(t->max_late_ms, 5);
+
+  // 2.5 주기 실행: 10 슬롯은 한 주기 늦음 → 건너뜀 (overrun 1),
+  // 20 슬롯은 5ms 늦게 실행, 이후 30, 40 (지금 + 주기로 다시 잡지 않음)
+  burn_ms[0] = 25;
+  t0 = HAL_GetTick();
+  t = Sched_Get((uint8_t)run(45));
+  CHECK_EQ(starts[1] - t0, 25);
+  CHECK_EQ(starts[2] - t0, 30);
+  CHECK_EQ(starts[3] - t0, 40);
+  CHECK_EQ(t->overruns, 1);
+  CHECK_EQ(runs, 4);
+
+  // 정확히 한 주기 늦은 슬롯도 overrun (10, 20 건너뜀 → 30)
+  burn_ms[0] = 30;
+  t0 = HAL_GetTick();
+  t = Sched_Get((uint8_t)run(45));
+  CHECK_EQ(starts[1] - t0, 30);
+  CHECK_EQ(t->overruns, 2);
+
+  // 꺼진 태스크는 실행 안 됨, 켜면 그 시각부터 주기 다시 시작
+  burn_ms[0] = 0;
+  Sched_Init();
+  runs = 0;
+  int8_t id = Sched_Add("t", task, PERIOD, 0, SCHED_PRIO_NORMAL);
+  Sched_Enable(id, 0);
+  t0 = HAL_GetTick();
+  while (HAL_GetTick() - t0 < 3 * PERIOD)
+    Sched_Dispatch();
+  CHECK_EQ(runs, 0);
+  Sched_Enable(id, 1);
+  while (HAL_GetTick() - t0 < 5 * PERIOD)
+    Sched_Dispatch();
+  CHECK_EQ(runs, 2);
+  CHECK_EQ(starts[0] - t0, 3 * PERIOD);
+  CHECK_EQ(Sched_Get((uint8_t)id)->overruns, 0);
+}
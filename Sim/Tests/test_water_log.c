@@ -0,0 +1,172 @@
+#include "sim_test.h"
+#include "water_state_logger.h"
+#include <string.h>
+
+// ========== 로그 조회: 이진 탐색 / 필터 이동 / 구간 집계 / 순서 끊김 ==========
+// 세 가지 로그: 시간 순, RTC 가 과거로 돌아간 로그, 256개가 한 바퀴 넘은 링
+// 이진 탐색 결과는 모든 시각에서 선형 탐색 결과와 같아야 함
+
+#define T0 1769594400u // 2026-01-28 10:00:00
+
+static WaterLog_t log_;
+
+static void update(uint32_t epoch, WaterState_t st, uint8_t level) {
+  RTC_TimeTypeDef t;
+  RTC_DateTypeDef d;
+  WaterLog_FromEpoch(epoch, &t, &d);
+  WaterLog_Update(&log_, st, level, &t, &d);
+}
+
+// start 에 시작, dur 초 뒤 OK 로 복귀 (dur 0 = 진행 중으로 둠)
+static void event(uint32_t start, uint32_t dur, WaterState_t st) {
+  update(start, st, (st == WATER_ST_LOW) ? 5 : 60);
+  if (dur > 0)
+    update(start + dur, WATER_ST_OK, 25);
+}
+
+static uint32_t start_of(uint16_t v) {
+  WaterEvent_t ev;
+  WaterLog_GetByViewIndex(&log_, v, &ev);
+  return ev.start_epoch;
+}
+
+static uint16_t first_linear(uint32_t epoch) {
+  for (uint16_t v = 0; v < WaterLog_Count(&log_); v++) {
+    if (start_of(v) >= epoch)
+      return v;
+  }
+  return WaterLog_Count(&log_);
+}
+
+// 레코드 시각과 그 ±1 초 모두에서 이진 탐색 = 선형 탐색
+static void check_find_all(void) {
+  uint16_t n = WaterLog_Count(&log_);
+  uint16_t bad = 0;
+  for (uint16_t v = 0; v < n; v++) {
+    uint32_t s = start_of(v);
+    for (uint32_t e = s - 1; e <= s + 1; e++) {
+      if (WaterLog_FindFirstAtOrAfter(&log_, e) != first_linear(e))
+        bad++;
+    }
+  }
+  CHECK_EQ(bad, 0);
+  CHECK_EQ(WaterLog_FindFirstAtOrAfter(&log_, 0), 0);
+  CHECK_EQ(WaterLog_FindFirstAtOrAfter(&log_, UINT32_MAX), n);
+}
+
+// 시간 순: 100초 간격, 30초씩, HIGH / LOW 번갈아 (짝수 view = HIGH)
+static void test_in_order(void) {
+  WaterLog_Init(&log_);
+  for (uint32_t i = 0; i < 10; i++)
+    event(T0 + 100 * i, 30, (i % 2) ? WATER_ST_LOW : WATER_ST_HIGH);
+  CHECK_EQ(WaterLog_Count(&log_), 10);
+  CHECK_EQ(log_.breaks, 0);
+
+  CHECK_EQ(WaterLog_FindFirstAtOrAfter(&log_, T0 + 300), 3);
+  CHECK_EQ(WaterLog_FindFirstAtOrAfter(&log_, T0 + 301), 4);
+  check_find_all();
+
+  // 필터 이동 (from 자신 포함)
+  CHECK_EQ(WaterLog_FindNext(&log_, 0, WATERLOG_F_LOW), 1);
+  CHECK_EQ(WaterLog_FindNext(&log_, 2, WATERLOG_F_HIGH), 2);
+  CHECK_EQ(WaterLog_FindNext(&log_, 9, WATERLOG_F_HIGH), WATERLOG_NONE);
+  CHECK_EQ(WaterLog_FindNext(&log_, 10, WATERLOG_F_ALL), WATERLOG_NONE);
+  CHECK_EQ(WaterLog_FindPrev(&log_, 9, WATERLOG_F_HIGH), 8);
+  CHECK_EQ(WaterLog_FindPrev(&log_, 500, WATERLOG_F_LOW), 9); // 끝에서부터
+  CHECK_EQ(WaterLog_FindPrev(&log_, 0, WATERLOG_F_LOW), WATERLOG_NONE);
+
+  // [115, 315): 100 (LOW) 은 앞이 잘림 15초, 200 (HIGH) 전부, 300 (LOW) 은
+  // 뒤가 잘림 15초
+  WaterLog_Agg_t agg;
+  WaterLog_Aggregate(&log_, T0 + 115, T0 + 315, T0 + 2000, &agg);
+  CHECK_EQ(agg.count[WATER_ST_LOW], 2);
+  CHECK_EQ(agg.seconds[WATER_ST_LOW], 15 + 15);
+  CHECK_EQ(agg.count[WATER_ST_HIGH], 1);
+  CHECK_EQ(agg.seconds[WATER_ST_HIGH], 30);
+  CHECK_EQ(agg.count[WATER_ST_OK], 0);
+
+  // 경계에 딱 맞는 끝/시작은 겹침 아님
+  WaterLog_Aggregate(&log_, T0 + 30, T0 + 100, T0 + 2000, &agg);
+  CHECK_EQ(agg.count[WATER_ST_LOW] + agg.count[WATER_ST_HIGH], 0);
+
+  // 진행 중 이벤트는 now 까지, 구간 끝에서 잘림
+  event(T0 + 1000, 0, WATER_ST_HIGH);
+  WaterLog_Aggregate(&log_, T0 + 990, T0 + 2000, T0 + 1050, &agg);
+  CHECK_EQ(agg.count[WATER_ST_HIGH], 1);
+  CHECK_EQ(agg.seconds[WATER_ST_HIGH], 50);
+  WaterLog_Aggregate(&log_, T0 + 990, T0 + 1020, T0 + 1050, &agg);
+  CHECK_EQ(agg.seconds[WATER_ST_HIGH], 20);
+}
+
+// RTC 가 과거로 돌아감: 0, 100, 200 다음에 50, 150 (끊김 1곳)
+static void test_rtc_step_back(void) {
+  WaterLog_Init(&log_);
+  event(T0 + 0, 30, WATER_ST_HIGH);
+  event(T0 + 100, 30, WATER_ST_LOW);
+  event(T0 + 200, 30, WATER_ST_HIGH);
+  event(T0 + 50, 30, WATER_ST_LOW);
+  event(T0 + 150, 30, WATER_ST_HIGH);
+  CHECK_EQ(log_.breaks, 1);
+
+  // 로그 순서로 처음 나오는 것 (이진 탐색이면 view 4 를 놓침)
+  CHECK_EQ(WaterLog_FindFirstAtOrAfter(&log_, T0 + 120), 2);
+  CHECK_EQ(WaterLog_FindFirstAtOrAfter(&log_, T0 + 201), 5);
+  check_find_all();
+
+  CHECK_EQ(WaterLog_FindNext(&log_, 2, WATERLOG_F_LOW), 3);
+  CHECK_EQ(WaterLog_FindPrev(&log_, 4, WATERLOG_F_LOW), 3);
+
+  // [40, 160): 50 (30초), 100 (30초), 150 (10초) — 200 뒤의 레코드도 봄
+  WaterLog_Agg_t agg;
+  WaterLog_Aggregate(&log_, T0 + 40, T0 + 160, T0 + 1000, &agg);
+  CHECK_EQ(agg.count[WATER_ST_LOW], 2);
+  CHECK_EQ(agg.seconds[WATER_ST_LOW], 60);
+  CHECK_EQ(agg.count[WATER_ST_HIGH], 1);
+  CHECK_EQ(agg.seconds[WATER_ST_HIGH], 10);
+}
+
+// 256개 링이 한 바퀴 넘음 (view 0 이 rec[0] 이 아님)
+static void test_wrapped(void) {
+  WaterLog_Init(&log_);
+  for (uint32_t i = 0; i < WATERLOG_MAX + 40; i++)
+    event(T0 + 60 * i, 20, (i % 3) ? WATER_ST_LOW : WATER_ST_HIGH);
+  CHECK_EQ(WaterLog_Count(&log_), WATERLOG_MAX);
+  CHECK_EQ(log_.breaks, 0);
+  CHECK_EQ(start_of(0), T0 + 60 * 40);
+  CHECK_EQ(WaterLog_FindFirstAtOrAfter(&log_, T0 + 60 * 40), 0);
+  CHECK_EQ(WaterLog_FindFirstAtOrAfter(&log_, T0 + 60 * 40 + 1), 1);
+  check_find_all();
+
+  // i = 42 (view 2) 부터 HIGH 는 3개마다
+  CHECK_EQ(WaterLog_FindNext(&log_, 0, WATERLOG_F_HIGH), 2);
+  CHECK_EQ(WaterLog_FindPrev(&log_, 1, WATERLOG_F_HIGH), WATERLOG_NONE);
+
+  // 이미 밀려난 시각은 집계에 안 나옴
+  WaterLog_Agg_t agg;
+  WaterLog_Aggregate(&log_, T0, T0 + 60 * 41, T0 + 60 * 300, &agg);
+  CHECK_EQ(agg.count[WATER_ST_LOW] + agg.count[WATER_ST_HIGH], 1);
+  CHECK_EQ(agg.seconds[WATER_ST_HIGH] + agg.seconds[WATER_ST_LOW], 20);
+
+  // 끊긴 쌍이 가장 오래된 자리에서 밀려나면 breaks 가 줄어듦
+  WaterLog_Init(&log_);
+  event(T0 + 1000, 20, WATER_ST_HIGH);
+  event(T0 + 500, 20, WATER_ST_LOW); // 끊김
+  for (uint32_t i = 0; i < WATERLOG_MAX - 2; i++)
+    event(T0 + 600 + 60 * i, 20, WATER_ST_HIGH);
+  CHECK_EQ(WaterLog_Count(&log_), WATERLOG_MAX);
+  CHECK_EQ(log_.breaks, 1);
+  check_find_all();
+
+  event(T0 + 600 + 60 * (WATERLOG_MAX - 2), 20, WATER_ST_HIGH); // 1000 밀려남
+  CHECK_EQ(log_.breaks, 0);
+  CHECK_EQ(start_of(0), T0 + 500);
+  event(T0 + 600 + 60 * (WATERLOG_MAX - 1), 20, WATER_ST_HIGH); // 500 밀려남
+  CHECK_EQ(log_.breaks, 0);
+  check_find_all();
+}
+
+void Test_WaterLog(void) {
+  test_in_order();
+  test_rtc_step_back();
+  test_wrapped();
+}
@@ -0,0 +1,263 @@
+#include "sim.h"
+#include "sim_test.h"
+#include "water_log_flash.h"
+#include "water_state_logger.h"
+#include <stdio.h>
+
+// ========== 이벤트 로그 플래시: 전원 차단 복원 / 탐색 비용 / 추가 처리량 ==========
+// 섹터 이미지는 파일 (Sim_FlashOpen) → 다시 열기 = 재부팅
+
+#define FLASH_FILE "build/test_flash.bin"
+#define T0 1769594400u // 2026-01-28 10:00:00
+#define EV_GAP 600u    // 이벤트 간격 (초)
+#define EV_DUR 120u    // 이벤트 길이 (초)
+#define EV_LEVEL 70u
+
+// STM32F411 워드 프로그램 16us (데이터시트 typ, x32) → 타깃 시간 추정
+#define TARGET_WORD_US 16u
+
+static WaterLog_t wl;
+static WLFlash_t fs;
+
+static void boot(void) {
+  Sim_FlashOpen(FLASH_FILE);
+  WaterLog_Init(&wl);
+  CHECK(WLFlash_Mount(&fs, &flash_if_stm32));
+  WaterLog_AttachStore(&wl, &fs);
+}
+
+static void fresh(void) {
+  remove(FLASH_FILE);
+  boot();
+}
+
+static void update(WaterState_t st, uint8_t level, uint32_t epoch) {
+  RTC_TimeTypeDef t;
+  RTC_DateTypeDef d;
+  WaterLog_FromEpoch(epoch, &t, &d);
+  WaterLog_Update(&wl, st, level, &t, &d);
+}
+
+// HIGH 로 들어가서 중간 샘플 하나, EV_DUR 뒤 OK 로 (추가 3번 + 종료 3번 program)
+static void event(uint32_t start) {
+  update(WATER_ST_HIGH, EV_LEVEL, start);
+  update(WATER_ST_HIGH, EV_LEVEL + 10, start + EV_DUR / 2);
+  update(WATER_ST_OK, 50, start + EV_DUR);
+}
+
+static void check_first(uint16_t n) {
+  WaterEvent_t ev;
+  for (uint16_t v = 0; v < n; v++) {
+    CHECK(WaterLog_GetByViewIndex(&wl, v, &ev));
+    CHECK_EQ(ev.start_epoch, T0 + v * EV_GAP);
+    CHECK(ev.ended);
+    CHECK_EQ(ev.duration_s, EV_DUR);
+  }
+}
+
+// ========== 전원 차단: 이벤트 하나의 program 단계마다 ==========
+// 단계: 1 start, 2 packed, 3 crc | 4 통계(2워드), 5 packed(지속 시간), 6 crc
+typedef struct {
+  uint8_t step;
+  uint8_t keep;       // 끊긴 program 에서 써진 워드 수
+  uint16_t count;     // 재부팅 후 레코드 수
+  uint8_t crc_errors; // 버린 슬롯
+  uint8_t repairs;    // 마저 쓴 종료 기록
+  uint8_t ongoing;    // 마지막 이벤트가 진행 중으로 복원
+  uint32_t dur;       // 마지막 이벤트 지속 시간 (종료된 경우)
+  uint8_t has_stats;
+} TornCase_t;
+
+#define N_BEFORE 5
+
+static const TornCase_t torn_cases[] = {
+    {1, 0, N_BEFORE, 0, 0, 0, EV_DUR, 1},     // 슬롯 안 씀
+    {2, 0, N_BEFORE, 1, 0, 0, EV_DUR, 1},     // start 만 → CRC 불일치
+    {3, 0, N_BEFORE, 1, 0, 0, EV_DUR, 1},     // CRC 없음
+    {4, 0, N_BEFORE + 1, 0, 0, 1, 0, 1},      // 종료 시작 전 → 진행 중
+    {4, 1, N_BEFORE + 1, 0, 1, 0, 0, 0},      // integral 만 → 지속 시간, 통계 모름
+    {5, 0, N_BEFORE + 1, 0, 1, 0, 0, 1},      // 통계만 → 지속 시간 모름
+    {6, 0, N_BEFORE + 1, 0, 1, 0, EV_DUR, 1}, // dur_crc 만 빠짐
+    {7, 0, N_BEFORE + 1, 0, 0, 0, EV_DUR, 1}, // 끊기지 않음
+};
+
+static void torn_case(const TornCase_t *c) {
+  fresh();
+  for (uint16_t i = 0; i < N_BEFORE; i++)
+    event(T0 + i * EV_GAP);
+
+  uint32_t start = T0 + N_BEFORE * EV_GAP;
+  Sim_FlashTear(c->step, c->keep);
+  event(start);
+  CHECK_EQ(Sim_FlashPoweredOff(), c->step <= 6);
+
+  boot();
+  CHECK_EQ(WaterLog_Count(&wl), c->count);
+  CHECK_EQ(fs.crc_errors, c->crc_errors);
+  CHECK_EQ(fs.repairs, c->repairs);
+  check_first(N_BEFORE);
+
+  WaterEvent_t ev;
+  if (c->count > N_BEFORE) {
+    CHECK(WaterLog_GetByViewIndex(&wl, N_BEFORE, &ev));
+    CHECK_EQ(ev.start_epoch, start);
+    CHECK_EQ(ev.ended, !c->ongoing);
+    CHECK_EQ(wl.live_state, c->ongoing ? WATER_ST_HIGH : WATER_ST_OK);
+    if (!c->ongoing) {
+      CHECK_EQ(ev.duration_s, c->dur);
+      CHECK_EQ(ev.has_stats, c->has_stats);
+      if (c->has_stats)
+        CHECK_EQ(ev.peak_percent, EV_LEVEL + 10);
+    }
+  }
+
+  // 복원 뒤에도 이어서 기록 (진행 중으로 복원된 이벤트는 여기서 끝남)
+  uint32_t next = start + EV_GAP;
+  update(WATER_ST_OK, 50, next - 1);
+  event(next);
+  uint16_t expect = c->count + 1;
+  boot();
+  CHECK_EQ(WaterLog_Count(&wl), expect);
+  CHECK(WaterLog_GetByViewIndex(&wl, expect - 1, &ev));
+  CHECK_EQ(ev.start_epoch, next);
+  CHECK(ev.ended);
+  CHECK_EQ(ev.duration_s, EV_DUR);
+  CHECK(ev.has_stats);
+  if (c->ongoing) {
+    // 재부팅 동안도 포함해 next - 1 에 끝남
+    CHECK(WaterLog_GetByViewIndex(&wl, N_BEFORE, &ev));
+    CHECK(ev.ended);
+    CHECK_EQ(ev.duration_s, EV_GAP - 1);
+  }
+}
+
+// ========== 섹터 전환: 미리 지우기 + 헤더 기록 중 전원 차단 ==========
+static void rollover(void) {
+  fresh();
+  uint32_t mark = WLFLASH_SPARE_MARK(&fs);
+  uint32_t i = 0;
+
+  while (fs.tail < mark)
+    event(T0 + (i++) * EV_GAP);
+  CHECK_EQ(WLFlash_Service(&fs), 1);
+  CHECK(fs.spare_ready);
+  CHECK_EQ(WLFlash_Service(&fs), 0); // 한 번만
+  uint32_t erases = fs.erases;
+
+  // 가득 찰 때까지 채운 뒤 전환: 헤더만 쓰고 지우지 않음
+  while (fs.tail < fs.slots_per_sector)
+    event(T0 + (i++) * EV_GAP);
+  event(T0 + (i++) * EV_GAP);
+  CHECK_EQ(fs.erases, erases);
+  CHECK_EQ(fs.tail, 1);
+  CHECK(fs.prev_valid);
+
+  boot();
+  CHECK_EQ(WLFlash_Count(&fs), fs.slots_per_sector + 1);
+  CHECK_EQ(WaterLog_Count(&wl), WATERLOG_MAX);
+  WaterEvent_t ev;
+  CHECK(WaterLog_GetByViewIndex(&wl, WATERLOG_MAX - 1, &ev));
+  CHECK_EQ(ev.start_epoch, T0 + (i - 1) * EV_GAP);
+
+  // 다음 전환의 헤더 기록에서 전원 차단 → 재부팅 후 동기 지우기로 다시
+  fresh();
+  i = 0;
+  while (fs.tail < fs.slots_per_sector)
+    event(T0 + (i++) * EV_GAP);
+  Sim_FlashTear(1, 0); // 미리 지우기 없음: 지우기 → 헤더(끊김)
+  event(T0 + (i++) * EV_GAP);
+  CHECK(Sim_FlashPoweredOff());
+
+  boot();
+  CHECK_EQ(fs.active, 0);
+  CHECK_EQ(fs.tail, fs.slots_per_sector);
+  event(T0 + (i++) * EV_GAP);
+  CHECK_EQ(fs.active, 1);
+  CHECK_EQ(fs.tail, 1);
+  boot();
+  CHECK(WaterLog_GetByViewIndex(&wl, WATERLOG_MAX - 1, &ev));
+  CHECK_EQ(ev.start_epoch, T0 + (i - 1) * EV_GAP);
+  CHECK(ev.ended);
+}
+
+// ========== RAM 통계 표 밖의 오래된 이벤트: 플래시 슬롯에서 읽음 ==========
+static void old_stats(void) {
+  uint16_t n = WATERLOG_STATS_MAX + 8;
+  WaterEvent_t ev;
+
+  fresh();
+  for (uint16_t i = 0; i < n; i++)
+    event(T0 + i * EV_GAP);
+  for (uint8_t pass = 0; pass < 2; pass++) { // 기록 직후, 재부팅 후
+    uint16_t with_stats = 0;
+    for (uint16_t v = 0; v < n; v++) {
+      CHECK(WaterLog_GetByViewIndex(&wl, v, &ev));
+      if (ev.has_stats && ev.peak_percent == EV_LEVEL + 10 &&
+          ev.trough_percent == EV_LEVEL && ev.integral > 0)
+        with_stats++;
+    }
+    CHECK_EQ(with_stats, n);
+    boot();
+  }
+
+  // 저장소 없이 RAM 만이면 오래된 것은 통계 없음
+  wl.store = NULL;
+  CHECK(WaterLog_GetByViewIndex(&wl, 0, &ev));
+  CHECK_EQ(ev.has_stats, 0);
+  CHECK(WaterLog_GetByViewIndex(&wl, n - 1, &ev));
+  CHECK_EQ(ev.has_stats, 1);
+}
+
+// ========== 부팅 비용 (tail 이진 탐색 + 복원) / 추가 처리량 ==========
+static void cost(void) {
+  uint32_t n = test_bench ? 6000u : 2000u;
+  Sim_FlashStats_t st;
+
+  fresh();
+  Sim_FlashResetStats();
+  uint64_t t0 = Test_NowNs();
+  for (uint32_t i = 0; i < n; i++)
+    event(T0 + i * EV_GAP);
+  uint64_t t1 = Test_NowNs();
+  Sim_FlashGetStats(&st);
+
+  double words = (double)st.program_words / n;
+  printf("  [bench] append+close: %.0f ns/event host, %.1f programs "
+         "%.1f words/event (~%.0f us on target)\n",
+         (double)(t1 - t0) / n, (double)st.programs / n, words,
+         words * TARGET_WORD_US);
+  CHECK_EQ(st.programs, n * 6u);
+
+  Sim_FlashOpen(FLASH_FILE);
+  Sim_FlashResetStats();
+  WaterLog_Init(&wl);
+  CHECK(WLFlash_Mount(&fs, &flash_if_stm32));
+  Sim_FlashGetStats(&st);
+  printf("  [bench] mount: %lu records, %lu slot probes, %lu reads "
+         "%lu bytes\n",
+         (unsigned long)WLFlash_Count(&fs), (unsigned long)fs.mount_reads,
+         (unsigned long)st.reads, (unsigned long)st.read_bytes);
+  CHECK(fs.mount_reads <= 14); // log2(6552) + 1, 섹터 하나만 유효
+
+  Sim_FlashResetStats();
+  WaterLog_AttachStore(&wl, &fs);
+  Sim_FlashGetStats(&st);
+  printf("  [bench] replay: %u records, %lu reads %lu bytes\n",
+         WaterLog_Count(&wl), (unsigned long)st.reads,
+         (unsigned long)st.read_bytes);
+  CHECK_EQ(st.reads, WATERLOG_MAX);
+}
+
+void Test_WaterLogFlash(void) {
+  for (uint32_t i = 0; i < sizeof(torn_cases) / sizeof(torn_cases[0]); i++) {
+    uint32_t before = test_failures;
+    torn_case(&torn_cases[i]);
+    if (test_failures != before)
+      printf("  (torn step %u keep %u)\n", torn_cases[i].step,
+             torn_cases[i].keep);
+  }
+  rollover();
+  old_stats();
+  cost();
+  Sim_FlashOpen(NULL);
+}
@@ -0,0 +1,225 @@
+// 텔레메트리 호스트 디코더 / 처리량 벤치마크
+//
+// 빌드 (저장소 루트에서):
+//   cc -O2 -IApp/Inc -o tlm_decode Tools/tlm_decode.c
+//      App/Src/telemetry.c App/Src/cobs.c App/Src/crc16.c  (한 줄로)
+//
+// 사용:
+//   tlm_decode [파일]        바이트 스트림 → CSV (stdout), 디버그 텍스트 → stderr
+//                            파일 생략 시 stdin (예: stty raw 한 /dev/ttyACM0)
+//   tlm_decode -b [baud] [n] 링크 처리량 + 인코딩/디코딩 속도 측정
+#include "telemetry.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CHUNK_MAX 512 // 구분자 사이 최대 길이 (그 이상은 텍스트)
+
+typedef struct {
+  unsigned long frames;
+  unsigned long bad; // CRC/길이 오류 (텍스트가 아닌 것)
+  unsigned long lost; // seq 틈
+  unsigned long text_bytes;
+  int have_seq;
+  uint16_t next_seq;
+} Stats_t;
+
+static const char *state_str(uint8_t s) {
+  return (s == 1) ? "LOW" : (s == 2) ? "HIGH" : "OK";
+}
+
+static int is_text(const uint8_t *p, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    if ((p[i] < 0x20 || p[i] > 0x7E) && p[i] != '\r' && p[i] != '\n' &&
+        p[i] != '\t')
+      return 0;
+  }
+  return 1;
+}
+
+static void print_frame(const Tlm_Frame_t *f) {
+  Tlm_Sample_t s;
+  Tlm_Event_t e;
+  Tlm_Status_t st;
+
+  if (Tlm_DecodeSample(f, &s)) {
+    printf("S,%u,%lu,%u,%u,%s,%.1f,", f->seq, (unsigned long)s.epoch, s.level,
+           s.level_hires, state_str(s.state), s.temp_x10 / 10.0);
+    if (s.humidity == 0xFF)
+      printf("\n");
+    else
+      printf("%u\n", s.humidity);
+  } else if (Tlm_DecodeEvent(f, &e)) {
+    printf("E,%u,%lu,%s,%u,%lu,%u,%u,%u,%lu,%u\n", f->seq,
+           (unsigned long)e.start, state_str(e.state), e.level,
+           (unsigned long)e.duration_s, e.peak, e.trough, e.mean,
+           (unsigned long)e.integral, e.ended);
+  } else if (Tlm_DecodeStatus(f, &st)) {
+    printf("T,%u,%lu,%lu,%lu,%u,%u,%u,%u,%u,%s\n", f->seq,
+           (unsigned long)st.uptime_ms, (unsigned long)st.uart_dropped,
+           (unsigned long)st.tlm_dropped, st.log_count, st.th_low, st.th_high,
+           st.auto_mode, st.gate_mask, state_str(st.state));
+  } else {
+    printf("?,%u,type=0x%02X,len=%u\n", f->seq, f->type, f->len);
+  }
+}
+
+static void handle_chunk(const uint8_t *p, size_t n, Stats_t *stats) {
+  Tlm_Frame_t f;
+
+  if (n == 0)
+    return;
+
+  if (n <= COBS_MAX_ENCODED(TLM_MAX_RAW) && Tlm_ParseFrame(p, (uint16_t)n, &f)) {
+    if (stats->have_seq && f.seq != stats->next_seq)
+      stats->lost += (uint16_t)(f.seq - stats->next_seq);
+    stats->have_seq = 1;
+    stats->next_seq = (uint16_t)(f.seq + 1);
+    stats->frames++;
+    print_frame(&f);
+  } else if (is_text(p, n)) {
+    // printf 디버그 출력은 그대로 통과
+    stats->text_bytes += n;
+    fwrite(p, 1, n, stderr);
+  } else {
+    stats->bad++;
+  }
+}
+
+static int decode(FILE *in) {
+  static uint8_t chunk[CHUNK_MAX];
+  size_t n = 0;
+  int c;
+  Stats_t stats = {0};
+
+  printf("# S,seq,epoch,level,level_hires,state,temp,humidity\n");
+  printf("# E,seq,start,state,level,duration_s,peak,trough,mean,integral,"
+         "ended\n");
+  printf("# T,seq,uptime_ms,uart_dropped,tlm_dropped,log_count,th_low,"
+         "th_high,auto,gate_mask,state\n");
+
+  while ((c = fgetc(in)) != EOF) {
+    if (c == 0x00) {
+      handle_chunk(chunk, n, &stats);
+      n = 0;
+    } else if (n < CHUNK_MAX) {
+      chunk[n++] = (uint8_t)c;
+    } else {
+      // 구분자 없이 긴 덩어리 = 텍스트 (프레임일 수 없음)
+      handle_chunk(chunk, n, &stats);
+      chunk[0] = (uint8_t)c;
+      n = 1;
+    }
+  }
+  handle_chunk(chunk, n, &stats);
+  fflush(stdout);
+
+  fprintf(stderr, "\n# frames %lu, bad %lu, lost %lu, text %lu bytes\n",
+          stats.frames, stats.bad, stats.lost, stats.text_bytes);
+  return 0;
+}
+
+// ========== 벤치마크 ==========
+static double now_s(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint8_t *bench_buf;
+static size_t bench_len;
+
+static uint16_t bench_room(void) { return 0xFFFF; }
+
+static uint16_t bench_write(const uint8_t *data, uint16_t len) {
+  memcpy(bench_buf + bench_len, data, len);
+  bench_len += len;
+  return len;
+}
+
+static const Tlm_Port_t bench_port = {bench_room, bench_write};
+
+static int bench(unsigned long baud, unsigned long count) {
+  Tlm_t t;
+  Tlm_Sample_t s = {1769558400u, 2048, 50, 0, 235, 40};
+  Tlm_Event_t e = {1769558400u, 60, 3000, 2, 45, 70, 40, 55, 1};
+  Tlm_Status_t st = {123456, 0, 0, 12, 10, 40, 1, 1, 0};
+  uint8_t frame[TLM_MAX_FRAME];
+
+  // 프레임 크기 (구분자 2바이트 포함)
+  Tlm_Init(&t, &bench_port);
+  bench_buf = frame;
+  bench_len = 0;
+  Tlm_SendSample(&t, &s);
+  size_t sample_len = bench_len;
+  bench_len = 0;
+  Tlm_SendEvent(&t, &e);
+  size_t event_len = bench_len;
+  bench_len = 0;
+  Tlm_SendStatus(&t, &st);
+  size_t status_len = bench_len;
+
+  double link = baud / 10.0; // 8N1
+  printf("link %lu baud = %.0f B/s\n", baud, link);
+  printf("frame bytes: sample %zu, event %zu, status %zu\n", sample_len,
+         event_len, status_len);
+
+  // 텍스트 디버그 출력이 차지하는 만큼 샘플 여유가 줄어듦
+  printf("\ntext B/s   max samples/s\n");
+  static const unsigned text_rates[] = {0, 100, 500, 1000, 2000, 5000, 10000};
+  for (size_t i = 0; i < sizeof(text_rates) / sizeof(text_rates[0]); i++) {
+    double left = link - text_rates[i];
+    printf("%8u   %8.0f\n", text_rates[i], left > 0 ? left / sample_len : 0.0);
+  }
+
+  // 호스트 인코딩/디코딩 속도
+  bench_buf = malloc(count * sample_len);
+  if (!bench_buf)
+    return 1;
+  bench_len = 0;
+  Tlm_Init(&t, &bench_port);
+
+  double t0 = now_s();
+  for (unsigned long i = 0; i < count; i++) {
+    s.epoch++;
+    s.level_hires = (uint16_t)(i * 37u);
+    Tlm_SendSample(&t, &s);
+  }
+  double t1 = now_s();
+
+  unsigned long ok = 0;
+  size_t start = 0;
+  Tlm_Frame_t f;
+  for (size_t i = 0; i < bench_len; i++) {
+    if (bench_buf[i] != 0x00)
+      continue;
+    if (i > start && Tlm_ParseFrame(&bench_buf[start], (uint16_t)(i - start), &f))
+      ok++;
+    start = i + 1;
+  }
+  double t2 = now_s();
+
+  printf("\nhost: encode %.0f ns/sample, decode %.0f ns/sample (%lu/%lu ok)\n",
+         (t1 - t0) * 1e9 / count, (t2 - t1) * 1e9 / count, ok, count);
+  free(bench_buf);
+  return ok == count ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1 && strcmp(argv[1], "-b") == 0) {
+    unsigned long baud = (argc > 2) ? strtoul(argv[2], NULL, 10) : 115200;
+    unsigned long count = (argc > 3) ? strtoul(argv[3], NULL, 10) : 1000000;
+    return bench(baud, count);
+  }
+
+  FILE *in = stdin;
+  if (argc > 1) {
+    in = fopen(argv[1], "rb");
+    if (!in) {
+      perror(argv[1]);
+      return 1;
+    }
+  }
+  return decode(in);
+}